@@ -0,0 +1,217 @@
+/*
+* Mathi C Library - bench.h
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*
+* Shared helpers for the benchmarks in bench/: a monotonic clock, a seeded
+* generator for the standard input distributions, median-of-repetitions and
+* table / JSON reporting of the collected results.
+*/
+
+#ifndef MATHI_BENCH_H
+#define MATHI_BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/* Random and Zipf values stay below this bound, so interpolation search
+ * arithmetic cannot overflow; every distribution is non-negative. */
+#define BENCH_VALUE_MAX (1 << 30)
+
+/* Distinct values used by the few-unique distribution. */
+#define BENCH_FEW_UNIQUE 16
+
+/* Zipf exponent and number of distinct ranks (capped for the CDF table). */
+#define BENCH_ZIPF_S 1.1
+#define BENCH_ZIPF_MAX_RANKS (1 << 20)
+
+/* Number of teeth in the sawtooth distribution. */
+#define BENCH_SAWTOOTH_TEETH 16
+
+typedef enum {
+    BENCH_RANDOM,
+    BENCH_SORTED,
+    BENCH_REVERSED,
+    BENCH_FEW_UNIQUE_DIST,
+    BENCH_ZIPF,
+    BENCH_SAWTOOTH,
+    BENCH_NUM_DISTS
+} BenchDist;
+
+static const char *const bench_dist_names[BENCH_NUM_DISTS] = {
+    "random", "sorted", "reversed", "few-unique", "zipf", "sawtooth"
+};
+
+/* One measurement: median time per element (or per query) over the repetitions. */
+typedef struct {
+    char group[16];
+    char algo[24];
+    char dist[16];
+    long n;
+    double ns_per_elem;
+    double melem_per_sec;
+} BenchResult;
+
+typedef struct {
+    BenchResult *items;
+    int count;
+    int cap;
+} BenchResults;
+
+static inline double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* splitmix64: tiny, seedable and good enough for benchmark inputs. */
+static inline uint64_t bench_rand(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline double bench_rand_unit(uint64_t *state)
+{
+    return (bench_rand(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Scatter a rank over the value range so Zipf output is not accidentally sorted. */
+static inline int bench_scramble(uint64_t rank)
+{
+    return (int)((rank * 2654435761ull) % BENCH_VALUE_MAX);
+}
+
+/**
+ * @brief Fill arr with n values from the given distribution.
+ * @return 0 on success, -1 on allocation failure.
+ */
+static inline int bench_fill(BenchDist dist, int *arr, long n, uint64_t seed)
+{
+    uint64_t s = seed ^ ((uint64_t)dist << 56) ^ (uint64_t)n;
+    switch(dist)
+    {
+        case BENCH_RANDOM:
+            for(long i = 0; i < n; i++) arr[i] = (int)(bench_rand(&s) % BENCH_VALUE_MAX);
+            break;
+        case BENCH_SORTED:
+            for(long i = 0; i < n; i++) arr[i] = (int)i;
+            break;
+        case BENCH_REVERSED:
+            for(long i = 0; i < n; i++) arr[i] = (int)(n - i);
+            break;
+        case BENCH_FEW_UNIQUE_DIST:
+            for(long i = 0; i < n; i++) arr[i] = (int)(bench_rand(&s) % BENCH_FEW_UNIQUE);
+            break;
+        case BENCH_ZIPF:
+        {
+            long ranks = n < BENCH_ZIPF_MAX_RANKS ? (n > 1 ? n : 2) : BENCH_ZIPF_MAX_RANKS;
+            double *cdf = malloc(ranks * sizeof(double));
+            if(!cdf) return -1;
+            double sum = 0;
+            for(long r = 0; r < ranks; r++) cdf[r] = sum += 1.0 / pow(r + 1, BENCH_ZIPF_S);
+            for(long i = 0; i < n; i++)
+            {
+                double u = bench_rand_unit(&s) * sum;
+                long lo = 0, hi = ranks - 1;
+                while(lo < hi)
+                {
+                    long mid = lo + (hi - lo) / 2;
+                    if(cdf[mid] < u) lo = mid + 1;
+                    else hi = mid;
+                }
+                arr[i] = bench_scramble(lo + 1);
+            }
+            free(cdf);
+            break;
+        }
+        case BENCH_SAWTOOTH:
+        {
+            long tooth = n / BENCH_SAWTOOTH_TEETH + 1;
+            for(long i = 0; i < n; i++) arr[i] = (int)(i % tooth);
+            break;
+        }
+        default:
+            return -1;
+    }
+    return 0;
+}
+
+static inline int bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Median of v[0..n); reorders v. */
+static inline double bench_median(double *v, int n)
+{
+    qsort(v, n, sizeof(double), bench_cmp_double);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static inline void bench_record(BenchResults *r, const char *group, const char *algo,
+                                const char *dist, long n, double ns_per_elem)
+{
+    if(r->count == r->cap)
+    {
+        int cap = r->cap ? 2 * r->cap : 64;
+        BenchResult *items = realloc(r->items, cap * sizeof(BenchResult));
+        if(!items) return;
+        r->items = items;
+        r->cap = cap;
+    }
+    BenchResult *e = &r->items[r->count++];
+    snprintf(e->group, sizeof(e->group), "%s", group);
+    snprintf(e->algo, sizeof(e->algo), "%s", algo);
+    snprintf(e->dist, sizeof(e->dist), "%s", dist);
+    e->n = n;
+    e->ns_per_elem = ns_per_elem;
+    e->melem_per_sec = ns_per_elem > 0 ? 1e3 / ns_per_elem : 0;
+}
+
+static inline void bench_print_header(const char *unit)
+{
+    printf("%-8s %-14s %-12s %10s %14s %14s\n", "group", "algo", "dist", "n", unit, "M/s");
+}
+
+static inline void bench_print_result(const BenchResult *e)
+{
+    printf("%-8s %-14s %-12s %10ld %14.2f %14.2f\n", e->group, e->algo, e->dist, e->n,
+           e->ns_per_elem, e->melem_per_sec);
+    fflush(stdout);
+}
+
+/**
+ * @brief Write all results as a JSON document suitable for diffing across releases.
+ * @return 0 on success, -1 if the file cannot be written.
+ */
+static inline int bench_write_json(const BenchResults *r, const char *path, uint64_t seed, int reps)
+{
+    FILE *f = fopen(path, "w");
+    if(!f) return -1;
+    fprintf(f, "{\n  \"seed\": %llu,\n  \"repetitions\": %d,\n", (unsigned long long)seed, reps);
+#ifdef __VERSION__
+    fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    fprintf(f, "  \"results\": [\n");
+    for(int i = 0; i < r->count; i++)
+    {
+        const BenchResult *e = &r->items[i];
+        fprintf(f, "    {\"group\": \"%s\", \"algo\": \"%s\", \"dist\": \"%s\", \"n\": %ld, "
+                   "\"ns_per_elem\": %.4f, \"melem_per_sec\": %.4f}%s\n",
+                e->group, e->algo, e->dist, e->n, e->ns_per_elem, e->melem_per_sec,
+                i + 1 < r->count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+#endif // MATHI_BENCH_H
@@ -0,0 +1,267 @@
+/*
+* Mathi C Library - concmap_bench.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*
+* Multi-threaded throughput of the concurrent MathiCMap against MathiHashMap
+* behind a global mutex and behind a reader-writer lock. Every thread runs
+* --ops operations on a map preloaded with --keys keys: lookups, and writes
+* split evenly between inserts and removes over twice as many keys, so the
+* map stays near its starting size and about half the lookups hit. Mixes
+* are 95% and 50% lookups; thread counts double from 1 up to --threads.
+*
+* Usage: concmap_bench [--keys N] [--ops N] [--threads T] [--reps R] [--seed S] [--json FILE]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "bench.h"
+#include "mathi/ds.h"
+#include "mathi/ds_concurrent.h"
+
+/* Longest generated key, including the terminator. */
+#define KEY_MAX 16
+
+static const int read_pcts[] = {95, 50};
+
+enum { IMPL_CMAP, IMPL_RWLOCK, IMPL_MUTEX, NUM_IMPLS };
+static const char *const impl_names[NUM_IMPLS] = {"cmap", "rwlock", "mutex"};
+
+typedef struct {
+    int impl;
+    MathiCMap *cmap;
+    MathiHashMap *hmap;
+    pthread_mutex_t mutex;
+    pthread_rwlock_t rwlock;
+} Target;
+
+typedef struct {
+    Target *target;
+    pthread_barrier_t *start;
+    const char *keys;
+    long key_count;
+    long ops;
+    int read_pct;
+    uint64_t seed;
+    long hits;
+} Worker;
+
+static int target_get(Target *t, const char *key)
+{
+    int found;
+    switch(t->impl)
+    {
+        case IMPL_CMAP:
+            return mathi_cmap_get(t->cmap, key, NULL);
+        case IMPL_RWLOCK:
+            pthread_rwlock_rdlock(&t->rwlock);
+            found = mathi_hashmap_get(t->hmap, key, NULL);
+            pthread_rwlock_unlock(&t->rwlock);
+            return found;
+        default:
+            pthread_mutex_lock(&t->mutex);
+            found = mathi_hashmap_get(t->hmap, key, NULL);
+            pthread_mutex_unlock(&t->mutex);
+            return found;
+    }
+}
+
+static void target_write(Target *t, const char *key, int insert, void *value)
+{
+    switch(t->impl)
+    {
+        case IMPL_CMAP:
+            if(insert) mathi_cmap_set(t->cmap, key, value);
+            else mathi_cmap_remove(t->cmap, key, NULL);
+            return;
+        case IMPL_RWLOCK:
+            pthread_rwlock_wrlock(&t->rwlock);
+            if(insert) mathi_hashmap_set(t->hmap, key, value);
+            else mathi_hashmap_remove(t->hmap, key, NULL);
+            pthread_rwlock_unlock(&t->rwlock);
+            return;
+        default:
+            pthread_mutex_lock(&t->mutex);
+            if(insert) mathi_hashmap_set(t->hmap, key, value);
+            else mathi_hashmap_remove(t->hmap, key, NULL);
+            pthread_mutex_unlock(&t->mutex);
+            return;
+    }
+}
+
+static void* worker_main(void *arg)
+{
+    Worker *w = arg;
+    uint64_t s = w->seed;
+    long hits = 0;
+    pthread_barrier_wait(w->start);
+    for(long i = 0; i < w->ops; i++)
+    {
+        uint64_t r = bench_rand(&s);
+        const char *key = w->keys + (long)(r % (uint64_t)w->key_count) * KEY_MAX;
+        if((int)((r >> 40) % 100) < w->read_pct) hits += target_get(w->target, key);
+        else target_write(w->target, key, (r >> 63) != 0, (void *)(intptr_t)(i + 1));
+    }
+    w->hits = hits;
+    return NULL;
+}
+
+/* A map of the given kind holding the first n keys; 0 on success, -1 on failure. */
+static int target_init(Target *t, int impl, const char *keys, long n)
+{
+    memset(t, 0, sizeof(*t));
+    t->impl = impl;
+    if(impl == IMPL_CMAP) t->cmap = mathi_cmap_new((size_t)n, 0);
+    else t->hmap = mathi_hashmap_new((size_t)n, 0);
+    if(!t->cmap && !t->hmap) return -1;
+    pthread_mutex_init(&t->mutex, NULL);
+    pthread_rwlock_init(&t->rwlock, NULL);
+    for(long i = 0; i < n; i++)
+    {
+        const char *k = keys + i * KEY_MAX;
+        void *v = (void *)(intptr_t)(i + 1);
+        if((t->cmap ? mathi_cmap_set(t->cmap, k, v) : mathi_hashmap_set(t->hmap, k, v)) != 0) return -1;
+    }
+    return 0;
+}
+
+static void target_free(Target *t)
+{
+    mathi_cmap_free(t->cmap);
+    mathi_hashmap_free(t->hmap);
+    pthread_mutex_destroy(&t->mutex);
+    pthread_rwlock_destroy(&t->rwlock);
+}
+
+/* Wall-clock ns per operation (all threads together) for one run, or -1 on failure. */
+static double run_once(Target *t, const char *keys, long key_count, long ops, int threads,
+                       int read_pct, uint64_t seed)
+{
+    pthread_t tids[threads];
+    Worker workers[threads];
+    pthread_barrier_t start;
+    if(pthread_barrier_init(&start, NULL, (unsigned)threads + 1) != 0) return -1;
+
+    int started = 0;
+    for(; started < threads; started++)
+    {
+        workers[started] = (Worker){t, &start, keys, key_count, ops, read_pct,
+                                    seed ^ (0x9E3779B97F4A7C15ull * (uint64_t)(started + 1)), 0};
+        if(pthread_create(&tids[started], NULL, worker_main, &workers[started]) != 0) break;
+    }
+    if(started < threads)
+    {
+        fprintf(stderr, "could not start %d threads\n", threads);
+        exit(1);
+    }
+
+    pthread_barrier_wait(&start);
+    double t0 = bench_now_ns();
+    for(int i = 0; i < threads; i++) pthread_join(tids[i], NULL);
+    double elapsed = bench_now_ns() - t0;
+    pthread_barrier_destroy(&start);
+    return elapsed / ((double)ops * threads);
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--keys N] [--ops N] [--threads T] [--reps R] [--seed S] [--json FILE]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    long keys_n = 1L << 18;
+    long ops = 1L << 20;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = cpus > 0 ? (int)cpus : 1;
+    int reps = 3;
+    uint64_t seed = 42;
+    const char *json = "concmap_results.json";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 < argc && strcmp(argv[i], "--keys") == 0) keys_n = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--ops") == 0) ops = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--threads") == 0) max_threads = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--reps") == 0) reps = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else if(i + 1 < argc && strcmp(argv[i], "--json") == 0) json = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if(keys_n < 1 || keys_n > (1L << 26) || ops < 1 || max_threads < 1 || max_threads > 1024 || reps < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Lookups and writes draw from 2 * keys_n keys, of which the first keys_n are preloaded.
+    long key_count = 2 * keys_n;
+    char *keys = malloc((size_t)key_count * KEY_MAX);
+    double *samples = malloc((size_t)reps * sizeof(double));
+    BenchResults results = {0};
+    if(!keys || !samples) return 1;
+    for(long i = 0; i < key_count; i++)
+        snprintf(keys + i * KEY_MAX, KEY_MAX, "k%08lx",
+                 (unsigned long)(uint32_t)((uint64_t)i * 2654435761u + (uint32_t)seed));
+
+    // Powers of two below max_threads, then max_threads itself.
+    int thread_counts[16], counts = 0;
+    for(int t = 1; t < max_threads; t *= 2) thread_counts[counts++] = t;
+    thread_counts[counts++] = max_threads;
+
+    printf("Concurrent map benchmark: %ld keys, %ld ops/thread, up to %d threads, seed %llu, "
+           "%d repetitions (median)\n", keys_n, ops, max_threads, (unsigned long long)seed, reps);
+    bench_print_header("ns/op");
+
+    for(size_t p = 0; p < sizeof(read_pcts) / sizeof(read_pcts[0]); p++)
+    {
+        char group[16];
+        snprintf(group, sizeof(group), "r%dw%d", read_pcts[p], 100 - read_pcts[p]);
+
+        for(int c = 0; c < counts; c++)
+        {
+            int threads = thread_counts[c];
+            char dist[16];
+            snprintf(dist, sizeof(dist), "%d threads", threads);
+
+            for(int impl = 0; impl < NUM_IMPLS; impl++)
+            {
+                Target target;
+                if(target_init(&target, impl, keys, keys_n) != 0)
+                {
+                    fprintf(stderr, "%s: allocation failed\n", impl_names[impl]);
+                    return 1;
+                }
+                for(int r = -1; r < reps; r++)
+                {
+                    double ns = run_once(&target, keys, key_count, ops, threads, read_pcts[p],
+                                         seed + (uint64_t)r + 1);
+                    if(r >= 0) samples[r] = ns;
+                }
+                target_free(&target);
+
+                bench_record(&results, group, impl_names[impl], dist, keys_n, bench_median(samples, reps));
+                bench_print_result(&results.items[results.count - 1]);
+            }
+        }
+    }
+
+    if(bench_write_json(&results, json, seed, reps) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", json);
+        return 1;
+    }
+    printf("\nJSON results written to %s\n", json);
+
+    free(results.items);
+    free(samples);
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+* Mathi C Library - distinct_bench.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*
+* Compares the hash, sort+unique and bitmap modes of mathi_arr_distinct_mode
+* on the seeded distributions in bench.h plus dense ID lists (values in
+* [0, n)), at sizes --min-n .. --max-n (powers of ten). The bitmap mode
+* falls back to the hash set on sparse inputs such as "random".
+*
+* Usage: distinct_bench [--min-n N] [--max-n N] [--reps R] [--seed S] [--json FILE]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "mathi/array.h"
+
+/* Small sizes deduplicate several copies per timed repetition, so each one covers at least this many elements. */
+#define MIN_BATCH_ELEMS (1 << 16)
+
+/* Input name for the dense ID distribution, which is not part of bench.h. */
+#define DENSE_NAME "dense-ids"
+
+static const struct { const char *name; MathiDistinctMode mode; } modes[] = {
+    {"hash", MATHI_DISTINCT_HASH},
+    {"sorted", MATHI_DISTINCT_SORTED},
+    {"bitmap", MATHI_DISTINCT_BITMAP},
+};
+
+/* Median ns/element of one mode over reps timed repetitions after one warmup; -1 on failure. */
+static double bench_distinct(MathiDistinctMode mode, const int *input, int *work, long n, int reps,
+                             size_t *kept)
+{
+    long batch = n < MIN_BATCH_ELEMS ? MIN_BATCH_ELEMS / n : 1;
+    double *times = malloc(reps * sizeof(double));
+    if(!times) return -1;
+
+    for(int r = -1; r < reps; r++)
+    {
+        for(long b = 0; b < batch; b++) memcpy(work + b * n, input, n * sizeof(int));
+        double t0 = bench_now_ns();
+        for(long b = 0; b < batch; b++)
+        {
+            size_t len = (size_t)n;
+            if(mathi_arr_distinct_mode(work + b * n, &len, mode) != 0)
+            {
+                free(times);
+                return -1;
+            }
+            *kept = len;
+        }
+        double t = bench_now_ns() - t0;
+        if(r >= 0) times[r] = t / (batch * n);
+    }
+    double med = bench_median(times, reps);
+    free(times);
+    return med;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--min-n N] [--max-n N] [--reps R] [--seed S] [--json FILE]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    long min_n = 1000, max_n = 1000000;
+    int reps = 5;
+    uint64_t seed = 42;
+    const char *json = "distinct_results.json";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 < argc && strcmp(argv[i], "--min-n") == 0) min_n = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--max-n") == 0) max_n = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--reps") == 0) reps = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else if(i + 1 < argc && strcmp(argv[i], "--json") == 0) json = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if(min_n < 1 || max_n < min_n || max_n > 1000000000L || reps < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    long work_len = max_n > MIN_BATCH_ELEMS ? max_n : 2 * MIN_BATCH_ELEMS;
+    int *input = malloc(max_n * sizeof(int));
+    int *work = malloc(work_len * sizeof(int));
+    BenchResults results = {0};
+    if(!input || !work) return 1;
+
+    printf("Distinct benchmark: seed %llu, %d repetitions (median)\n", (unsigned long long)seed, reps);
+    bench_print_header("ns/elem");
+
+    int nmodes = sizeof(modes) / sizeof(modes[0]);
+
+    for(long n = min_n; n <= max_n; n *= 10)
+    {
+        for(int d = 0; d <= BENCH_NUM_DISTS; d++)
+        {
+            const char *dist = d < BENCH_NUM_DISTS ? bench_dist_names[d] : DENSE_NAME;
+            if(d < BENCH_NUM_DISTS)
+            {
+                if(bench_fill((BenchDist)d, input, n, seed) != 0) return 1;
+            }
+            else
+            {
+                uint64_t s = seed ^ (uint64_t)n;
+                for(long i = 0; i < n; i++) input[i] = (int)(bench_rand(&s) % n);
+            }
+
+            size_t expect = 0;
+            for(int m = 0; m < nmodes; m++)
+            {
+                size_t kept = 0;
+                double ns = bench_distinct(modes[m].mode, input, work, n, reps, &kept);
+                if(ns < 0 || (m > 0 && kept != expect))
+                {
+                    fprintf(stderr, "%s distinct failed on %s, n = %ld\n", modes[m].name, dist, n);
+                    return 1;
+                }
+                expect = kept;
+                bench_record(&results, "distinct", modes[m].name, dist, n, ns);
+                bench_print_result(&results.items[results.count - 1]);
+            }
+        }
+        if(n > max_n / 10) break;
+    }
+
+    if(bench_write_json(&results, json, seed, reps) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", json);
+        return 1;
+    }
+    printf("\nJSON results written to %s\n", json);
+
+    free(results.items);
+    free(input);
+    free(work);
+    return 0;
+}
@@ -0,0 +1,206 @@
+/*
+* Mathi C Library - hashmap_bench.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*
+* Compares the Robin Hood MathiHashMap (which backs Hash) with the
+* Swiss-table MathiSwissMap on string keys: insert, successful lookup,
+* unsuccessful lookup and erase, at load factors 0.5 - 0.875 of a table of
+* --slots slots. Short keys (9 bytes) fit inline in a Swiss slot; long keys
+* (34 bytes) do not.
+*
+* Usage: hashmap_bench [--slots N] [--reps R] [--seed S] [--json FILE]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "mathi/ds.h"
+#include "mathi/ds_advanced.h"
+
+/* Longest generated key, including the terminator. */
+#define KEY_MAX 40
+
+static const double loads[] = {0.5, 0.625, 0.75, 0.875};
+
+enum { OP_INSERT, OP_HIT, OP_MISS, OP_ERASE, NUM_OPS };
+static const char *const op_names[NUM_OPS] = {"insert", "hit", "miss", "erase"};
+
+enum { MAP_ROBINHOOD, MAP_SWISS, NUM_MAPS };
+static const char *const map_names[NUM_MAPS] = {"robinhood", "swiss"};
+
+/*
+ * n distinct keys of the given kind (short keys scramble the index with an
+ * odd multiplier, which is a bijection mod 2^32); miss keys use another prefix.
+ */
+static void make_keys(char *keys, long n, int long_keys, int miss, uint64_t seed)
+{
+    uint64_t s = seed;
+    for(long i = 0; i < n; i++)
+    {
+        if(long_keys)
+            snprintf(keys + i * KEY_MAX, KEY_MAX, "%s:%016llx:%08lx", miss ? "miss" : "sess",
+                     (unsigned long long)bench_rand(&s), (unsigned long)i);
+        else
+            snprintf(keys + i * KEY_MAX, KEY_MAX, "%c%08lx", miss ? 'm' : 'u',
+                     (unsigned long)(uint32_t)((uint64_t)i * 2654435761u + (uint32_t)seed));
+    }
+}
+
+/*
+ * One repetition of every operation on one map type; times[op] receives ns per key.
+ * @return 0 on success, -1 on allocation failure or a wrong lookup result.
+ */
+static int run_once(int map, const char *keys, const char *miss, const long *order, long n,
+                    double load, double times[NUM_OPS])
+{
+    MathiHashMap *rh = NULL;
+    MathiSwissMap *sw = NULL;
+    if(map == MAP_ROBINHOOD) rh = mathi_hashmap_new((size_t)n, load);
+    else sw = mathi_swissmap_new((size_t)n, load);
+    if(!rh && !sw) return -1;
+
+    long found = 0;
+    double t0 = bench_now_ns();
+    for(long i = 0; i < n; i++)
+    {
+        const char *k = keys + i * KEY_MAX;
+        void *v = (void *)(intptr_t)(i + 1);
+        if((rh ? mathi_hashmap_set(rh, k, v) : mathi_swissmap_set(sw, k, v)) != 0) found = -n;
+    }
+    times[OP_INSERT] = (bench_now_ns() - t0) / n;
+
+    t0 = bench_now_ns();
+    for(long i = 0; i < n; i++)
+    {
+        const char *k = keys + order[i] * KEY_MAX;
+        found += rh ? mathi_hashmap_get(rh, k, NULL) : mathi_swissmap_get(sw, k, NULL);
+    }
+    times[OP_HIT] = (bench_now_ns() - t0) / n;
+
+    t0 = bench_now_ns();
+    for(long i = 0; i < n; i++)
+    {
+        const char *k = miss + i * KEY_MAX;
+        found -= rh ? mathi_hashmap_get(rh, k, NULL) : mathi_swissmap_get(sw, k, NULL);
+    }
+    times[OP_MISS] = (bench_now_ns() - t0) / n;
+
+    t0 = bench_now_ns();
+    for(long i = 0; i < n; i++)
+    {
+        const char *k = keys + order[i] * KEY_MAX;
+        found -= rh ? mathi_hashmap_remove(rh, k, NULL) : mathi_swissmap_remove(sw, k, NULL);
+    }
+    times[OP_ERASE] = (bench_now_ns() - t0) / n;
+
+    mathi_hashmap_free(rh);
+    mathi_swissmap_free(sw);
+    return found == 0 ? 0 : -1;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--slots N] [--reps R] [--seed S] [--json FILE]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    long slots = 1L << 20;
+    int reps = 5;
+    uint64_t seed = 42;
+    const char *json = "hashmap_results.json";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 < argc && strcmp(argv[i], "--slots") == 0) slots = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--reps") == 0) reps = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else if(i + 1 < argc && strcmp(argv[i], "--json") == 0) json = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    // Both maps size their tables in powers of two, so --slots must be one for the loads to be exact.
+    if(slots < 64 || (slots & (slots - 1)) || slots > (1L << 26) || reps < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    long max_n = (long)(slots * loads[sizeof(loads) / sizeof(loads[0]) - 1]);
+    char *keys = malloc((size_t)max_n * KEY_MAX);
+    char *miss = malloc((size_t)max_n * KEY_MAX);
+    long *order = malloc(max_n * sizeof(long));
+    double *samples = malloc((size_t)NUM_MAPS * NUM_OPS * reps * sizeof(double));
+    BenchResults results = {0};
+    if(!keys || !miss || !order || !samples) return 1;
+
+    printf("Hash map benchmark: %ld slots, seed %llu, %d repetitions (median)\n", slots,
+           (unsigned long long)seed, reps);
+    bench_print_header("ns/key");
+
+    for(int long_keys = 0; long_keys < 2; long_keys++)
+    {
+        make_keys(keys, max_n, long_keys, 0, seed);
+        make_keys(miss, max_n, long_keys, 1, seed + 1);
+
+        for(size_t l = 0; l < sizeof(loads) / sizeof(loads[0]); l++)
+        {
+            long n = (long)(slots * loads[l]);
+            // Look keys up in a shuffled order so hits do not follow insertion order.
+            uint64_t s = seed ^ (uint64_t)n;
+            for(long i = 0; i < n; i++) order[i] = i;
+            for(long i = n - 1; i > 0; i--)
+            {
+                long j = (long)(bench_rand(&s) % (uint64_t)(i + 1));
+                long tmp = order[i];
+                order[i] = order[j];
+                order[j] = tmp;
+            }
+
+            char dist[16];
+            snprintf(dist, sizeof(dist), "%s@%.3g", long_keys ? "long" : "short", loads[l]);
+
+            for(int m = 0; m < NUM_MAPS; m++)
+            {
+                for(int r = -1; r < reps; r++)
+                {
+                    double t[NUM_OPS];
+                    if(run_once(m, keys, miss, order, n, loads[l], t) != 0)
+                    {
+                        fprintf(stderr, "%s failed on %s\n", map_names[m], dist);
+                        return 1;
+                    }
+                    if(r < 0) continue;
+                    for(int op = 0; op < NUM_OPS; op++)
+                        samples[(m * NUM_OPS + op) * reps + r] = t[op];
+                }
+            }
+            for(int op = 0; op < NUM_OPS; op++)
+                for(int m = 0; m < NUM_MAPS; m++)
+                {
+                    double ns = bench_median(samples + (m * NUM_OPS + op) * reps, reps);
+                    bench_record(&results, op_names[op], map_names[m], dist, n, ns);
+                    bench_print_result(&results.items[results.count - 1]);
+                }
+        }
+    }
+
+    if(bench_write_json(&results, json, seed, reps) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", json);
+        return 1;
+    }
+    printf("\nJSON results written to %s\n", json);
+
+    free(results.items);
+    free(samples);
+    free(order);
+    free(miss);
+    free(keys);
+    return 0;
+}
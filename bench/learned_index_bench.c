@@ -0,0 +1,183 @@
+/*
+* Mathi C Library - learned_index_bench.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*
+* Compares the learned (piecewise-linear) index against binary,
+* interpolation and lower-bound search and the Eytzinger index on uniform,
+* lognormal and clustered keys, and reports the model size per eps.
+*
+* Usage: learned_index_bench [--n N] [--reps R] [--seed S] [--json FILE]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "mathi/sort.h"
+#include "mathi/search.h"
+
+/* Queries per measurement; half are present keys, half random values in range. */
+#define QUERIES (1 << 18)
+
+/* Interpolation search can degrade to linear time on skewed keys, so it gets fewer queries. */
+#define INTERPOLATION_QUERIES (1 << 10)
+
+/* Error bound used for the timed learned index rows. */
+#define BENCH_EPS 32
+
+/* Number of clusters and their spread (fraction of the key range) for the clustered keys. */
+#define CLUSTERS 64
+#define CLUSTER_SPREAD 0.0005
+
+enum { KEYS_UNIFORM, KEYS_LOGNORMAL, KEYS_CLUSTERED, NUM_KEY_DISTS };
+static const char *const key_dist_names[NUM_KEY_DISTS] = {"uniform", "lognormal", "clustered"};
+
+enum { ALGO_BINARY, ALGO_INTERPOLATION, ALGO_LOWER_BOUND, ALGO_EYTZINGER, ALGO_LEARNED, NUM_ALGOS };
+static const char *const algo_names[NUM_ALGOS] = {"binary", "interpolation", "lower_bound", "eytzinger", "learned"};
+
+static double normal(uint64_t *s)
+{
+    double u = bench_rand_unit(s), v = bench_rand_unit(s);
+    return sqrt(-2.0 * log(u + 1e-300)) * cos(2 * M_PI * v);
+}
+
+/* Keys in [0, BENCH_VALUE_MAX), sorted. */
+static void fill_keys(int dist, int *keys, long n, uint64_t seed)
+{
+    uint64_t s = seed ^ (uint64_t)dist * 0x9E3779B97F4A7C15ull;
+    double centers[CLUSTERS];
+    for(int c = 0; c < CLUSTERS; c++) centers[c] = bench_rand_unit(&s);
+
+    for(long i = 0; i < n; i++)
+    {
+        double x;
+        if(dist == KEYS_UNIFORM) x = bench_rand_unit(&s);
+        else if(dist == KEYS_LOGNORMAL) x = exp(2.0 * normal(&s)) / 2000.0;
+        else x = centers[bench_rand(&s) % CLUSTERS] + CLUSTER_SPREAD * normal(&s);
+        if(x < 0) x = 0;
+        if(x >= 1) x = 0.999999999;
+        keys[i] = (int)(x * BENCH_VALUE_MAX);
+    }
+    mathi_radix_sort(keys, (int)n);
+}
+
+static double time_algo(int algo, int *keys, long n, const int *queries, const MathiSearchIndex *eytz,
+                        const MathiLearnedIndex *learned, int reps)
+{
+    double *times = malloc(reps * sizeof(double));
+    if(!times) return -1;
+    volatile long sink = 0;
+
+    long m = algo == ALGO_INTERPOLATION ? INTERPOLATION_QUERIES : QUERIES;
+    for(int r = -1; r < reps; r++)
+    {
+        long acc = 0;
+        double t0 = bench_now_ns();
+        switch(algo)
+        {
+            case ALGO_BINARY:
+                for(long q = 0; q < QUERIES; q++) acc += mathi_binary_search(keys, (int)n, queries[q]);
+                break;
+            case ALGO_INTERPOLATION:
+            {
+                // A fresh slice of queries each repetition, so its few lines are not already cached
+                const int *slice = queries + ((r + 1) * m) % QUERIES;
+                for(long q = 0; q < m; q++) acc += mathi_interpolation_search(keys, (int)n, slice[q]);
+                break;
+            }
+            case ALGO_LOWER_BOUND:
+                for(long q = 0; q < QUERIES; q++) acc += mathi_lower_bound_i32(keys, n, queries[q]);
+                break;
+            case ALGO_EYTZINGER:
+                for(long q = 0; q < QUERIES; q++) acc += mathi_search_index_find(eytz, queries[q]);
+                break;
+            default:
+                for(long q = 0; q < QUERIES; q++) acc += mathi_learned_index_find_i32(learned, keys, queries[q]);
+                break;
+        }
+        double t = bench_now_ns() - t0;
+        sink += acc;
+        if(r >= 0) times[r] = t / m;
+    }
+    (void)sink;
+    double med = bench_median(times, reps);
+    free(times);
+    return med;
+}
+
+int main(int argc, char **argv)
+{
+    long n = 10000000;
+    int reps = 5;
+    uint64_t seed = 42;
+    const char *json = "learned_index_results.json";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 < argc && strcmp(argv[i], "--n") == 0) n = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--reps") == 0) reps = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else if(i + 1 < argc && strcmp(argv[i], "--json") == 0) json = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--n N] [--reps R] [--seed S] [--json FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(n < 1 || n > 1000000000L || reps < 1) return 1;
+
+    int *keys = malloc(n * sizeof(int));
+    int *queries = malloc(QUERIES * sizeof(int));
+    BenchResults results = {0};
+    if(!keys || !queries) return 1;
+
+    printf("Learned index benchmark: n = %ld, eps = %d, %d queries, %d repetitions (median)\n",
+           n, BENCH_EPS, QUERIES, reps);
+
+    printf("\n%-12s %8s %12s %12s\n", "keys", "eps", "segments", "model KB");
+    for(int d = 0; d < NUM_KEY_DISTS; d++)
+    {
+        fill_keys(d, keys, n, seed);
+        for(size_t eps = 8; eps <= 512; eps *= 4)
+        {
+            MathiLearnedIndex *li = mathi_learned_index_build_i32(keys, n, eps);
+            if(!li) return 1;
+            printf("%-12s %8zu %12zu %12.1f\n", key_dist_names[d], eps, li->nseg,
+                   li->nseg * (sizeof(int64_t) + 2 * sizeof(double)) / 1024.0);
+            mathi_learned_index_free(li);
+        }
+    }
+
+    printf("\n");
+    bench_print_header("ns/query");
+    for(int d = 0; d < NUM_KEY_DISTS; d++)
+    {
+        fill_keys(d, keys, n, seed);
+        uint64_t qs = seed ^ (uint64_t)d;
+        for(long q = 0; q < QUERIES; q++)
+            queries[q] = (q & 1) ? keys[bench_rand(&qs) % n] : keys[0] + (int)(bench_rand(&qs) % ((uint64_t)keys[n - 1] - keys[0] + 1));
+
+        MathiSearchIndex *eytz = mathi_search_index_build(keys, n);
+        MathiLearnedIndex *learned = mathi_learned_index_build_i32(keys, n, BENCH_EPS);
+        if(!eytz || !learned) return 1;
+
+        for(int a = 0; a < NUM_ALGOS; a++)
+        {
+            double ns = time_algo(a, keys, n, queries, eytz, learned, reps);
+            if(ns < 0) return 1;
+            bench_record(&results, "search", algo_names[a], key_dist_names[d], n, ns);
+            bench_print_result(&results.items[results.count - 1]);
+        }
+        mathi_search_index_free(eytz);
+        mathi_learned_index_free(learned);
+    }
+
+    if(bench_write_json(&results, json, seed, reps) != 0) return 1;
+    printf("\nJSON results written to %s\n", json);
+
+    free(results.items);
+    free(keys);
+    free(queries);
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+* Mathi C Library - search_index_bench.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*
+* Compares the Eytzinger search index and batched binary search against
+* binary, jump and interpolation search on sorted random keys, from 1e3 keys up to
+* --max-n (default 1e7; 1e9 needs about 12 GB of memory).
+*
+* Usage: search_index_bench [--max-n N] [--reps R] [--seed S] [--json FILE]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "mathi/sort.h"
+#include "mathi/search.h"
+
+/* Queries per measurement; half are present keys, half random values. */
+#define QUERIES (1 << 18)
+
+/* Jump search is O(sqrt n) per query; it is skipped above this size. */
+#define JUMP_MAX_N 100000000L
+
+typedef int (*search_fn)(int *arr, int n, int key);
+
+/* How time_queries issues the lookups. */
+enum { QUERY_FN, QUERY_INDEX, QUERY_BATCH };
+
+static double time_queries(int mode, search_fn fn, const MathiSearchIndex *idx, int *sorted, long n,
+                           const int *queries, ptrdiff_t *out, int reps)
+{
+    double *times = malloc(reps * sizeof(double));
+    if(!times) return -1;
+    volatile long sink = 0;
+
+    for(int r = -1; r < reps; r++)
+    {
+        long acc = 0;
+        double t0 = bench_now_ns();
+        if(mode == QUERY_INDEX)
+            for(long q = 0; q < QUERIES; q++) acc += mathi_search_index_find(idx, queries[q]);
+        else if(mode == QUERY_BATCH)
+        {
+            mathi_binary_search_batch(sorted, (size_t)n, queries, QUERIES, out);
+            acc += out[QUERIES - 1];
+        }
+        else
+            for(long q = 0; q < QUERIES; q++) acc += fn(sorted, (int)n, queries[q]);
+        double t = bench_now_ns() - t0;
+        sink += acc;
+        if(r >= 0) times[r] = t / QUERIES;
+    }
+    (void)sink;
+    double med = bench_median(times, reps);
+    free(times);
+    return med;
+}
+
+int main(int argc, char **argv)
+{
+    long max_n = 10000000;
+    int reps = 5;
+    uint64_t seed = 42;
+    const char *json = "search_index_results.json";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 < argc && strcmp(argv[i], "--max-n") == 0) max_n = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--reps") == 0) reps = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else if(i + 1 < argc && strcmp(argv[i], "--json") == 0) json = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: %s [--max-n N] [--reps R] [--seed S] [--json FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if(max_n < 1000 || max_n > 2000000000L || reps < 1) return 1;
+
+    int *sorted = malloc(max_n * sizeof(int));
+    int *queries = malloc(QUERIES * sizeof(int));
+    ptrdiff_t *out = malloc(QUERIES * sizeof(ptrdiff_t));
+    BenchResults results = {0};
+    if(!sorted || !queries || !out) return 1;
+
+    struct { const char *name; int mode; search_fn fn; } algos[] = {
+        {"binary", QUERY_FN, mathi_binary_search},
+        {"jump", QUERY_FN, mathi_jump_search},
+        {"interpolation", QUERY_FN, mathi_interpolation_search},
+        {"eytzinger", QUERY_INDEX, NULL},
+        {"batch", QUERY_BATCH, NULL},
+    };
+
+    printf("Search index benchmark: random keys, %d queries, %d repetitions (median)\n", QUERIES, reps);
+    bench_print_header("ns/query");
+
+    for(long n = 1000; n <= max_n; n *= 10)
+    {
+        if(bench_fill(BENCH_RANDOM, sorted, n, seed) != 0) return 1;
+        mathi_radix_sort(sorted, (int)n);
+        uint64_t qs = seed ^ (uint64_t)n;
+        for(long q = 0; q < QUERIES; q++)
+            queries[q] = (q & 1) ? sorted[bench_rand(&qs) % n] : (int)(bench_rand(&qs) % BENCH_VALUE_MAX);
+
+        MathiSearchIndex *idx = mathi_search_index_build(sorted, (size_t)n);
+        if(!idx)
+        {
+            fprintf(stderr, "search index build failed, n = %ld\n", n);
+            return 1;
+        }
+        for(size_t a = 0; a < sizeof(algos) / sizeof(algos[0]); a++)
+        {
+            if(algos[a].fn == mathi_jump_search && n > JUMP_MAX_N) continue;
+            double ns = time_queries(algos[a].mode, algos[a].fn, idx, sorted, n, queries, out, reps);
+            if(ns < 0) return 1;
+            bench_record(&results, "search", algos[a].name, "random", n, ns);
+            bench_print_result(&results.items[results.count - 1]);
+        }
+        mathi_search_index_free(idx);
+        if(n > max_n / 10) break;
+    }
+
+    if(bench_write_json(&results, json, seed, reps) != 0) return 1;
+    printf("\nJSON results written to %s\n", json);
+
+    free(results.items);
+    free(sorted);
+    free(queries);
+    free(out);
+    return 0;
+}
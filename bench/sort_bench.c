@@ -0,0 +1,189 @@
+/*
+* Mathi C Library - sort_bench.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "mathi/sort.h"
+#include "mathi/array.h"
+
+typedef void (*sort_fn)(int *arr, int n);
+
+static double now_sec()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void fill_random(int *arr, int n)
+{
+    unsigned x = 2463534242u;
+    for(int i = 0; i < n; i++) 
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        arr[i] = (int)x;
+    }
+}
+
+static void fill_sorted(int *arr, int n)
+{
+    for(int i = 0; i < n; i++) arr[i] = i;
+}
+
+static void fill_reversed(int *arr, int n)
+{
+    for(int i = 0; i < n; i++) arr[i] = n - i;
+}
+
+static void fill_organ_pipe(int *arr, int n)
+{
+    for(int i = 0; i < n; i++) arr[i] = i < n / 2 ? i : n - i;
+}
+
+static void fill_nearly_sorted(int *arr, int n)
+{
+    fill_sorted(arr, n);
+    unsigned x = 123456789u;
+    for(int i = 0; i < n / 100; i++) 
+    {
+        x = x * 1103515245u + 12345u;
+        int a = x % n;
+        x = x * 1103515245u + 12345u;
+        int b = x % n;
+        int tmp = arr[a];
+        arr[a] = arr[b];
+        arr[b] = tmp;
+    }
+}
+
+static void fill_appended(int *arr, int n)
+{
+    fill_sorted(arr, n - n / 16);
+    fill_random(arr + n - n / 16, n / 16);
+}
+
+static void fill_equal(int *arr, int n)
+{
+    for(int i = 0; i < n; i++) arr[i] = 7;
+}
+
+static double time_sort(sort_fn fn, const int *input, int *work, int n)
+{
+    memcpy(work, input, n * sizeof(int));
+    double t0 = now_sec();
+    fn(work, n);
+    double t = now_sec() - t0;
+    if(!mathi_arr_sorted(work, n)) 
+    {
+        fprintf(stderr, "sort produced unsorted output\n");
+        exit(1);
+    }
+    return t;
+}
+
+int main(int argc, char **argv)
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    if(n < 1) n = 1000000;
+
+    struct { const char *name; void (*fill)(int *, int); } inputs[] = {
+        {"random", fill_random},
+        {"sorted", fill_sorted},
+        {"reversed", fill_reversed},
+        {"organ-pipe", fill_organ_pipe},
+        {"nearly", fill_nearly_sorted},
+        {"appended", fill_appended},
+        {"all-equal", fill_equal},
+    };
+    struct { const char *name; sort_fn fn; } sorts[] = {
+        {"intro", mathi_intro_sort},
+        {"merge", mathi_merge_sort},
+        {"heap", mathi_heap_sort},
+        {"radix", mathi_radix_sort},
+        {"tim", mathi_tim_sort},
+    };
+    int ninputs = sizeof(inputs) / sizeof(inputs[0]);
+    int nsorts = sizeof(sorts) / sizeof(sorts[0]);
+
+    int *input = malloc(n * sizeof(int)), *work = malloc(n * sizeof(int));
+    if(!input || !work) return 1;
+
+    printf("Sort benchmark, n = %d (ms)\n", n);
+    printf("%-12s", "input");
+    for(int s = 0; s < nsorts; s++) printf("%12s", sorts[s].name);
+    printf("\n");
+
+    for(int i = 0; i < ninputs; i++) 
+    {
+        inputs[i].fill(input, n);
+        printf("%-12s", inputs[i].name);
+        for(int s = 0; s < nsorts; s++) 
+            printf("%12.2f", time_sort(sorts[s].fn, input, work, n) * 1e3);
+        printf("\n");
+    }
+
+    int leaf_sizes[] = {8, 16, 32, 64};
+    int blocks = n / 64 > 0 ? n / 64 : 1;
+    printf("\nSmall-block sort, %d random blocks per size (ms)\n", blocks);
+    printf("%-12s%12s%12s%12s\n", "leaf", "insertion", "network", "speedup");
+    fill_random(input, n);
+    for(size_t l = 0; l < sizeof(leaf_sizes) / sizeof(leaf_sizes[0]); l++) 
+    {
+        int leaf = leaf_sizes[l];
+        double t_ins, t_net;
+
+        memcpy(work, input, n * sizeof(int));
+        double t0 = now_sec();
+        for(int b = 0; b < blocks; b++) mathi_insertion_sort(work + (size_t)b * 64, leaf);
+        t_ins = now_sec() - t0;
+
+        memcpy(work, input, n * sizeof(int));
+        t0 = now_sec();
+        for(int b = 0; b < blocks; b++) mathi_sort_small(work + (size_t)b * 64, leaf);
+        t_net = now_sec() - t0;
+
+        for(int b = 0; b < blocks; b++) 
+            if(!mathi_arr_sorted(work + (size_t)b * 64, leaf)) 
+            {
+                fprintf(stderr, "small sort produced unsorted output\n");
+                return 1;
+            }
+        printf("%-12d%12.2f%12.2f%12.2f\n", leaf, t_ins * 1e3, t_net * 1e3, t_ins / t_net);
+    }
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = cpus > 0 ? (int)cpus : 1;
+
+    printf("\nParallel sort speedup, random input, n = %d\n", n);
+    printf("%-12s%12s%12s\n", "threads", "ms", "speedup");
+    fill_random(input, n);
+    double base = 0;
+    for(int t = 1; ; t *= 2) 
+    {
+        if(t > max_threads) t = max_threads;
+        memcpy(work, input, n * sizeof(int));
+        double t0 = now_sec();
+        mathi_parallel_sort(work, n, t);
+        double elapsed = now_sec() - t0;
+        if(!mathi_arr_sorted(work, n)) 
+        {
+            fprintf(stderr, "parallel sort produced unsorted output\n");
+            return 1;
+        }
+        if(t == 1) base = elapsed;
+        printf("%-12d%12.2f%12.2f\n", t, elapsed * 1e3, base / elapsed);
+        if(t == max_threads) break;
+    }
+
+    free(input);
+    free(work);
+    return 0;
+}
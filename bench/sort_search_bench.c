@@ -0,0 +1,254 @@
+/*
+* Mathi C Library - sort_search_bench.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*
+* Times every in-memory mathi_*_sort and every mathi_*_search over the
+* seeded distributions in bench.h at sizes 1e2 .. --max-n (powers of ten),
+* reporting the median over repetitions as a table and as JSON.
+*
+* Usage: sort_search_bench [--min-n N] [--max-n N] [--reps R] [--seed S] [--json FILE]
+*
+* mathi_external_sort works on files and is not part of this suite.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "mathi/sort.h"
+#include "mathi/search.h"
+#include "mathi/array.h"
+
+/* Quadratic sorts are skipped above this size. */
+#define QUADRATIC_MAX_N 1000
+
+/* Counting sort only runs when the largest key is at most this multiple of n. */
+#define COUNTING_RANGE_FACTOR 16
+
+/* Small sizes sort several copies per timed repetition, so each one covers at least this many elements. */
+#define MIN_BATCH_ELEMS (1 << 16)
+
+/* Queries per search measurement (linear search is additionally capped by total work). */
+#define SEARCH_QUERIES (1 << 16)
+#define LINEAR_SEARCH_WORK 100000000L
+
+typedef void (*sort_fn)(int *arr, int n);
+typedef int (*search_fn)(int *arr, int n, int key);
+
+static void counting_sort(int *arr, int n)
+{
+    int max = 0;
+    for(int i = 0; i < n; i++) if(arr[i] > max) max = arr[i];
+    mathi_counting_sort(arr, n, max);
+}
+
+static void parallel_sort(int *arr, int n)
+{
+    mathi_parallel_sort(arr, n, 0);
+}
+
+static void partial_sort(int *arr, int n)
+{
+    mathi_partial_sort(arr, n, n / 10 + 1);
+}
+
+static void sort_i32(int *arr, int n)
+{
+    mathi_sort_i32(arr, (size_t)n);
+}
+
+static int linear_search(int *arr, int n, int key)
+{
+    return mathi_linear_search(arr, (size_t)n, key);
+}
+
+enum { SORT_FULL, SORT_QUADRATIC, SORT_COUNTING, SORT_PARTIAL };
+
+static const struct { const char *name; sort_fn fn; int kind; } sorts[] = {
+    {"bubble", mathi_bubble_sort, SORT_QUADRATIC},
+    {"selection", mathi_selection_sort, SORT_QUADRATIC},
+    {"insertion", mathi_insertion_sort, SORT_QUADRATIC},
+    {"merge", mathi_merge_sort, SORT_FULL},
+    {"quick", mathi_quick_sort, SORT_FULL},
+    {"heap", mathi_heap_sort, SORT_FULL},
+    {"counting", counting_sort, SORT_COUNTING},
+    {"intro", mathi_intro_sort, SORT_FULL},
+    {"radix", mathi_radix_sort, SORT_FULL},
+    {"parallel", parallel_sort, SORT_FULL},
+    {"tim", mathi_tim_sort, SORT_FULL},
+    {"sort_i32", sort_i32, SORT_FULL},
+    {"partial(n/10)", partial_sort, SORT_PARTIAL},
+};
+
+static const struct { const char *name; search_fn fn; } searches[] = {
+    {"linear", linear_search},
+    {"binary", mathi_binary_search},
+    {"jump", mathi_jump_search},
+    {"interpolation", mathi_interpolation_search},
+};
+
+static int sort_applies(int kind, const int *input, long n)
+{
+    if(kind == SORT_QUADRATIC) return n <= QUADRATIC_MAX_N;
+    if(kind == SORT_COUNTING)
+    {
+        int max = 0;
+        for(long i = 0; i < n; i++) if(input[i] > max) max = input[i];
+        return (long)max <= COUNTING_RANGE_FACTOR * n;
+    }
+    return 1;
+}
+
+static int check_sorted(const int *arr, long n, int kind)
+{
+    long len = kind == SORT_PARTIAL ? n / 10 + 1 : n;
+    return mathi_arr_sorted(arr, (size_t)len);
+}
+
+/* Median ns/element of one sort over reps timed repetitions after one warmup. */
+static double bench_sort(sort_fn fn, int kind, const int *input, int *work, long n, int reps)
+{
+    long batch = n < MIN_BATCH_ELEMS ? MIN_BATCH_ELEMS / n : 1;
+    double *times = malloc(reps * sizeof(double));
+    if(!times) return -1;
+
+    for(int r = -1; r < reps; r++)
+    {
+        for(long b = 0; b < batch; b++) memcpy(work + b * n, input, n * sizeof(int));
+        double t0 = bench_now_ns();
+        for(long b = 0; b < batch; b++) fn(work + b * n, (int)n);
+        double t = bench_now_ns() - t0;
+        if(!check_sorted(work, n, kind))
+        {
+            free(times);
+            return -1;
+        }
+        if(r >= 0) times[r] = t / (batch * n);
+    }
+    double med = bench_median(times, reps);
+    free(times);
+    return med;
+}
+
+/* Median ns/query of one search over a sorted array with half hits, half misses. */
+static double bench_search(search_fn fn, int is_linear, int *sorted, long n, const int *queries,
+                           long m, int reps)
+{
+    if(is_linear && m * n > LINEAR_SEARCH_WORK) m = LINEAR_SEARCH_WORK / n > 16 ? LINEAR_SEARCH_WORK / n : 16;
+    double *times = malloc(reps * sizeof(double));
+    if(!times) return -1;
+    volatile long sink = 0;
+
+    for(int r = -1; r < reps; r++)
+    {
+        long acc = 0;
+        double t0 = bench_now_ns();
+        for(long q = 0; q < m; q++) acc += fn(sorted, (int)n, queries[q]);
+        double t = bench_now_ns() - t0;
+        sink += acc;
+        if(r >= 0) times[r] = t / m;
+    }
+    (void)sink;
+    double med = bench_median(times, reps);
+    free(times);
+    return med;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--min-n N] [--max-n N] [--reps R] [--seed S] [--json FILE]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    long min_n = 100, max_n = 1000000;
+    int reps = 5;
+    uint64_t seed = 42;
+    const char *json = "bench_results.json";
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(i + 1 < argc && strcmp(argv[i], "--min-n") == 0) min_n = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--max-n") == 0) max_n = (long)atof(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--reps") == 0) reps = atoi(argv[++i]);
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], NULL, 10);
+        else if(i + 1 < argc && strcmp(argv[i], "--json") == 0) json = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if(min_n < 1 || max_n < min_n || max_n > 1000000000L || reps < 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    long work_len = max_n > MIN_BATCH_ELEMS ? max_n : 2 * MIN_BATCH_ELEMS;
+    int *input = malloc(max_n * sizeof(int));
+    int *sorted = malloc(max_n * sizeof(int));
+    int *work = malloc(work_len * sizeof(int));
+    int *queries = malloc(SEARCH_QUERIES * sizeof(int));
+    BenchResults results = {0};
+    if(!input || !sorted || !work || !queries) return 1;
+
+    printf("Sort and search benchmark: seed %llu, %d repetitions (median)\n",
+           (unsigned long long)seed, reps);
+    bench_print_header("ns/elem");
+
+    int nsorts = sizeof(sorts) / sizeof(sorts[0]);
+    int nsearches = sizeof(searches) / sizeof(searches[0]);
+
+    for(long n = min_n; n <= max_n; n *= 10)
+    {
+        for(int d = 0; d < BENCH_NUM_DISTS; d++)
+        {
+            if(bench_fill((BenchDist)d, input, n, seed) != 0) return 1;
+
+            for(int s = 0; s < nsorts; s++)
+            {
+                if(!sort_applies(sorts[s].kind, input, n)) continue;
+                double ns = bench_sort(sorts[s].fn, sorts[s].kind, input, work, n, reps);
+                if(ns < 0)
+                {
+                    fprintf(stderr, "%s sort failed on %s, n = %ld\n", sorts[s].name, bench_dist_names[d], n);
+                    return 1;
+                }
+                bench_record(&results, "sort", sorts[s].name, bench_dist_names[d], n, ns);
+                bench_print_result(&results.items[results.count - 1]);
+            }
+
+            memcpy(sorted, input, n * sizeof(int));
+            mathi_radix_sort(sorted, (int)n);
+            uint64_t qs = seed ^ (uint64_t)n;
+            for(long q = 0; q < SEARCH_QUERIES; q++)
+                queries[q] = (q & 1) ? sorted[bench_rand(&qs) % n] : (int)(bench_rand(&qs) % BENCH_VALUE_MAX);
+
+            for(int s = 0; s < nsearches; s++)
+            {
+                double ns = bench_search(searches[s].fn, searches[s].fn == linear_search, sorted, n,
+                                         queries, SEARCH_QUERIES, reps);
+                if(ns < 0) return 1;
+                bench_record(&results, "search", searches[s].name, bench_dist_names[d], n, ns);
+                bench_print_result(&results.items[results.count - 1]);
+            }
+        }
+        if(n > max_n / 10) break;
+    }
+
+    if(bench_write_json(&results, json, seed, reps) != 0)
+    {
+        fprintf(stderr, "could not write %s\n", json);
+        return 1;
+    }
+    printf("\nJSON results written to %s (search rows are ns/query)\n", json);
+
+    free(results.items);
+    free(input);
+    free(sorted);
+    free(work);
+    free(queries);
+    return 0;
+}
@@ -8,6 +8,7 @@
 #define MATHI_ARRAY_H
 
 #include <stddef.h>  // for size_t
+#include <stdint.h>  // for int64_t
 #include <stdlib.h>  // for malloc/free
 
 /**
@@ -33,6 +34,15 @@ int mathi_arr_index(const int *restrict arr, size_t n, int value);
  */
 int mathi_arr_contains(const int *restrict arr, size_t n, int value);
 
+/**
+ * @brief Count the elements of an array equal to a value.
+ * @param arr Array to scan.
+ * @param n Size of the array.
+ * @param value Value to count.
+ * @return Number of occurrences of value.
+ */
+size_t mathi_arr_count(const int *restrict arr, size_t n, int value);
+
 /**
  * @brief Reverse an array in place.
  * @param arr Array to reverse.
@@ -60,9 +70,18 @@ void mathi_arr_fill(int *arr, size_t n, int value);
  * @brief Compute the sum of elements in an array.
  * @param arr Array to sum.
  * @param n Size of the array.
+ * @return Sum of elements, accumulated exactly in int64.
+ */
+int64_t mathi_arr_sum(const int *restrict arr, size_t n);
+
+/**
+ * @brief Multithreaded mathi_arr_sum for large arrays.
+ * @param arr Array to sum.
+ * @param n Size of the array.
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
  * @return Sum of elements.
  */
-int mathi_arr_sum(const int *restrict arr, size_t n);
+int64_t mathi_arr_sum_mt(const int *restrict arr, size_t n, int threads);
 
 /**
  * @brief Find the maximum value in an array.
@@ -88,6 +107,90 @@ int mathi_arr_min(const int *restrict arr, size_t n);
  */
 double mathi_arr_average(const int *restrict arr, size_t n);
 
+/**
+ * @brief Find the minimum and maximum values in one pass.
+ * @param arr Array to search.
+ * @param n Size of the array.
+ * @param min Receives the minimum (may be NULL).
+ * @param max Receives the maximum (may be NULL).
+ * @return 0 on success, -1 if n == 0 (both outputs set to 0).
+ */
+int mathi_arr_minmax(const int *restrict arr, size_t n, int *min, int *max);
+
+/**
+ * @brief Multithreaded mathi_arr_minmax for large arrays.
+ * @param arr Array to search.
+ * @param n Size of the array.
+ * @param min Receives the minimum (may be NULL).
+ * @param max Receives the maximum (may be NULL).
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ * @return 0 on success, -1 if n == 0.
+ */
+int mathi_arr_minmax_mt(const int *restrict arr, size_t n, int *min, int *max, int threads);
+
+/*
+ * Prefix sums. Inclusive: out[i] = in[0] + ... + in[i]; exclusive:
+ * out[0] = 0, out[i] = in[0] + ... + in[i-1]. out may be the same array as
+ * in. Integer scans wrap around on overflow; double scans add in a
+ * different order from a plain loop, so the last bits may differ.
+ */
+
+/**
+ * @brief Inclusive prefix sum (SIMD in-register scan per block).
+ * @param in Input array.
+ * @param out Output array of n elements (may equal in).
+ * @param n Number of elements.
+ */
+void mathi_scan_inclusive_i32(const int32_t *in, int32_t *out, size_t n);
+void mathi_scan_inclusive_i64(const int64_t *in, int64_t *out, size_t n);
+void mathi_scan_inclusive_f64(const double *in, double *out, size_t n);
+
+/**
+ * @brief Exclusive prefix sum (SIMD in-register scan per block).
+ * @param in Input array.
+ * @param out Output array of n elements (may equal in).
+ * @param n Number of elements.
+ */
+void mathi_scan_exclusive_i32(const int32_t *in, int32_t *out, size_t n);
+void mathi_scan_exclusive_i64(const int64_t *in, int64_t *out, size_t n);
+void mathi_scan_exclusive_f64(const double *in, double *out, size_t n);
+
+/**
+ * @brief Multithreaded inclusive prefix sum for large arrays (reduce, then scan).
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ */
+void mathi_scan_inclusive_i32_mt(const int32_t *in, int32_t *out, size_t n, int threads);
+void mathi_scan_inclusive_i64_mt(const int64_t *in, int64_t *out, size_t n, int threads);
+void mathi_scan_inclusive_f64_mt(const double *in, double *out, size_t n, int threads);
+
+/**
+ * @brief Multithreaded exclusive prefix sum for large arrays (reduce, then scan).
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ */
+void mathi_scan_exclusive_i32_mt(const int32_t *in, int32_t *out, size_t n, int threads);
+void mathi_scan_exclusive_i64_mt(const int64_t *in, int64_t *out, size_t n, int threads);
+void mathi_scan_exclusive_f64_mt(const double *in, double *out, size_t n, int threads);
+
+/**
+ * @brief Segmented inclusive prefix sum: the running sum restarts wherever flags[i] != 0.
+ * @param in Input array.
+ * @param flags n segment-start flags (flags[0] is ignored; a segment always starts at 0).
+ * @param out Output array of n elements (may equal in).
+ * @param n Number of elements.
+ */
+void mathi_scan_segmented_i32(const int32_t *in, const unsigned char *flags, int32_t *out, size_t n);
+void mathi_scan_segmented_i64(const int64_t *in, const unsigned char *flags, int64_t *out, size_t n);
+void mathi_scan_segmented_f64(const double *in, const unsigned char *flags, double *out, size_t n);
+
+/**
+ * @brief Sum of squared deviations of the elements from a center value.
+ * @param arr Array to process.
+ * @param n Size of the array.
+ * @param center Value subtracted from every element (usually the mean).
+ * @return Sum of (arr[i] - center)^2.
+ */
+double mathi_arr_sqdev(const int *restrict arr, size_t n, double center);
+
 /**
  * @brief Check if two arrays are equal.
  * @param a First array.
@@ -98,19 +201,56 @@ double mathi_arr_average(const int *restrict arr, size_t n);
 int mathi_arr_equal(const int *restrict a, const int *restrict b, size_t n);
 
 /**
- * @brief Shuffle an array randomly.
+ * @brief Shuffle an array randomly (per-thread generator, seeded once).
  * @param arr Array to shuffle.
  * @param n Size of the array.
  */
 void mathi_arr_shuffle(int *arr, size_t n);
 
+struct MathiXoshiro256; // mathi/prng.h
+
+/**
+ * @brief Unbiased Fisher-Yates shuffle driven by an explicit generator.
+ * @param arr Array to shuffle.
+ * @param n Size of the array.
+ * @param rng xoshiro256** state; advanced by the shuffle.
+ */
+void mathi_arr_shuffle_r(int *arr, size_t n, struct MathiXoshiro256 *rng);
+
+/**
+ * @brief Parallel, allocation-free MergeShuffle for large arrays.
+ * @param arr Array to shuffle.
+ * @param n Size of the array.
+ * @param rng xoshiro256** state; per-block streams are jumped off it.
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ */
+void mathi_arr_shuffle_mt(int *arr, size_t n, struct MathiXoshiro256 *rng, int threads);
+
 /**
- * @brief Remove duplicate elements from an array.
+ * @brief Deduplication strategies for mathi_arr_distinct_mode.
+ */
+typedef enum {
+    MATHI_DISTINCT_HASH,   ///< Hash set; keeps first-seen order
+    MATHI_DISTINCT_SORTED, ///< Sort + unique; output is ascending
+    MATHI_DISTINCT_BITMAP  ///< Bitmap over [min, max]; keeps first-seen order (hash if the range is sparse)
+} MathiDistinctMode;
+
+/**
+ * @brief Remove duplicate elements from an array, keeping first-seen order.
  * @param arr Array to deduplicate.
  * @param n Pointer to size of array; updated with new size.
  */
 void mathi_arr_distinct(int *arr, size_t *n);
 
+/**
+ * @brief Remove duplicate elements using the given strategy.
+ * @param arr Array to deduplicate.
+ * @param n Pointer to size of array; updated with new size.
+ * @param mode MATHI_DISTINCT_HASH, MATHI_DISTINCT_SORTED or MATHI_DISTINCT_BITMAP.
+ * @return 0 on success, -1 on an unknown mode or allocation failure.
+ */
+int mathi_arr_distinct_mode(int *arr, size_t *n, MathiDistinctMode mode);
+
 /**
  * @brief Rotate array elements k times to the right.
  * @param arr Array to rotate.
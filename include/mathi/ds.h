@@ -184,26 +184,83 @@ void mathi_queue_free(Queue *q);
 
 
 /**
- * @struct Pair
- * @brief Key-value pair stored in a hash table.
+ * @struct MathiHashMap
+ * @brief Resizable Robin Hood hash map from strings to void * values.
+ *
+ * Open addressing with the 32-bit hash of every key stored beside it, so
+ * probes compare hashes before strings. Deletion shifts later entries back
+ * (no tombstones). When the load factor is exceeded the map doubles and
+ * moves the old entries over a few slots per insert or remove, so no single
+ * operation rehashes the whole table.
+ */
+typedef struct MathiHashMap MathiHashMap;
+
+/**
+ * @brief Create a hash map.
+ * @param capacity Expected number of entries (0 for the minimum)
+ * @param max_load Load factor that triggers growth, clamped to [0.25, 0.95]; 0 uses 0.875
+ * @return Pointer to new map, or NULL on allocation failure
+ */
+MathiHashMap* mathi_hashmap_new(size_t capacity, double max_load);
+
+/**
+ * @brief Insert a key or update its value. The map keeps its own copy of the key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Value to store (NULL is a valid value)
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_hashmap_set(MathiHashMap *m, const char *key, void *value);
+
+/**
+ * @brief Look up a key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the value if found (may be NULL)
+ * @return 1 if found, 0 if not
+ */
+int mathi_hashmap_get(const MathiHashMap *m, const char *key, void **value);
+
+/**
+ * @brief Remove a key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the removed value if found (may be NULL)
+ * @return 1 if the key was removed, 0 if it was not present
+ */
+int mathi_hashmap_remove(MathiHashMap *m, const char *key, void **value);
+
+/**
+ * @brief Number of entries in the map.
+ * @param m Map pointer
+ * @return Entry count
+ */
+size_t mathi_hashmap_size(const MathiHashMap *m);
+
+/**
+ * @brief Visit the entries in unspecified order.
+ * @param m Map pointer (must not be modified while iterating)
+ * @param iter Iterator state; set to 0 before the first call
+ * @param key Receives the key (may be NULL)
+ * @param value Receives the value (may be NULL)
+ * @return 1 if an entry was produced, 0 when the iteration is finished
+ */
+int mathi_hashmap_next(const MathiHashMap *m, size_t *iter, const char **key, void **value);
+
+/**
+ * @brief Free the map and its key copies; values are not freed.
+ * @param m Map pointer (may be NULL)
  */
-typedef struct {
-    char *key; ///< Dynamically allocated string key
-    int val;   ///< Associated integer value
-} Pair;
+void mathi_hashmap_free(MathiHashMap *m);
 
 /**
- * @struct Hash
- * @brief Simple open-addressing hash table for integer values.
+ * @brief String-to-int hash table; a thin wrapper over MathiHashMap.
  */
-typedef struct {
-    Pair *tab; ///< Array of key-value pairs
-    int n;     ///< Size of the table
-} Hash;
+typedef struct MathiHashMap Hash;
 
 /**
  * @brief Create a new hash table.
- * @param n Number of buckets
+ * @param n Expected number of entries (the table grows as needed)
  * @return Pointer to new Hash
  */
 Hash* mathi_hash_new(int n);
@@ -220,7 +277,7 @@ void mathi_hash_set(Hash *h, const char *k, int v);
  * @brief Get the value associated with a key.
  * @param h Hash pointer
  * @param k Key string
- * @return Value if found, 0 otherwise
+ * @return Value if found, 0 otherwise (use mathi_hashmap_get to tell the two apart)
  */
 int  mathi_hash_get(Hash *h, const char *k);
 
@@ -1,6 +1,6 @@
 /*
  * Mathi C Library - Advanced Data Structures
- * Heap, Graph, Trie
+ * Heap, Graph, Trie, Swiss-table map
  *
  * Copyright (c) 2025 Macharia Nyamū
  * Licensed under the MIT License. See LICENSE file for details.
@@ -131,4 +131,73 @@ void*  mathi_trie_search(Trie *t, const char *key);
  */
 void   mathi_trie_free(Trie *t);
 
+/**
+ * @struct MathiSwissMap
+ * @brief Opaque Swiss-table hash map from strings to void * values.
+ *
+ * A separate array of 7-bit hash tags is probed 16 slots at a time with
+ * SSE2 compare/movemask, so key bytes are only compared on a tag match.
+ * Keys and values live in one flat slot array; keys of up to 15 bytes are
+ * stored inline in the slot.
+ */
+typedef struct MathiSwissMap MathiSwissMap;
+
+/**
+ * @brief Create a Swiss-table map.
+ * @param capacity Expected number of entries (0 for the minimum)
+ * @param max_load Load factor that triggers growth, clamped to [0.25, 0.95]; 0 uses 0.875
+ * @return Pointer to map, or NULL on failure
+ */
+MathiSwissMap* mathi_swissmap_new(size_t capacity, double max_load);
+
+/**
+ * @brief Insert a key or update its value. The map keeps its own copy of the key.
+ * @param m Pointer to map
+ * @param key Null-terminated string key
+ * @param value Value to store (NULL is a valid value)
+ * @return 0 on success, -1 on allocation failure
+ */
+int    mathi_swissmap_set(MathiSwissMap *m, const char *key, void *value);
+
+/**
+ * @brief Look up a key.
+ * @param m Pointer to map
+ * @param key Null-terminated string key
+ * @param value Receives the value if found (may be NULL)
+ * @return 1 if found, 0 if not
+ */
+int    mathi_swissmap_get(const MathiSwissMap *m, const char *key, void **value);
+
+/**
+ * @brief Remove a key.
+ * @param m Pointer to map
+ * @param key Null-terminated string key
+ * @param value Receives the removed value if found (may be NULL)
+ * @return 1 if the key was removed, 0 if it was not present
+ */
+int    mathi_swissmap_remove(MathiSwissMap *m, const char *key, void **value);
+
+/**
+ * @brief Number of entries in the map.
+ * @param m Pointer to map
+ * @return Entry count
+ */
+size_t mathi_swissmap_size(const MathiSwissMap *m);
+
+/**
+ * @brief Visit the entries in unspecified order.
+ * @param m Pointer to map (must not be modified while iterating)
+ * @param iter Iterator state; set to 0 before the first call
+ * @param key Receives the key (may be NULL)
+ * @param value Receives the value (may be NULL)
+ * @return 1 if an entry was produced, 0 when the iteration is finished
+ */
+int    mathi_swissmap_next(const MathiSwissMap *m, size_t *iter, const char **key, void **value);
+
+/**
+ * @brief Free the map and its key copies; values are not freed.
+ * @param m Pointer to map (may be NULL)
+ */
+void   mathi_swissmap_free(MathiSwissMap *m);
+
 #endif // MATHI_DS_ADVANCED_H
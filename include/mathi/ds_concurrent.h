@@ -0,0 +1,117 @@
+/*
+ * Mathi C Library - Concurrent Data Structures
+ * ds_concurrent.h
+ *
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#ifndef MATHI_DS_CONCURRENT_H
+#define MATHI_DS_CONCURRENT_H
+
+#include <stddef.h>
+
+/**
+ * @file mathi/ds_concurrent.h
+ * @brief Thread-safe hash map from strings to void * values, with lock-free
+ *        lookups and striped writer locks.
+ *
+ * Any number of threads may call every function below on the same map at
+ * the same time, except mathi_cmap_free. Lookups take no lock and never
+ * wait for writers. Writers lock one of a fixed set of stripes chosen by
+ * the key's hash, so writes to different stripes proceed in parallel.
+ *
+ * Removed entries and retired tables are freed by epoch-based reclamation:
+ * memory is released only once every thread that could still be reading it
+ * has left the map. When the table outgrows its load factor, a bigger table
+ * is allocated and the writers that come along move the buckets over in
+ * chunks; lookups carry on in whichever table holds their bucket.
+ *
+ * The map never owns or frees values. A value handed out by a lookup may be
+ * removed by another thread at any moment, so values shared between
+ * threads need their own lifetime management.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct MathiCMap
+ * @brief Opaque concurrent hash map (separate chaining, striped locks).
+ */
+typedef struct MathiCMap MathiCMap;
+
+/**
+ * @brief Create a concurrent map.
+ * @param capacity Expected number of entries (0 for the minimum)
+ * @param max_load Average chain length that triggers growth, clamped to [0.25, 4]; 0 uses 0.75
+ * @return Pointer to new map, or NULL on allocation failure
+ */
+MathiCMap* mathi_cmap_new(size_t capacity, double max_load);
+
+/**
+ * @brief Insert a key or atomically replace its value. The map keeps its own copy of the key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Value to store (NULL is a valid value)
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_cmap_set(MathiCMap *m, const char *key, void *value);
+
+/**
+ * @brief Look up a key without taking any lock.
+ *
+ * The result reflects every write that completed before the call started.
+ *
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the value if found (may be NULL)
+ * @return 1 if found, 0 if not
+ */
+int mathi_cmap_get(MathiCMap *m, const char *key, void **value);
+
+/**
+ * @brief Remove a key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the removed value if found (may be NULL)
+ * @return 1 if the key was removed, 0 if it was not present
+ */
+int mathi_cmap_remove(MathiCMap *m, const char *key, void **value);
+
+/**
+ * @brief Number of entries; only a snapshot while other threads write.
+ * @param m Map pointer
+ * @return Entry count
+ */
+size_t mathi_cmap_size(MathiCMap *m);
+
+/**
+ * @brief Call fn for every entry, in unspecified order, without locking.
+ *
+ * Entries present for the whole call are visited exactly once; entries
+ * inserted or removed meanwhile may or may not be. fn may call the other
+ * functions of this map.
+ *
+ * @param m Map pointer
+ * @param fn Callback receiving each key, its value and ctx
+ * @param ctx Passed through to fn
+ */
+void mathi_cmap_foreach(MathiCMap *m, void (*fn)(const char *key, void *value, void *ctx), void *ctx);
+
+/**
+ * @brief Free the map and its key copies; values are not freed.
+ *
+ * No other thread may be using the map. Entries removed earlier are
+ * released by the reclamation scheme, independently of the map.
+ *
+ * @param m Map pointer (may be NULL)
+ */
+void mathi_cmap_free(MathiCMap *m);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MATHI_DS_CONCURRENT_H
@@ -0,0 +1,88 @@
+/*
+ * Mathi C Library - Hash Functions
+ * hashx.h
+ *
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#ifndef MATHI_HASHX_H
+#define MATHI_HASHX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file mathi/hashx.h
+ * @brief Seeded non-cryptographic hashing for hash tables: a fast 64-bit
+ *        hash (wyhash), keyed SipHash-1-3 / SipHash-2-4, and random
+ *        per-table seeds.
+ *
+ * mathi_hash64 is what the library's hash tables use, each with its own
+ * seed from mathi_hash_seed(), so bucket positions differ between tables
+ * and processes. SipHash is the conservative choice when keys come from an
+ * adversary and the seed could leak.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fast seeded 64-bit hash: wyhash (final version 4), with the
+ *        reference implementation's default secret and output.
+ *
+ * Inputs of up to 16 bytes take a single mixing step; longer ones are
+ * consumed 16 bytes per step, and 48 bytes per step in three independent
+ * lanes from 48 bytes on.
+ *
+ * @param data Bytes to hash (may be NULL when len is 0)
+ * @param len Number of bytes
+ * @param seed Seed; different seeds give unrelated hash functions
+ * @return 64-bit hash
+ */
+uint64_t mathi_hash64(const void *data, size_t len, uint64_t seed);
+
+/**
+ * @brief mathi_hash64 of a null-terminated string (without the terminator).
+ * @param s String to hash
+ * @param seed Seed
+ * @return 64-bit hash
+ */
+uint64_t mathi_hash_str(const char *s, uint64_t seed);
+
+/**
+ * @brief SipHash-1-3 keyed hash (one compression and three finalisation rounds).
+ * @param data Bytes to hash
+ * @param len Number of bytes
+ * @param k0 First 64 bits of the 128-bit key (little-endian)
+ * @param k1 Second 64 bits of the key
+ * @return 64-bit hash
+ */
+uint64_t mathi_siphash13(const void *data, size_t len, uint64_t k0, uint64_t k1);
+
+/**
+ * @brief SipHash-2-4 keyed hash (the reference parameters).
+ * @param data Bytes to hash
+ * @param len Number of bytes
+ * @param k0 First 64 bits of the 128-bit key (little-endian)
+ * @param k1 Second 64 bits of the key
+ * @return 64-bit hash
+ */
+uint64_t mathi_siphash24(const void *data, size_t len, uint64_t k0, uint64_t k1);
+
+/**
+ * @brief Fresh random seed for a hash table.
+ *
+ * Derived from a per-process secret (read from /dev/urandom when available)
+ * and a counter, so every call returns a different value. Thread-safe.
+ *
+ * @return 64-bit seed
+ */
+uint64_t mathi_hash_seed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MATHI_HASHX_H
@@ -0,0 +1,560 @@
+/*
+ * Mathi C Library - Integer Hash Maps and Sets
+ * intmap.h
+ *
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#ifndef MATHI_INTMAP_H
+#define MATHI_INTMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mathi/hashx.h"
+
+/**
+ * @file mathi/intmap.h
+ * @brief Macro-templated flat hash maps and sets keyed by integers.
+ *
+ * Open addressing with linear probing over one array of slots, at most
+ * three quarters full; removal shifts later entries back, so there are no
+ * tombstones. Keys are hashed with a 64-bit integer finalizer of the key
+ * and a per-table seed. Key 0 is the empty-slot sentinel, so a zeroed
+ * array is an empty table; the key 0 itself is stored beside the array.
+ *
+ * The library instantiates MathiI32Map / MathiI64Map (int32_t / int64_t
+ * keys to int64_t values) and MathiI32Set / MathiI64Set. Other key and
+ * value types are one MATHI_INTMAP_DECLARE in a header and one
+ * MATHI_INTMAP_DEFINE in a source file away:
+ *
+ * @code
+ * MATHI_INTMAP_DECLARE(IdToPtr, id_to_ptr, uint32_t, void *)
+ * MATHI_INTMAP_DEFINE(IdToPtr, id_to_ptr, uint32_t, void *)
+ *
+ * IdToPtr m;
+ * id_to_ptr_init(&m, 0);
+ * id_to_ptr_put(&m, 42, p);
+ * id_to_ptr_free(&m);
+ * @endcode
+ *
+ * A map declared as (Type, prefix, K, V) provides:
+ *   - int    prefix_init(Type *m, size_t capacity): empty map with room for capacity entries; 0 or -1
+ *   - void   prefix_free(Type *m): release the slots (the map stays usable)
+ *   - void   prefix_clear(Type *m): remove every entry, keeping the capacity
+ *   - int    prefix_reserve(Type *m, size_t n): room for n entries without growing; 0 or -1
+ *   - int    prefix_put(Type *m, K key, V value): insert or update; 0 or -1
+ *   - V*     prefix_emplace(Type *m, K key, int *inserted): value slot of key, zeroed when
+ *            new (*inserted = 1), or NULL on allocation failure; valid until the next insert
+ *   - int    prefix_get(const Type *m, K key, V *value): 1 if found (value may be NULL), else 0
+ *   - int    prefix_remove(Type *m, K key, V *value): 1 if removed, else 0
+ *   - size_t prefix_size(const Type *m)
+ *   - int    prefix_next(const Type *m, size_t *iter, K *key, V *value): iteration from
+ *            *iter = 0 in unspecified order; 1 per entry, then 0
+ *   - int    prefix_put_many(Type *m, const K *keys, const V *values, size_t n): 0 or -1
+ *   - size_t prefix_get_many(const Type *m, const K *keys, size_t n, V *values,
+ *            unsigned char *found): values[i] and found[i] (either may be NULL) for each key;
+ *            values of missing keys are left alone; returns the number found
+ *
+ * A set declared as (Type, prefix, K) provides init, free, clear, reserve,
+ * size as above and:
+ *   - int    prefix_add(Type *s, K key): 1 if added, 0 if already present, -1 on allocation failure
+ *   - int    prefix_contains(const Type *s, K key): 1 or 0
+ *   - int    prefix_remove(Type *s, K key): 1 if removed, else 0
+ *   - int    prefix_next(const Type *s, size_t *iter, K *key)
+ *   - int    prefix_add_many(Type *s, const K *keys, size_t n, unsigned char *added): adds every
+ *            key, setting added[i] (may be NULL) to 1 for keys not present before; 0 or -1
+ *   - size_t prefix_contains_many(const Type *s, const K *keys, size_t n, unsigned char *found)
+ *
+ * The bulk functions prefetch the slots of keys a few positions ahead, so
+ * the cache misses of consecutive keys overlap.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Growth keeps the entries in the slot array at or below NUM / DEN of its capacity. */
+#define MATHI_INTMAP_LOAD_NUM 3
+#define MATHI_INTMAP_LOAD_DEN 4
+
+/* Smallest slot array allocated. */
+#define MATHI_INTMAP_MIN_CAP 16
+
+/* How many keys ahead the bulk functions prefetch. */
+#define MATHI_INTMAP_PREFETCH 8
+
+#if defined(__GNUC__)
+#define mathi_intmap_prefetch_(p) __builtin_prefetch(p)
+#else
+#define mathi_intmap_prefetch_(p) ((void)0)
+#endif
+
+/* Seeded multiply-xorshift finalizer: the folds before and after the multiply
+   carry every key bit into the low bits used as the slot index. */
+static inline uint64_t mathi_intmap_hash_(uint64_t key, uint64_t seed)
+{
+    uint64_t h = key ^ seed;
+    h ^= h >> 32;
+    h *= 0x9E3779B97F4A7C15ull;
+    h ^= h >> 32;
+    return h;
+}
+
+/* Smallest power-of-two capacity whose load limit holds n entries, or 0 if it would overflow. */
+static inline size_t mathi_intmap_capacity_(size_t n)
+{
+    size_t cap = MATHI_INTMAP_MIN_CAP;
+    while(cap / MATHI_INTMAP_LOAD_DEN * MATHI_INTMAP_LOAD_NUM < n)
+    {
+        if(cap > SIZE_MAX / 4) return 0;
+        cap *= 2;
+    }
+    return cap;
+}
+
+/* ----------------------------------------
+   Maps
+---------------------------------------- */
+
+/** @brief Declare map type Type from K (an integer type) to V, and its prefix_* functions. */
+#define MATHI_INTMAP_DECLARE(Type, prefix, K, V)                                          \
+    typedef struct { K key; V value; } Type##Slot;                                        \
+    typedef struct Type {                                                                 \
+        Type##Slot *slots; /* cap slots; key 0 marks an empty one */                      \
+        size_t cap;        /* power of two, or 0 before the first insert */               \
+        size_t size;       /* entries, including key 0 */                                 \
+        uint64_t seed;                                                                    \
+        int has_zero;      /* key 0 is present, with value zero_value */                  \
+        V zero_value;                                                                     \
+    } Type;                                                                               \
+    int prefix##_init(Type *m, size_t capacity);                                          \
+    void prefix##_free(Type *m);                                                          \
+    void prefix##_clear(Type *m);                                                         \
+    int prefix##_reserve(Type *m, size_t n);                                              \
+    int prefix##_put(Type *m, K key, V value);                                            \
+    V* prefix##_emplace(Type *m, K key, int *inserted);                                   \
+    int prefix##_get(const Type *m, K key, V *value);                                     \
+    int prefix##_remove(Type *m, K key, V *value);                                        \
+    size_t prefix##_size(const Type *m);                                                  \
+    int prefix##_next(const Type *m, size_t *iter, K *key, V *value);                     \
+    int prefix##_put_many(Type *m, const K *keys, const V *values, size_t n);             \
+    size_t prefix##_get_many(const Type *m, const K *keys, size_t n, V *values,           \
+                             unsigned char *found);
+
+/** @brief Define the functions declared by MATHI_INTMAP_DECLARE (in exactly one source file). */
+#define MATHI_INTMAP_DEFINE(Type, prefix, K, V)                                           \
+    static inline size_t prefix##_home_(const Type *m, K key)                             \
+    {                                                                                     \
+        return (size_t)mathi_intmap_hash_((uint64_t)key, m->seed) & (m->cap - 1);         \
+    }                                                                                     \
+                                                                                          \
+    /* Slot holding key (non-zero), or m->cap if it is absent. */                        \
+    static inline size_t prefix##_find_(const Type *m, K key)                             \
+    {                                                                                     \
+        if(m->cap == 0) return 0;                                                         \
+        size_t mask = m->cap - 1, i = prefix##_home_(m, key);                             \
+        for(; m->slots[i].key != key; i = (i + 1) & mask)                                 \
+            if(m->slots[i].key == 0) return m->cap;                                       \
+        return i;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    static int prefix##_rehash_(Type *m, size_t cap)                                      \
+    {                                                                                     \
+        Type##Slot *slots = calloc(cap, sizeof(Type##Slot));                              \
+        if(!slots) return -1;                                                             \
+        Type##Slot *old = m->slots;                                                       \
+        size_t old_cap = m->cap;                                                          \
+        m->slots = slots;                                                                 \
+        m->cap = cap;                                                                     \
+        for(size_t j = 0; j < old_cap; j++)                                               \
+        {                                                                                 \
+            if(old[j].key == 0) continue;                                                 \
+            size_t i = prefix##_home_(m, old[j].key);                                     \
+            while(slots[i].key != 0) i = (i + 1) & (cap - 1);                             \
+            slots[i] = old[j];                                                            \
+        }                                                                                 \
+        free(old);                                                                        \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_init(Type *m, size_t capacity)                                           \
+    {                                                                                     \
+        memset(m, 0, sizeof(*m));                                                         \
+        m->seed = mathi_hash_seed();                                                      \
+        return capacity ? prefix##_reserve(m, capacity) : 0;                              \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_free(Type *m)                                                           \
+    {                                                                                     \
+        free(m->slots);                                                                   \
+        m->slots = NULL;                                                                  \
+        m->cap = m->size = 0;                                                             \
+        m->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_clear(Type *m)                                                          \
+    {                                                                                     \
+        if(m->slots) memset(m->slots, 0, m->cap * sizeof(Type##Slot));                   \
+        m->size = 0;                                                                      \
+        m->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_reserve(Type *m, size_t n)                                               \
+    {                                                                                     \
+        size_t cap = mathi_intmap_capacity_(n);                                           \
+        if(cap == 0) return -1;                                                           \
+        return cap > m->cap ? prefix##_rehash_(m, cap) : 0;                               \
+    }                                                                                     \
+                                                                                          \
+    V* prefix##_emplace(Type *m, K key, int *inserted)                                    \
+    {                                                                                     \
+        if(inserted) *inserted = 0;                                                       \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(!m->has_zero)                                                              \
+            {                                                                             \
+                memset(&m->zero_value, 0, sizeof(V));                                     \
+                m->has_zero = 1;                                                          \
+                m->size++;                                                                \
+                if(inserted) *inserted = 1;                                               \
+            }                                                                             \
+            return &m->zero_value;                                                        \
+        }                                                                                 \
+        size_t i = 0;                                                                     \
+        if(m->cap)                                                                        \
+        {                                                                                 \
+            for(i = prefix##_home_(m, key); m->slots[i].key != 0; i = (i + 1) & (m->cap - 1)) \
+                if(m->slots[i].key == key) return &m->slots[i].value;                     \
+        }                                                                                 \
+        if((m->size - m->has_zero + 1) * MATHI_INTMAP_LOAD_DEN > m->cap * MATHI_INTMAP_LOAD_NUM) \
+        {                                                                                 \
+            if(prefix##_rehash_(m, m->cap ? 2 * m->cap : MATHI_INTMAP_MIN_CAP) != 0) return NULL; \
+            for(i = prefix##_home_(m, key); m->slots[i].key != 0; i = (i + 1) & (m->cap - 1)) \
+                ;                                                                         \
+        }                                                                                 \
+        m->slots[i].key = key;                                                            \
+        memset(&m->slots[i].value, 0, sizeof(V));                                         \
+        m->size++;                                                                        \
+        if(inserted) *inserted = 1;                                                       \
+        return &m->slots[i].value;                                                        \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_put(Type *m, K key, V value)                                             \
+    {                                                                                     \
+        V *slot = prefix##_emplace(m, key, NULL);                                         \
+        if(!slot) return -1;                                                              \
+        *slot = value;                                                                    \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_get(const Type *m, K key, V *value)                                      \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(m->has_zero && value) *value = m->zero_value;                              \
+            return m->has_zero;                                                           \
+        }                                                                                 \
+        size_t i = prefix##_find_(m, key);                                                \
+        if(i == m->cap) return 0;                                                         \
+        if(value) *value = m->slots[i].value;                                             \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_remove(Type *m, K key, V *value)                                         \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(!m->has_zero) return 0;                                                    \
+            if(value) *value = m->zero_value;                                             \
+            m->has_zero = 0;                                                              \
+            m->size--;                                                                    \
+            return 1;                                                                     \
+        }                                                                                 \
+        size_t hole = prefix##_find_(m, key), mask = m->cap - 1;                          \
+        if(hole == m->cap) return 0;                                                      \
+        if(value) *value = m->slots[hole].value;                                          \
+        /* Shift back every later entry of the run whose home is not after the hole. */   \
+        for(size_t j = (hole + 1) & mask; m->slots[j].key != 0; j = (j + 1) & mask)       \
+        {                                                                                 \
+            size_t home = prefix##_home_(m, m->slots[j].key);                             \
+            if(((j - home) & mask) >= ((j - hole) & mask))                                \
+            {                                                                             \
+                m->slots[hole] = m->slots[j];                                             \
+                hole = j;                                                                 \
+            }                                                                             \
+        }                                                                                 \
+        m->slots[hole].key = 0;                                                           \
+        m->size--;                                                                        \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_size(const Type *m)                                                   \
+    {                                                                                     \
+        return m->size;                                                                   \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_next(const Type *m, size_t *iter, K *key, V *value)                      \
+    {                                                                                     \
+        while(*iter < m->cap)                                                             \
+        {                                                                                 \
+            size_t i = (*iter)++;                                                         \
+            if(m->slots[i].key == 0) continue;                                            \
+            if(key) *key = m->slots[i].key;                                               \
+            if(value) *value = m->slots[i].value;                                         \
+            return 1;                                                                     \
+        }                                                                                 \
+        /* Key 0 comes last, at position cap. */                                          \
+        if(*iter == m->cap && m->has_zero)                                                \
+        {                                                                                 \
+            (*iter)++;                                                                    \
+            if(key) *key = 0;                                                             \
+            if(value) *value = m->zero_value;                                             \
+            return 1;                                                                     \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_put_many(Type *m, const K *keys, const V *values, size_t n)              \
+    {                                                                                     \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && m->cap)                                   \
+                mathi_intmap_prefetch_(&m->slots[prefix##_home_(m, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            if(prefix##_put(m, keys[i], values[i]) != 0) return -1;                       \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_get_many(const Type *m, const K *keys, size_t n, V *values,           \
+                             unsigned char *found)                                        \
+    {                                                                                     \
+        size_t hits = 0;                                                                  \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && m->cap)                                   \
+                mathi_intmap_prefetch_(&m->slots[prefix##_home_(m, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            int hit = prefix##_get(m, keys[i], values ? &values[i] : NULL);               \
+            if(found) found[i] = (unsigned char)hit;                                      \
+            hits += (size_t)hit;                                                          \
+        }                                                                                 \
+        return hits;                                                                      \
+    }
+
+/* ----------------------------------------
+   Sets
+---------------------------------------- */
+
+/** @brief Declare set type Type of K (an integer type), and its prefix_* functions. */
+#define MATHI_INTSET_DECLARE(Type, prefix, K)                                             \
+    typedef struct Type {                                                                 \
+        K *slots;          /* cap slots; 0 marks an empty one */                          \
+        size_t cap;        /* power of two, or 0 before the first insert */               \
+        size_t size;       /* keys, including 0 */                                        \
+        uint64_t seed;                                                                    \
+        int has_zero;      /* key 0 is present */                                         \
+    } Type;                                                                               \
+    int prefix##_init(Type *s, size_t capacity);                                          \
+    void prefix##_free(Type *s);                                                          \
+    void prefix##_clear(Type *s);                                                         \
+    int prefix##_reserve(Type *s, size_t n);                                              \
+    int prefix##_add(Type *s, K key);                                                     \
+    int prefix##_contains(const Type *s, K key);                                          \
+    int prefix##_remove(Type *s, K key);                                                  \
+    size_t prefix##_size(const Type *s);                                                  \
+    int prefix##_next(const Type *s, size_t *iter, K *key);                               \
+    int prefix##_add_many(Type *s, const K *keys, size_t n, unsigned char *added);        \
+    size_t prefix##_contains_many(const Type *s, const K *keys, size_t n, unsigned char *found);
+
+/** @brief Define the functions declared by MATHI_INTSET_DECLARE (in exactly one source file). */
+#define MATHI_INTSET_DEFINE(Type, prefix, K)                                              \
+    static inline size_t prefix##_home_(const Type *s, K key)                             \
+    {                                                                                     \
+        return (size_t)mathi_intmap_hash_((uint64_t)key, s->seed) & (s->cap - 1);         \
+    }                                                                                     \
+                                                                                          \
+    static int prefix##_rehash_(Type *s, size_t cap)                                      \
+    {                                                                                     \
+        K *slots = calloc(cap, sizeof(K));                                                \
+        if(!slots) return -1;                                                             \
+        K *old = s->slots;                                                                \
+        size_t old_cap = s->cap;                                                          \
+        s->slots = slots;                                                                 \
+        s->cap = cap;                                                                     \
+        for(size_t j = 0; j < old_cap; j++)                                               \
+        {                                                                                 \
+            if(old[j] == 0) continue;                                                     \
+            size_t i = prefix##_home_(s, old[j]);                                         \
+            while(slots[i] != 0) i = (i + 1) & (cap - 1);                                 \
+            slots[i] = old[j];                                                            \
+        }                                                                                 \
+        free(old);                                                                        \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_init(Type *s, size_t capacity)                                           \
+    {                                                                                     \
+        memset(s, 0, sizeof(*s));                                                         \
+        s->seed = mathi_hash_seed();                                                      \
+        return capacity ? prefix##_reserve(s, capacity) : 0;                              \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_free(Type *s)                                                           \
+    {                                                                                     \
+        free(s->slots);                                                                   \
+        s->slots = NULL;                                                                  \
+        s->cap = s->size = 0;                                                             \
+        s->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_clear(Type *s)                                                          \
+    {                                                                                     \
+        if(s->slots) memset(s->slots, 0, s->cap * sizeof(K));                             \
+        s->size = 0;                                                                      \
+        s->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_reserve(Type *s, size_t n)                                               \
+    {                                                                                     \
+        size_t cap = mathi_intmap_capacity_(n);                                           \
+        if(cap == 0) return -1;                                                           \
+        return cap > s->cap ? prefix##_rehash_(s, cap) : 0;                               \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_add(Type *s, K key)                                                      \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(s->has_zero) return 0;                                                     \
+            s->has_zero = 1;                                                              \
+            s->size++;                                                                    \
+            return 1;                                                                     \
+        }                                                                                 \
+        size_t i = 0;                                                                     \
+        if(s->cap)                                                                        \
+        {                                                                                 \
+            for(i = prefix##_home_(s, key); s->slots[i] != 0; i = (i + 1) & (s->cap - 1)) \
+                if(s->slots[i] == key) return 0;                                          \
+        }                                                                                 \
+        if((s->size - s->has_zero + 1) * MATHI_INTMAP_LOAD_DEN > s->cap * MATHI_INTMAP_LOAD_NUM) \
+        {                                                                                 \
+            if(prefix##_rehash_(s, s->cap ? 2 * s->cap : MATHI_INTMAP_MIN_CAP) != 0) return -1; \
+            for(i = prefix##_home_(s, key); s->slots[i] != 0; i = (i + 1) & (s->cap - 1)) \
+                ;                                                                         \
+        }                                                                                 \
+        s->slots[i] = key;                                                                \
+        s->size++;                                                                        \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_contains(const Type *s, K key)                                           \
+    {                                                                                     \
+        if(key == 0) return s->has_zero;                                                  \
+        if(s->cap == 0) return 0;                                                         \
+        for(size_t i = prefix##_home_(s, key); s->slots[i] != 0; i = (i + 1) & (s->cap - 1)) \
+            if(s->slots[i] == key) return 1;                                              \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_remove(Type *s, K key)                                                   \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(!s->has_zero) return 0;                                                    \
+            s->has_zero = 0;                                                              \
+            s->size--;                                                                    \
+            return 1;                                                                     \
+        }                                                                                 \
+        if(s->cap == 0) return 0;                                                         \
+        size_t mask = s->cap - 1, hole = prefix##_home_(s, key);                          \
+        for(; s->slots[hole] != key; hole = (hole + 1) & mask)                            \
+            if(s->slots[hole] == 0) return 0;                                             \
+        /* Shift back every later key of the run whose home is not after the hole. */     \
+        for(size_t j = (hole + 1) & mask; s->slots[j] != 0; j = (j + 1) & mask)           \
+        {                                                                                 \
+            size_t home = prefix##_home_(s, s->slots[j]);                                 \
+            if(((j - home) & mask) >= ((j - hole) & mask))                                \
+            {                                                                             \
+                s->slots[hole] = s->slots[j];                                             \
+                hole = j;                                                                 \
+            }                                                                             \
+        }                                                                                 \
+        s->slots[hole] = 0;                                                               \
+        s->size--;                                                                        \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_size(const Type *s)                                                   \
+    {                                                                                     \
+        return s->size;                                                                   \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_next(const Type *s, size_t *iter, K *key)                                \
+    {                                                                                     \
+        while(*iter < s->cap)                                                             \
+        {                                                                                 \
+            size_t i = (*iter)++;                                                         \
+            if(s->slots[i] == 0) continue;                                                \
+            if(key) *key = s->slots[i];                                                   \
+            return 1;                                                                     \
+        }                                                                                 \
+        /* Key 0 comes last, at position cap. */                                          \
+        if(*iter == s->cap && s->has_zero)                                                \
+        {                                                                                 \
+            (*iter)++;                                                                    \
+            if(key) *key = 0;                                                             \
+            return 1;                                                                     \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_add_many(Type *s, const K *keys, size_t n, unsigned char *added)         \
+    {                                                                                     \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && s->cap)                                   \
+                mathi_intmap_prefetch_(&s->slots[prefix##_home_(s, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            int r = prefix##_add(s, keys[i]);                                             \
+            if(r < 0) return -1;                                                          \
+            if(added) added[i] = (unsigned char)r;                                        \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_contains_many(const Type *s, const K *keys, size_t n, unsigned char *found) \
+    {                                                                                     \
+        size_t hits = 0;                                                                  \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && s->cap)                                   \
+                mathi_intmap_prefetch_(&s->slots[prefix##_home_(s, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            int hit = prefix##_contains(s, keys[i]);                                      \
+            if(found) found[i] = (unsigned char)hit;                                      \
+            hits += (size_t)hit;                                                          \
+        }                                                                                 \
+        return hits;                                                                      \
+    }
+
+/* ----------------------------------------
+   Instances built into the library
+---------------------------------------- */
+
+/** @brief int32_t -> int64_t map (mathi_i32map_*). */
+MATHI_INTMAP_DECLARE(MathiI32Map, mathi_i32map, int32_t, int64_t)
+
+/** @brief int64_t -> int64_t map (mathi_i64map_*). */
+MATHI_INTMAP_DECLARE(MathiI64Map, mathi_i64map, int64_t, int64_t)
+
+/** @brief Set of int32_t (mathi_i32set_*). */
+MATHI_INTSET_DECLARE(MathiI32Set, mathi_i32set, int32_t)
+
+/** @brief Set of int64_t (mathi_i64set_*). */
+MATHI_INTSET_DECLARE(MathiI64Set, mathi_i64set, int64_t)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MATHI_INTMAP_H
@@ -2,9 +2,11 @@
 #define MATHI_H
 
 #include <stddef.h>  // for size_t
+#include <stdint.h>  // for fixed-width integer types
 #include <stdlib.h>  // for abs()
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>  // for memcpy/memset in the vector macros
  
  
 // --- algo.h ---
@@ -85,6 +87,15 @@ int mathi_arr_index(const int *restrict arr, size_t n, int value);
  */
 int mathi_arr_contains(const int *restrict arr, size_t n, int value);
 
+/**
+ * @brief Count the elements of an array equal to a value.
+ * @param arr Array to scan.
+ * @param n Size of the array.
+ * @param value Value to count.
+ * @return Number of occurrences of value.
+ */
+size_t mathi_arr_count(const int *restrict arr, size_t n, int value);
+
 /**
  * @brief Reverse an array in place.
  * @param arr Array to reverse.
@@ -112,9 +123,18 @@ void mathi_arr_fill(int *arr, size_t n, int value);
  * @brief Compute the sum of elements in an array.
  * @param arr Array to sum.
  * @param n Size of the array.
+ * @return Sum of elements, accumulated exactly in int64.
+ */
+int64_t mathi_arr_sum(const int *restrict arr, size_t n);
+
+/**
+ * @brief Multithreaded mathi_arr_sum for large arrays.
+ * @param arr Array to sum.
+ * @param n Size of the array.
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
  * @return Sum of elements.
  */
-int mathi_arr_sum(const int *restrict arr, size_t n);
+int64_t mathi_arr_sum_mt(const int *restrict arr, size_t n, int threads);
 
 /**
  * @brief Find the maximum value in an array.
@@ -140,6 +160,90 @@ int mathi_arr_min(const int *restrict arr, size_t n);
  */
 double mathi_arr_average(const int *restrict arr, size_t n);
 
+/**
+ * @brief Find the minimum and maximum values in one pass.
+ * @param arr Array to search.
+ * @param n Size of the array.
+ * @param min Receives the minimum (may be NULL).
+ * @param max Receives the maximum (may be NULL).
+ * @return 0 on success, -1 if n == 0 (both outputs set to 0).
+ */
+int mathi_arr_minmax(const int *restrict arr, size_t n, int *min, int *max);
+
+/**
+ * @brief Multithreaded mathi_arr_minmax for large arrays.
+ * @param arr Array to search.
+ * @param n Size of the array.
+ * @param min Receives the minimum (may be NULL).
+ * @param max Receives the maximum (may be NULL).
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ * @return 0 on success, -1 if n == 0.
+ */
+int mathi_arr_minmax_mt(const int *restrict arr, size_t n, int *min, int *max, int threads);
+
+/*
+ * Prefix sums. Inclusive: out[i] = in[0] + ... + in[i]; exclusive:
+ * out[0] = 0, out[i] = in[0] + ... + in[i-1]. out may be the same array as
+ * in. Integer scans wrap around on overflow; double scans add in a
+ * different order from a plain loop, so the last bits may differ.
+ */
+
+/**
+ * @brief Inclusive prefix sum (SIMD in-register scan per block).
+ * @param in Input array.
+ * @param out Output array of n elements (may equal in).
+ * @param n Number of elements.
+ */
+void mathi_scan_inclusive_i32(const int32_t *in, int32_t *out, size_t n);
+void mathi_scan_inclusive_i64(const int64_t *in, int64_t *out, size_t n);
+void mathi_scan_inclusive_f64(const double *in, double *out, size_t n);
+
+/**
+ * @brief Exclusive prefix sum (SIMD in-register scan per block).
+ * @param in Input array.
+ * @param out Output array of n elements (may equal in).
+ * @param n Number of elements.
+ */
+void mathi_scan_exclusive_i32(const int32_t *in, int32_t *out, size_t n);
+void mathi_scan_exclusive_i64(const int64_t *in, int64_t *out, size_t n);
+void mathi_scan_exclusive_f64(const double *in, double *out, size_t n);
+
+/**
+ * @brief Multithreaded inclusive prefix sum for large arrays (reduce, then scan).
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ */
+void mathi_scan_inclusive_i32_mt(const int32_t *in, int32_t *out, size_t n, int threads);
+void mathi_scan_inclusive_i64_mt(const int64_t *in, int64_t *out, size_t n, int threads);
+void mathi_scan_inclusive_f64_mt(const double *in, double *out, size_t n, int threads);
+
+/**
+ * @brief Multithreaded exclusive prefix sum for large arrays (reduce, then scan).
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ */
+void mathi_scan_exclusive_i32_mt(const int32_t *in, int32_t *out, size_t n, int threads);
+void mathi_scan_exclusive_i64_mt(const int64_t *in, int64_t *out, size_t n, int threads);
+void mathi_scan_exclusive_f64_mt(const double *in, double *out, size_t n, int threads);
+
+/**
+ * @brief Segmented inclusive prefix sum: the running sum restarts wherever flags[i] != 0.
+ * @param in Input array.
+ * @param flags n segment-start flags (flags[0] is ignored; a segment always starts at 0).
+ * @param out Output array of n elements (may equal in).
+ * @param n Number of elements.
+ */
+void mathi_scan_segmented_i32(const int32_t *in, const unsigned char *flags, int32_t *out, size_t n);
+void mathi_scan_segmented_i64(const int64_t *in, const unsigned char *flags, int64_t *out, size_t n);
+void mathi_scan_segmented_f64(const double *in, const unsigned char *flags, double *out, size_t n);
+
+/**
+ * @brief Sum of squared deviations of the elements from a center value.
+ * @param arr Array to process.
+ * @param n Size of the array.
+ * @param center Value subtracted from every element (usually the mean).
+ * @return Sum of (arr[i] - center)^2.
+ */
+double mathi_arr_sqdev(const int *restrict arr, size_t n, double center);
+
 /**
  * @brief Check if two arrays are equal.
  * @param a First array.
@@ -150,19 +254,56 @@ double mathi_arr_average(const int *restrict arr, size_t n);
 int mathi_arr_equal(const int *restrict a, const int *restrict b, size_t n);
 
 /**
- * @brief Shuffle an array randomly.
+ * @brief Shuffle an array randomly (per-thread generator, seeded once).
  * @param arr Array to shuffle.
  * @param n Size of the array.
  */
 void mathi_arr_shuffle(int *arr, size_t n);
 
+struct MathiXoshiro256; // mathi/prng.h
+
+/**
+ * @brief Unbiased Fisher-Yates shuffle driven by an explicit generator.
+ * @param arr Array to shuffle.
+ * @param n Size of the array.
+ * @param rng xoshiro256** state; advanced by the shuffle.
+ */
+void mathi_arr_shuffle_r(int *arr, size_t n, struct MathiXoshiro256 *rng);
+
 /**
- * @brief Remove duplicate elements from an array.
+ * @brief Parallel, allocation-free MergeShuffle for large arrays.
+ * @param arr Array to shuffle.
+ * @param n Size of the array.
+ * @param rng xoshiro256** state; per-block streams are jumped off it.
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ */
+void mathi_arr_shuffle_mt(int *arr, size_t n, struct MathiXoshiro256 *rng, int threads);
+
+/**
+ * @brief Deduplication strategies for mathi_arr_distinct_mode.
+ */
+typedef enum {
+    MATHI_DISTINCT_HASH,   ///< Hash set; keeps first-seen order
+    MATHI_DISTINCT_SORTED, ///< Sort + unique; output is ascending
+    MATHI_DISTINCT_BITMAP  ///< Bitmap over [min, max]; keeps first-seen order (hash if the range is sparse)
+} MathiDistinctMode;
+
+/**
+ * @brief Remove duplicate elements from an array, keeping first-seen order.
  * @param arr Array to deduplicate.
  * @param n Pointer to size of array; updated with new size.
  */
 void mathi_arr_distinct(int *arr, size_t *n);
 
+/**
+ * @brief Remove duplicate elements using the given strategy.
+ * @param arr Array to deduplicate.
+ * @param n Pointer to size of array; updated with new size.
+ * @param mode MATHI_DISTINCT_HASH, MATHI_DISTINCT_SORTED or MATHI_DISTINCT_BITMAP.
+ * @return 0 on success, -1 on an unknown mode or allocation failure.
+ */
+int mathi_arr_distinct_mode(int *arr, size_t *n, MathiDistinctMode mode);
+
 /**
  * @brief Rotate array elements k times to the right.
  * @param arr Array to rotate.
@@ -651,26 +792,83 @@ void mathi_queue_free(Queue *q);
 
 
 /**
- * @struct Pair
- * @brief Key-value pair stored in a hash table.
+ * @struct MathiHashMap
+ * @brief Resizable Robin Hood hash map from strings to void * values.
+ *
+ * Open addressing with the 32-bit hash of every key stored beside it, so
+ * probes compare hashes before strings. Deletion shifts later entries back
+ * (no tombstones). When the load factor is exceeded the map doubles and
+ * moves the old entries over a few slots per insert or remove, so no single
+ * operation rehashes the whole table.
  */
-typedef struct {
-    char *key; ///< Dynamically allocated string key
-    int val;   ///< Associated integer value
-} Pair;
+typedef struct MathiHashMap MathiHashMap;
 
 /**
- * @struct Hash
- * @brief Simple open-addressing hash table for integer values.
+ * @brief Create a hash map.
+ * @param capacity Expected number of entries (0 for the minimum)
+ * @param max_load Load factor that triggers growth, clamped to [0.25, 0.95]; 0 uses 0.875
+ * @return Pointer to new map, or NULL on allocation failure
  */
-typedef struct {
-    Pair *tab; ///< Array of key-value pairs
-    int n;     ///< Size of the table
-} Hash;
+MathiHashMap* mathi_hashmap_new(size_t capacity, double max_load);
+
+/**
+ * @brief Insert a key or update its value. The map keeps its own copy of the key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Value to store (NULL is a valid value)
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_hashmap_set(MathiHashMap *m, const char *key, void *value);
+
+/**
+ * @brief Look up a key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the value if found (may be NULL)
+ * @return 1 if found, 0 if not
+ */
+int mathi_hashmap_get(const MathiHashMap *m, const char *key, void **value);
+
+/**
+ * @brief Remove a key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the removed value if found (may be NULL)
+ * @return 1 if the key was removed, 0 if it was not present
+ */
+int mathi_hashmap_remove(MathiHashMap *m, const char *key, void **value);
+
+/**
+ * @brief Number of entries in the map.
+ * @param m Map pointer
+ * @return Entry count
+ */
+size_t mathi_hashmap_size(const MathiHashMap *m);
+
+/**
+ * @brief Visit the entries in unspecified order.
+ * @param m Map pointer (must not be modified while iterating)
+ * @param iter Iterator state; set to 0 before the first call
+ * @param key Receives the key (may be NULL)
+ * @param value Receives the value (may be NULL)
+ * @return 1 if an entry was produced, 0 when the iteration is finished
+ */
+int mathi_hashmap_next(const MathiHashMap *m, size_t *iter, const char **key, void **value);
+
+/**
+ * @brief Free the map and its key copies; values are not freed.
+ * @param m Map pointer (may be NULL)
+ */
+void mathi_hashmap_free(MathiHashMap *m);
+
+/**
+ * @brief String-to-int hash table; a thin wrapper over MathiHashMap.
+ */
+typedef struct MathiHashMap Hash;
 
 /**
  * @brief Create a new hash table.
- * @param n Number of buckets
+ * @param n Expected number of entries (the table grows as needed)
  * @return Pointer to new Hash
  */
 Hash* mathi_hash_new(int n);
@@ -687,7 +885,7 @@ void mathi_hash_set(Hash *h, const char *k, int v);
  * @brief Get the value associated with a key.
  * @param h Hash pointer
  * @param k Key string
- * @return Value if found, 0 otherwise
+ * @return Value if found, 0 otherwise (use mathi_hashmap_get to tell the two apart)
  */
 int  mathi_hash_get(Hash *h, const char *k);
 
@@ -831,6 +1029,81 @@ void*  mathi_trie_search(Trie *t, const char *key);
  */
 void   mathi_trie_free(Trie *t);
 
+/**
+ * @struct MathiSwissMap
+ * @brief Opaque Swiss-table hash map from strings to void * values.
+ *
+ * A separate array of 7-bit hash tags is probed 16 slots at a time with
+ * SSE2 compare/movemask, so key bytes are only compared on a tag match.
+ * Keys and values live in one flat slot array; keys of up to 15 bytes are
+ * stored inline in the slot.
+ */
+typedef struct MathiSwissMap MathiSwissMap;
+
+/**
+ * @brief Create a Swiss-table map.
+ * @param capacity Expected number of entries (0 for the minimum)
+ * @param max_load Load factor that triggers growth, clamped to [0.25, 0.95]; 0 uses 0.875
+ * @return Pointer to map, or NULL on failure
+ */
+MathiSwissMap* mathi_swissmap_new(size_t capacity, double max_load);
+
+/**
+ * @brief Insert a key or update its value. The map keeps its own copy of the key.
+ * @param m Pointer to map
+ * @param key Null-terminated string key
+ * @param value Value to store (NULL is a valid value)
+ * @return 0 on success, -1 on allocation failure
+ */
+int    mathi_swissmap_set(MathiSwissMap *m, const char *key, void *value);
+
+/**
+ * @brief Look up a key.
+ * @param m Pointer to map
+ * @param key Null-terminated string key
+ * @param value Receives the value if found (may be NULL)
+ * @return 1 if found, 0 if not
+ */
+int    mathi_swissmap_get(const MathiSwissMap *m, const char *key, void **value);
+
+/**
+ * @brief Remove a key.
+ * @param m Pointer to map
+ * @param key Null-terminated string key
+ * @param value Receives the removed value if found (may be NULL)
+ * @return 1 if the key was removed, 0 if it was not present
+ */
+int    mathi_swissmap_remove(MathiSwissMap *m, const char *key, void **value);
+
+/**
+ * @brief Number of entries in the map.
+ * @param m Pointer to map
+ * @return Entry count
+ */
+size_t mathi_swissmap_size(const MathiSwissMap *m);
+
+/**
+ * @brief Visit the entries in unspecified order.
+ * @param m Pointer to map (must not be modified while iterating)
+ * @param iter Iterator state; set to 0 before the first call
+ * @param key Receives the key (may be NULL)
+ * @param value Receives the value (may be NULL)
+ * @return 1 if an entry was produced, 0 when the iteration is finished
+ */
+int    mathi_swissmap_next(const MathiSwissMap *m, size_t *iter, const char **key, void **value);
+
+/**
+ * @brief Free the map and its key copies; values are not freed.
+ * @param m Pointer to map (may be NULL)
+ */
+void   mathi_swissmap_free(MathiSwissMap *m);
+
+
+
+
+
+
+
 
 
 
@@ -839,8 +1112,88 @@ void   mathi_trie_free(Trie *t);
 
 
 
+// --- ds_concurrent.h ---
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct MathiCMap
+ * @brief Opaque concurrent hash map (separate chaining, striped locks).
+ */
+typedef struct MathiCMap MathiCMap;
+
+/**
+ * @brief Create a concurrent map.
+ * @param capacity Expected number of entries (0 for the minimum)
+ * @param max_load Average chain length that triggers growth, clamped to [0.25, 4]; 0 uses 0.75
+ * @return Pointer to new map, or NULL on allocation failure
+ */
+MathiCMap* mathi_cmap_new(size_t capacity, double max_load);
+
+/**
+ * @brief Insert a key or atomically replace its value. The map keeps its own copy of the key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Value to store (NULL is a valid value)
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_cmap_set(MathiCMap *m, const char *key, void *value);
+
+/**
+ * @brief Look up a key without taking any lock.
+ *
+ * The result reflects every write that completed before the call started.
+ *
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the value if found (may be NULL)
+ * @return 1 if found, 0 if not
+ */
+int mathi_cmap_get(MathiCMap *m, const char *key, void **value);
+
+/**
+ * @brief Remove a key.
+ * @param m Map pointer
+ * @param key Key string
+ * @param value Receives the removed value if found (may be NULL)
+ * @return 1 if the key was removed, 0 if it was not present
+ */
+int mathi_cmap_remove(MathiCMap *m, const char *key, void **value);
+
+/**
+ * @brief Number of entries; only a snapshot while other threads write.
+ * @param m Map pointer
+ * @return Entry count
+ */
+size_t mathi_cmap_size(MathiCMap *m);
+
+/**
+ * @brief Call fn for every entry, in unspecified order, without locking.
+ *
+ * Entries present for the whole call are visited exactly once; entries
+ * inserted or removed meanwhile may or may not be. fn may call the other
+ * functions of this map.
+ *
+ * @param m Map pointer
+ * @param fn Callback receiving each key, its value and ctx
+ * @param ctx Passed through to fn
+ */
+void mathi_cmap_foreach(MathiCMap *m, void (*fn)(const char *key, void *value, void *ctx), void *ctx);
 
+/**
+ * @brief Free the map and its key copies; values are not freed.
+ *
+ * No other thread may be using the map. Entries removed earlier are
+ * released by the reclamation scheme, independently of the map.
+ *
+ * @param m Map pointer (may be NULL)
+ */
+void mathi_cmap_free(MathiCMap *m);
 
+#ifdef __cplusplus
+}
+#endif
 
 
 
@@ -943,6 +1296,71 @@ int mathi_file_delete(const char *path);
 
 
 
+// --- hashx.h ---
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fast seeded 64-bit hash: wyhash (final version 4), with the
+ *        reference implementation's default secret and output.
+ *
+ * Inputs of up to 16 bytes take a single mixing step; longer ones are
+ * consumed 16 bytes per step, and 48 bytes per step in three independent
+ * lanes from 48 bytes on.
+ *
+ * @param data Bytes to hash (may be NULL when len is 0)
+ * @param len Number of bytes
+ * @param seed Seed; different seeds give unrelated hash functions
+ * @return 64-bit hash
+ */
+uint64_t mathi_hash64(const void *data, size_t len, uint64_t seed);
+
+/**
+ * @brief mathi_hash64 of a null-terminated string (without the terminator).
+ * @param s String to hash
+ * @param seed Seed
+ * @return 64-bit hash
+ */
+uint64_t mathi_hash_str(const char *s, uint64_t seed);
+
+/**
+ * @brief SipHash-1-3 keyed hash (one compression and three finalisation rounds).
+ * @param data Bytes to hash
+ * @param len Number of bytes
+ * @param k0 First 64 bits of the 128-bit key (little-endian)
+ * @param k1 Second 64 bits of the key
+ * @return 64-bit hash
+ */
+uint64_t mathi_siphash13(const void *data, size_t len, uint64_t k0, uint64_t k1);
+
+/**
+ * @brief SipHash-2-4 keyed hash (the reference parameters).
+ * @param data Bytes to hash
+ * @param len Number of bytes
+ * @param k0 First 64 bits of the 128-bit key (little-endian)
+ * @param k1 Second 64 bits of the key
+ * @return 64-bit hash
+ */
+uint64_t mathi_siphash24(const void *data, size_t len, uint64_t k0, uint64_t k1);
+
+/**
+ * @brief Fresh random seed for a hash table.
+ *
+ * Derived from a per-process secret (read from /dev/urandom when available)
+ * and a counter, so every call returns a different value. Thread-safe.
+ *
+ * @return 64-bit seed
+ */
+uint64_t mathi_hash_seed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+
 // --- inputx.h ---
 #define INPUT_OK              0
 #define INPUT_EMPTY           1
@@ -1006,6 +1424,495 @@ InputResult mathi_get_string(const char *prompt);
 
 
 
+// --- intmap.h ---
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Growth keeps the entries in the slot array at or below NUM / DEN of its capacity. */
+#define MATHI_INTMAP_LOAD_NUM 3
+#define MATHI_INTMAP_LOAD_DEN 4
+
+/* Smallest slot array allocated. */
+#define MATHI_INTMAP_MIN_CAP 16
+
+/* How many keys ahead the bulk functions prefetch. */
+#define MATHI_INTMAP_PREFETCH 8
+
+#if defined(__GNUC__)
+#define mathi_intmap_prefetch_(p) __builtin_prefetch(p)
+#else
+#define mathi_intmap_prefetch_(p) ((void)0)
+#endif
+
+/* Seeded multiply-xorshift finalizer: the folds before and after the multiply
+   carry every key bit into the low bits used as the slot index. */
+static inline uint64_t mathi_intmap_hash_(uint64_t key, uint64_t seed)
+{
+    uint64_t h = key ^ seed;
+    h ^= h >> 32;
+    h *= 0x9E3779B97F4A7C15ull;
+    h ^= h >> 32;
+    return h;
+}
+
+/* Smallest power-of-two capacity whose load limit holds n entries, or 0 if it would overflow. */
+static inline size_t mathi_intmap_capacity_(size_t n)
+{
+    size_t cap = MATHI_INTMAP_MIN_CAP;
+    while(cap / MATHI_INTMAP_LOAD_DEN * MATHI_INTMAP_LOAD_NUM < n)
+    {
+        if(cap > SIZE_MAX / 4) return 0;
+        cap *= 2;
+    }
+    return cap;
+}
+
+/* ----------------------------------------
+   Maps
+---------------------------------------- */
+
+/** @brief Declare map type Type from K (an integer type) to V, and its prefix_* functions. */
+#define MATHI_INTMAP_DECLARE(Type, prefix, K, V)                                          \
+    typedef struct { K key; V value; } Type##Slot;                                        \
+    typedef struct Type {                                                                 \
+        Type##Slot *slots; /* cap slots; key 0 marks an empty one */                      \
+        size_t cap;        /* power of two, or 0 before the first insert */               \
+        size_t size;       /* entries, including key 0 */                                 \
+        uint64_t seed;                                                                    \
+        int has_zero;      /* key 0 is present, with value zero_value */                  \
+        V zero_value;                                                                     \
+    } Type;                                                                               \
+    int prefix##_init(Type *m, size_t capacity);                                          \
+    void prefix##_free(Type *m);                                                          \
+    void prefix##_clear(Type *m);                                                         \
+    int prefix##_reserve(Type *m, size_t n);                                              \
+    int prefix##_put(Type *m, K key, V value);                                            \
+    V* prefix##_emplace(Type *m, K key, int *inserted);                                   \
+    int prefix##_get(const Type *m, K key, V *value);                                     \
+    int prefix##_remove(Type *m, K key, V *value);                                        \
+    size_t prefix##_size(const Type *m);                                                  \
+    int prefix##_next(const Type *m, size_t *iter, K *key, V *value);                     \
+    int prefix##_put_many(Type *m, const K *keys, const V *values, size_t n);             \
+    size_t prefix##_get_many(const Type *m, const K *keys, size_t n, V *values,           \
+                             unsigned char *found);
+
+/** @brief Define the functions declared by MATHI_INTMAP_DECLARE (in exactly one source file). */
+#define MATHI_INTMAP_DEFINE(Type, prefix, K, V)                                           \
+    static inline size_t prefix##_home_(const Type *m, K key)                             \
+    {                                                                                     \
+        return (size_t)mathi_intmap_hash_((uint64_t)key, m->seed) & (m->cap - 1);         \
+    }                                                                                     \
+                                                                                          \
+    /* Slot holding key (non-zero), or m->cap if it is absent. */                        \
+    static inline size_t prefix##_find_(const Type *m, K key)                             \
+    {                                                                                     \
+        if(m->cap == 0) return 0;                                                         \
+        size_t mask = m->cap - 1, i = prefix##_home_(m, key);                             \
+        for(; m->slots[i].key != key; i = (i + 1) & mask)                                 \
+            if(m->slots[i].key == 0) return m->cap;                                       \
+        return i;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    static int prefix##_rehash_(Type *m, size_t cap)                                      \
+    {                                                                                     \
+        Type##Slot *slots = calloc(cap, sizeof(Type##Slot));                              \
+        if(!slots) return -1;                                                             \
+        Type##Slot *old = m->slots;                                                       \
+        size_t old_cap = m->cap;                                                          \
+        m->slots = slots;                                                                 \
+        m->cap = cap;                                                                     \
+        for(size_t j = 0; j < old_cap; j++)                                               \
+        {                                                                                 \
+            if(old[j].key == 0) continue;                                                 \
+            size_t i = prefix##_home_(m, old[j].key);                                     \
+            while(slots[i].key != 0) i = (i + 1) & (cap - 1);                             \
+            slots[i] = old[j];                                                            \
+        }                                                                                 \
+        free(old);                                                                        \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_init(Type *m, size_t capacity)                                           \
+    {                                                                                     \
+        memset(m, 0, sizeof(*m));                                                         \
+        m->seed = mathi_hash_seed();                                                      \
+        return capacity ? prefix##_reserve(m, capacity) : 0;                              \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_free(Type *m)                                                           \
+    {                                                                                     \
+        free(m->slots);                                                                   \
+        m->slots = NULL;                                                                  \
+        m->cap = m->size = 0;                                                             \
+        m->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_clear(Type *m)                                                          \
+    {                                                                                     \
+        if(m->slots) memset(m->slots, 0, m->cap * sizeof(Type##Slot));                   \
+        m->size = 0;                                                                      \
+        m->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_reserve(Type *m, size_t n)                                               \
+    {                                                                                     \
+        size_t cap = mathi_intmap_capacity_(n);                                           \
+        if(cap == 0) return -1;                                                           \
+        return cap > m->cap ? prefix##_rehash_(m, cap) : 0;                               \
+    }                                                                                     \
+                                                                                          \
+    V* prefix##_emplace(Type *m, K key, int *inserted)                                    \
+    {                                                                                     \
+        if(inserted) *inserted = 0;                                                       \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(!m->has_zero)                                                              \
+            {                                                                             \
+                memset(&m->zero_value, 0, sizeof(V));                                     \
+                m->has_zero = 1;                                                          \
+                m->size++;                                                                \
+                if(inserted) *inserted = 1;                                               \
+            }                                                                             \
+            return &m->zero_value;                                                        \
+        }                                                                                 \
+        size_t i = 0;                                                                     \
+        if(m->cap)                                                                        \
+        {                                                                                 \
+            for(i = prefix##_home_(m, key); m->slots[i].key != 0; i = (i + 1) & (m->cap - 1)) \
+                if(m->slots[i].key == key) return &m->slots[i].value;                     \
+        }                                                                                 \
+        if((m->size - m->has_zero + 1) * MATHI_INTMAP_LOAD_DEN > m->cap * MATHI_INTMAP_LOAD_NUM) \
+        {                                                                                 \
+            if(prefix##_rehash_(m, m->cap ? 2 * m->cap : MATHI_INTMAP_MIN_CAP) != 0) return NULL; \
+            for(i = prefix##_home_(m, key); m->slots[i].key != 0; i = (i + 1) & (m->cap - 1)) \
+                ;                                                                         \
+        }                                                                                 \
+        m->slots[i].key = key;                                                            \
+        memset(&m->slots[i].value, 0, sizeof(V));                                         \
+        m->size++;                                                                        \
+        if(inserted) *inserted = 1;                                                       \
+        return &m->slots[i].value;                                                        \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_put(Type *m, K key, V value)                                             \
+    {                                                                                     \
+        V *slot = prefix##_emplace(m, key, NULL);                                         \
+        if(!slot) return -1;                                                              \
+        *slot = value;                                                                    \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_get(const Type *m, K key, V *value)                                      \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(m->has_zero && value) *value = m->zero_value;                              \
+            return m->has_zero;                                                           \
+        }                                                                                 \
+        size_t i = prefix##_find_(m, key);                                                \
+        if(i == m->cap) return 0;                                                         \
+        if(value) *value = m->slots[i].value;                                             \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_remove(Type *m, K key, V *value)                                         \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(!m->has_zero) return 0;                                                    \
+            if(value) *value = m->zero_value;                                             \
+            m->has_zero = 0;                                                              \
+            m->size--;                                                                    \
+            return 1;                                                                     \
+        }                                                                                 \
+        size_t hole = prefix##_find_(m, key), mask = m->cap - 1;                          \
+        if(hole == m->cap) return 0;                                                      \
+        if(value) *value = m->slots[hole].value;                                          \
+        /* Shift back every later entry of the run whose home is not after the hole. */   \
+        for(size_t j = (hole + 1) & mask; m->slots[j].key != 0; j = (j + 1) & mask)       \
+        {                                                                                 \
+            size_t home = prefix##_home_(m, m->slots[j].key);                             \
+            if(((j - home) & mask) >= ((j - hole) & mask))                                \
+            {                                                                             \
+                m->slots[hole] = m->slots[j];                                             \
+                hole = j;                                                                 \
+            }                                                                             \
+        }                                                                                 \
+        m->slots[hole].key = 0;                                                           \
+        m->size--;                                                                        \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_size(const Type *m)                                                   \
+    {                                                                                     \
+        return m->size;                                                                   \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_next(const Type *m, size_t *iter, K *key, V *value)                      \
+    {                                                                                     \
+        while(*iter < m->cap)                                                             \
+        {                                                                                 \
+            size_t i = (*iter)++;                                                         \
+            if(m->slots[i].key == 0) continue;                                            \
+            if(key) *key = m->slots[i].key;                                               \
+            if(value) *value = m->slots[i].value;                                         \
+            return 1;                                                                     \
+        }                                                                                 \
+        /* Key 0 comes last, at position cap. */                                          \
+        if(*iter == m->cap && m->has_zero)                                                \
+        {                                                                                 \
+            (*iter)++;                                                                    \
+            if(key) *key = 0;                                                             \
+            if(value) *value = m->zero_value;                                             \
+            return 1;                                                                     \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_put_many(Type *m, const K *keys, const V *values, size_t n)              \
+    {                                                                                     \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && m->cap)                                   \
+                mathi_intmap_prefetch_(&m->slots[prefix##_home_(m, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            if(prefix##_put(m, keys[i], values[i]) != 0) return -1;                       \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_get_many(const Type *m, const K *keys, size_t n, V *values,           \
+                             unsigned char *found)                                        \
+    {                                                                                     \
+        size_t hits = 0;                                                                  \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && m->cap)                                   \
+                mathi_intmap_prefetch_(&m->slots[prefix##_home_(m, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            int hit = prefix##_get(m, keys[i], values ? &values[i] : NULL);               \
+            if(found) found[i] = (unsigned char)hit;                                      \
+            hits += (size_t)hit;                                                          \
+        }                                                                                 \
+        return hits;                                                                      \
+    }
+
+/* ----------------------------------------
+   Sets
+---------------------------------------- */
+
+/** @brief Declare set type Type of K (an integer type), and its prefix_* functions. */
+#define MATHI_INTSET_DECLARE(Type, prefix, K)                                             \
+    typedef struct Type {                                                                 \
+        K *slots;          /* cap slots; 0 marks an empty one */                          \
+        size_t cap;        /* power of two, or 0 before the first insert */               \
+        size_t size;       /* keys, including 0 */                                        \
+        uint64_t seed;                                                                    \
+        int has_zero;      /* key 0 is present */                                         \
+    } Type;                                                                               \
+    int prefix##_init(Type *s, size_t capacity);                                          \
+    void prefix##_free(Type *s);                                                          \
+    void prefix##_clear(Type *s);                                                         \
+    int prefix##_reserve(Type *s, size_t n);                                              \
+    int prefix##_add(Type *s, K key);                                                     \
+    int prefix##_contains(const Type *s, K key);                                          \
+    int prefix##_remove(Type *s, K key);                                                  \
+    size_t prefix##_size(const Type *s);                                                  \
+    int prefix##_next(const Type *s, size_t *iter, K *key);                               \
+    int prefix##_add_many(Type *s, const K *keys, size_t n, unsigned char *added);        \
+    size_t prefix##_contains_many(const Type *s, const K *keys, size_t n, unsigned char *found);
+
+/** @brief Define the functions declared by MATHI_INTSET_DECLARE (in exactly one source file). */
+#define MATHI_INTSET_DEFINE(Type, prefix, K)                                              \
+    static inline size_t prefix##_home_(const Type *s, K key)                             \
+    {                                                                                     \
+        return (size_t)mathi_intmap_hash_((uint64_t)key, s->seed) & (s->cap - 1);         \
+    }                                                                                     \
+                                                                                          \
+    static int prefix##_rehash_(Type *s, size_t cap)                                      \
+    {                                                                                     \
+        K *slots = calloc(cap, sizeof(K));                                                \
+        if(!slots) return -1;                                                             \
+        K *old = s->slots;                                                                \
+        size_t old_cap = s->cap;                                                          \
+        s->slots = slots;                                                                 \
+        s->cap = cap;                                                                     \
+        for(size_t j = 0; j < old_cap; j++)                                               \
+        {                                                                                 \
+            if(old[j] == 0) continue;                                                     \
+            size_t i = prefix##_home_(s, old[j]);                                         \
+            while(slots[i] != 0) i = (i + 1) & (cap - 1);                                 \
+            slots[i] = old[j];                                                            \
+        }                                                                                 \
+        free(old);                                                                        \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_init(Type *s, size_t capacity)                                           \
+    {                                                                                     \
+        memset(s, 0, sizeof(*s));                                                         \
+        s->seed = mathi_hash_seed();                                                      \
+        return capacity ? prefix##_reserve(s, capacity) : 0;                              \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_free(Type *s)                                                           \
+    {                                                                                     \
+        free(s->slots);                                                                   \
+        s->slots = NULL;                                                                  \
+        s->cap = s->size = 0;                                                             \
+        s->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    void prefix##_clear(Type *s)                                                          \
+    {                                                                                     \
+        if(s->slots) memset(s->slots, 0, s->cap * sizeof(K));                             \
+        s->size = 0;                                                                      \
+        s->has_zero = 0;                                                                  \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_reserve(Type *s, size_t n)                                               \
+    {                                                                                     \
+        size_t cap = mathi_intmap_capacity_(n);                                           \
+        if(cap == 0) return -1;                                                           \
+        return cap > s->cap ? prefix##_rehash_(s, cap) : 0;                               \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_add(Type *s, K key)                                                      \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(s->has_zero) return 0;                                                     \
+            s->has_zero = 1;                                                              \
+            s->size++;                                                                    \
+            return 1;                                                                     \
+        }                                                                                 \
+        size_t i = 0;                                                                     \
+        if(s->cap)                                                                        \
+        {                                                                                 \
+            for(i = prefix##_home_(s, key); s->slots[i] != 0; i = (i + 1) & (s->cap - 1)) \
+                if(s->slots[i] == key) return 0;                                          \
+        }                                                                                 \
+        if((s->size - s->has_zero + 1) * MATHI_INTMAP_LOAD_DEN > s->cap * MATHI_INTMAP_LOAD_NUM) \
+        {                                                                                 \
+            if(prefix##_rehash_(s, s->cap ? 2 * s->cap : MATHI_INTMAP_MIN_CAP) != 0) return -1; \
+            for(i = prefix##_home_(s, key); s->slots[i] != 0; i = (i + 1) & (s->cap - 1)) \
+                ;                                                                         \
+        }                                                                                 \
+        s->slots[i] = key;                                                                \
+        s->size++;                                                                        \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_contains(const Type *s, K key)                                           \
+    {                                                                                     \
+        if(key == 0) return s->has_zero;                                                  \
+        if(s->cap == 0) return 0;                                                         \
+        for(size_t i = prefix##_home_(s, key); s->slots[i] != 0; i = (i + 1) & (s->cap - 1)) \
+            if(s->slots[i] == key) return 1;                                              \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_remove(Type *s, K key)                                                   \
+    {                                                                                     \
+        if(key == 0)                                                                      \
+        {                                                                                 \
+            if(!s->has_zero) return 0;                                                    \
+            s->has_zero = 0;                                                              \
+            s->size--;                                                                    \
+            return 1;                                                                     \
+        }                                                                                 \
+        if(s->cap == 0) return 0;                                                         \
+        size_t mask = s->cap - 1, hole = prefix##_home_(s, key);                          \
+        for(; s->slots[hole] != key; hole = (hole + 1) & mask)                            \
+            if(s->slots[hole] == 0) return 0;                                             \
+        /* Shift back every later key of the run whose home is not after the hole. */     \
+        for(size_t j = (hole + 1) & mask; s->slots[j] != 0; j = (j + 1) & mask)           \
+        {                                                                                 \
+            size_t home = prefix##_home_(s, s->slots[j]);                                 \
+            if(((j - home) & mask) >= ((j - hole) & mask))                                \
+            {                                                                             \
+                s->slots[hole] = s->slots[j];                                             \
+                hole = j;                                                                 \
+            }                                                                             \
+        }                                                                                 \
+        s->slots[hole] = 0;                                                               \
+        s->size--;                                                                        \
+        return 1;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_size(const Type *s)                                                   \
+    {                                                                                     \
+        return s->size;                                                                   \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_next(const Type *s, size_t *iter, K *key)                                \
+    {                                                                                     \
+        while(*iter < s->cap)                                                             \
+        {                                                                                 \
+            size_t i = (*iter)++;                                                         \
+            if(s->slots[i] == 0) continue;                                                \
+            if(key) *key = s->slots[i];                                                   \
+            return 1;                                                                     \
+        }                                                                                 \
+        /* Key 0 comes last, at position cap. */                                          \
+        if(*iter == s->cap && s->has_zero)                                                \
+        {                                                                                 \
+            (*iter)++;                                                                    \
+            if(key) *key = 0;                                                             \
+            return 1;                                                                     \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    int prefix##_add_many(Type *s, const K *keys, size_t n, unsigned char *added)         \
+    {                                                                                     \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && s->cap)                                   \
+                mathi_intmap_prefetch_(&s->slots[prefix##_home_(s, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            int r = prefix##_add(s, keys[i]);                                             \
+            if(r < 0) return -1;                                                          \
+            if(added) added[i] = (unsigned char)r;                                        \
+        }                                                                                 \
+        return 0;                                                                         \
+    }                                                                                     \
+                                                                                          \
+    size_t prefix##_contains_many(const Type *s, const K *keys, size_t n, unsigned char *found) \
+    {                                                                                     \
+        size_t hits = 0;                                                                  \
+        for(size_t i = 0; i < n; i++)                                                     \
+        {                                                                                 \
+            if(i + MATHI_INTMAP_PREFETCH < n && s->cap)                                   \
+                mathi_intmap_prefetch_(&s->slots[prefix##_home_(s, keys[i + MATHI_INTMAP_PREFETCH])]); \
+            int hit = prefix##_contains(s, keys[i]);                                      \
+            if(found) found[i] = (unsigned char)hit;                                      \
+            hits += (size_t)hit;                                                          \
+        }                                                                                 \
+        return hits;                                                                      \
+    }
+
+/* ----------------------------------------
+   Instances built into the library
+---------------------------------------- */
+
+/** @brief int32_t -> int64_t map (mathi_i32map_*). */
+MATHI_INTMAP_DECLARE(MathiI32Map, mathi_i32map, int32_t, int64_t)
+
+/** @brief int64_t -> int64_t map (mathi_i64map_*). */
+MATHI_INTMAP_DECLARE(MathiI64Map, mathi_i64map, int64_t, int64_t)
+
+/** @brief Set of int32_t (mathi_i32set_*). */
+MATHI_INTSET_DECLARE(MathiI32Set, mathi_i32set, int32_t)
+
+/** @brief Set of int64_t (mathi_i64set_*). */
+MATHI_INTSET_DECLARE(MathiI64Set, mathi_i64set, int64_t)
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+
 // --- logx.h ---
 /* Status codes */
 #define LOG_SUCCESS   0
@@ -1082,10 +1989,15 @@ struct MathiJSON {
             char **keys;        /**< Array of keys */
             MathiJSON **values; /**< Array of corresponding values */
             size_t count;       /**< Number of key-value pairs */
+            size_t capacity;    /**< Allocated slots in keys and values */
+            size_t *index;      /**< Hash index of key positions + 1, 0 = free (NULL for small objects) */
+            size_t index_cap;   /**< Slots in index (a power of two) */
+            uint64_t seed;      /**< Hash seed of the index */
         } object;
         struct {           /**< JSON array */
             MathiJSON **items; /**< Array of items */
             size_t count;      /**< Number of items */
+            size_t capacity;   /**< Allocated slots in items */
         } array;
         char *str;         /**< JSON string value */
         double num;        /**< JSON numeric value */
@@ -1732,43 +2644,375 @@ void mathi_prnt_mem(const char *label, char *mem, size_t n);
 
 
 
-// --- search.h ---
+// --- prng.h ---
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
- * @brief Perform linear search on an array.
- * @param arr Pointer to the integer array
- * @param n Number of elements in the array
- * @param key Value to search for
- * @return Index of key if found, -1 otherwise
+ * @brief xoshiro256** state (period 2^256 - 1; must not be all zero).
  */
-int mathi_linear_search(int *arr, int n, int key);
+typedef struct MathiXoshiro256 {
+    uint64_t s[4];
+} MathiXoshiro256;
 
 /**
- * @brief Perform binary search on a sorted array.
- * @param arr Pointer to sorted integer array
- * @param n Number of elements in the array
- * @param key Value to search for
- * @return Index of key if found, -1 otherwise
+ * @brief PCG64 (XSL-RR 128/64) state: 128-bit LCG state and odd increment.
  */
-int mathi_binary_search(int *arr, int n, int key);
+typedef struct MathiPcg64 {
+    uint64_t state_hi, state_lo;
+    uint64_t inc_hi, inc_lo;
+} MathiPcg64;
 
 /**
- * @brief Perform jump search on a sorted array.
- * @param arr Pointer to sorted integer array
- * @param n Number of elements in the array
- * @param key Value to search for
- * @return Index of key if found, -1 otherwise
+ * @brief Seed a xoshiro256** generator by expanding seed with splitmix64
+ * @param rng Generator to initialise
+ * @param seed Any 64-bit value
  */
-int mathi_jump_search(int *arr, int n, int key);
+void mathi_xoshiro256_seed(MathiXoshiro256 *rng, uint64_t seed);
 
 /**
- * @brief Perform interpolation search on a sorted array.
- * @param arr Pointer to sorted integer array
- * @param n Number of elements in the array
- * @param key Value to search for
- * @return Index of key if found, -1 otherwise
+ * @brief Next 64-bit output of a xoshiro256** generator
+ * @param rng Generator state
+ * @return Uniform 64-bit value
  */
-int mathi_interpolation_search(int *arr, int n, int key);
-
+uint64_t mathi_xoshiro256_next(MathiXoshiro256 *rng);
+
+/**
+ * @brief Advance a xoshiro256** generator by 2^128 steps
+ *
+ * Jumping a copy k times yields up to 2^128 non-overlapping streams of
+ * 2^128 outputs each, e.g. one per thread.
+ *
+ * @param rng Generator state
+ */
+void mathi_xoshiro256_jump(MathiXoshiro256 *rng);
+
+/**
+ * @brief Advance a xoshiro256** generator by 2^192 steps
+ * @param rng Generator state
+ */
+void mathi_xoshiro256_long_jump(MathiXoshiro256 *rng);
+
+/**
+ * @brief Unbiased integer in [0, bound) (Lemire's multiply-shift rejection)
+ * @param rng Generator state
+ * @param bound Exclusive upper bound; 0 returns 0
+ * @return Uniform value below bound
+ */
+uint64_t mathi_xoshiro256_bounded(MathiXoshiro256 *rng, uint64_t bound);
+
+/**
+ * @brief Uniform double in [0, 1) with 53 random bits
+ * @param rng Generator state
+ * @return Value in [0, 1)
+ */
+double mathi_xoshiro256_double(MathiXoshiro256 *rng);
+
+/**
+ * @brief Seed a PCG64 generator (same scheme as the reference pcg64_srandom_r)
+ * @param rng Generator to initialise
+ * @param seed Initial state
+ * @param stream Stream selector; different streams give independent sequences
+ */
+void mathi_pcg64_seed(MathiPcg64 *rng, uint64_t seed, uint64_t stream);
+
+/**
+ * @brief Next 64-bit output of a PCG64 generator
+ * @param rng Generator state
+ * @return Uniform 64-bit value
+ */
+uint64_t mathi_pcg64_next(MathiPcg64 *rng);
+
+/**
+ * @brief Advance a PCG64 generator by delta steps in O(log delta)
+ * @param rng Generator state
+ * @param delta Number of outputs to skip
+ */
+void mathi_pcg64_advance(MathiPcg64 *rng, uint64_t delta);
+
+/**
+ * @brief Advance a PCG64 generator by 2^64 steps
+ * @param rng Generator state
+ */
+void mathi_pcg64_jump(MathiPcg64 *rng);
+
+/**
+ * @brief Unbiased integer in [0, bound) (Lemire's multiply-shift rejection)
+ * @param rng Generator state
+ * @param bound Exclusive upper bound; 0 returns 0
+ * @return Uniform value below bound
+ */
+uint64_t mathi_pcg64_bounded(MathiPcg64 *rng, uint64_t bound);
+
+/**
+ * @brief Uniform double in [0, 1) with 53 random bits
+ * @param rng Generator state
+ * @return Value in [0, 1)
+ */
+double mathi_pcg64_double(MathiPcg64 *rng);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+
+
+// --- search.h ---
+/**
+ * @brief Perform linear search on an array.
+ * @param arr Pointer to the integer array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Index of key if found, -1 otherwise
+ */
+int mathi_linear_search(const int *arr, size_t n, int key);
+
+/**
+ * @brief Perform binary search on a sorted array.
+ * @param arr Pointer to sorted integer array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Index of key if found, -1 otherwise
+ */
+int mathi_binary_search(int *arr, int n, int key);
+
+/**
+ * @brief Perform jump search on a sorted array.
+ * @param arr Pointer to sorted integer array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Index of key if found, -1 otherwise
+ */
+int mathi_jump_search(int *arr, int n, int key);
+
+/**
+ * @brief Perform interpolation search on a sorted array.
+ * @param arr Pointer to sorted integer array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Index of key if found, -1 otherwise
+ */
+int mathi_interpolation_search(int *arr, int n, int key);
+
+/**
+ * @brief Static search index over a sorted int array (Eytzinger layout).
+ */
+typedef struct {
+    int *keys;      ///< keys in Eytzinger order, 1-based, cache-line aligned
+    uint32_t *rank; ///< rank[k] = position of keys[k] in the original array
+    size_t n;       ///< number of keys
+} MathiSearchIndex;
+
+/**
+ * @brief Build a search index from a sorted array
+ * @param sorted Pointer to sorted integer array (copied, not retained)
+ * @param n Number of elements in the array
+ * @return New index, or NULL on failure
+ */
+MathiSearchIndex* mathi_search_index_build(const int *sorted, size_t n);
+
+/**
+ * @brief Find a key through a search index
+ * @param idx Search index
+ * @param key Value to search for
+ * @return Position of the first occurrence in the original array, -1 if absent
+ */
+ptrdiff_t mathi_search_index_find(const MathiSearchIndex *idx, int key);
+
+/**
+ * @brief Position of the first element >= key in the original array
+ * @param idx Search index
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_search_index_lower_bound(const MathiSearchIndex *idx, int key);
+
+/**
+ * @brief Free a search index
+ * @param idx Search index
+ */
+void mathi_search_index_free(MathiSearchIndex *idx);
+
+/**
+ * @brief Look up many keys in one sorted array with interleaved, prefetched probes
+ * @param arr Pointer to sorted integer array
+ * @param n Number of elements in the array
+ * @param keys Keys to look up
+ * @param m Number of keys
+ * @param out Output: position of the first occurrence of each key, or -1
+ */
+void mathi_binary_search_batch(const int *arr, size_t n, const int *keys, size_t m, ptrdiff_t *out);
+
+/**
+ * @brief Multithreaded mathi_binary_search_batch (splits the keys across threads)
+ * @param arr Pointer to sorted integer array
+ * @param n Number of elements in the array
+ * @param keys Keys to look up
+ * @param m Number of keys
+ * @param out Output: position of the first occurrence of each key, or -1
+ * @param threads Number of threads (<= 0 uses all online CPUs)
+ */
+void mathi_binary_search_batch_mt(const int *arr, size_t n, const int *keys, size_t m, ptrdiff_t *out, int threads);
+
+/**
+ * @brief First position whose value is not less than key (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_lower_bound_i32(const int32_t *arr, size_t n, int32_t key);
+
+/**
+ * @brief First position whose value is greater than key (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_upper_bound_i32(const int32_t *arr, size_t n, int32_t key);
+
+/**
+ * @brief Range [first, last) of elements equal to key (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @param first Output: lower bound
+ * @param last Output: upper bound
+ */
+void mathi_equal_range_i32(const int32_t *arr, size_t n, int32_t key, size_t *first, size_t *last);
+
+/**
+ * @brief Number of elements in [lo, hi) (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param lo Inclusive lower value
+ * @param hi Exclusive upper value
+ * @return Count of elements v with lo <= v < hi
+ */
+size_t mathi_count_range_i32(const int32_t *arr, size_t n, int32_t lo, int32_t hi);
+
+/**
+ * @brief mathi_lower_bound_i32 for int64_t arrays
+ */
+size_t mathi_lower_bound_i64(const int64_t *arr, size_t n, int64_t key);
+
+/**
+ * @brief mathi_upper_bound_i32 for int64_t arrays
+ */
+size_t mathi_upper_bound_i64(const int64_t *arr, size_t n, int64_t key);
+
+/**
+ * @brief mathi_equal_range_i32 for int64_t arrays
+ */
+void mathi_equal_range_i64(const int64_t *arr, size_t n, int64_t key, size_t *first, size_t *last);
+
+/**
+ * @brief mathi_count_range_i32 for int64_t arrays
+ */
+size_t mathi_count_range_i64(const int64_t *arr, size_t n, int64_t lo, int64_t hi);
+
+/**
+ * @brief mathi_lower_bound_i32 for double arrays (NaNs sort last, as in mathi_sort_f64)
+ */
+size_t mathi_lower_bound_f64(const double *arr, size_t n, double key);
+
+/**
+ * @brief mathi_upper_bound_i32 for double arrays (NaNs sort last)
+ */
+size_t mathi_upper_bound_f64(const double *arr, size_t n, double key);
+
+/**
+ * @brief mathi_equal_range_i32 for double arrays (NaNs sort last)
+ */
+void mathi_equal_range_f64(const double *arr, size_t n, double key, size_t *first, size_t *last);
+
+/**
+ * @brief mathi_count_range_i32 for double arrays (NaNs sort last)
+ */
+size_t mathi_count_range_f64(const double *arr, size_t n, double lo, double hi);
+
+/**
+ * @brief Static learned index: piecewise-linear model of key -> position with error bound eps.
+ */
+typedef struct {
+    int64_t *seg_key;  ///< first key of each segment (ascending)
+    double *seg_slope; ///< positions per key unit in each segment
+    double *seg_pos;   ///< position of each segment's first key
+    size_t nseg;       ///< number of segments
+    size_t n;          ///< number of keys in the indexed array
+    size_t eps;        ///< maximum prediction error, in positions
+    int key_size;      ///< sizeof the key type it was built for
+    uint32_t *radix;   ///< radix table over segment key prefixes (rebuilt on load)
+    size_t radix_size; ///< entries in the radix table
+    int radix_shift;   ///< key offset shift selecting the prefix
+} MathiLearnedIndex;
+
+/**
+ * @brief Fit a learned index over a sorted int32_t array
+ * @param sorted Pointer to sorted array (not retained; pass it again to lookups)
+ * @param n Number of elements in the array
+ * @param eps Maximum prediction error in positions (larger = fewer segments)
+ * @return New index, or NULL on allocation failure
+ */
+MathiLearnedIndex* mathi_learned_index_build_i32(const int32_t *sorted, size_t n, size_t eps);
+
+/**
+ * @brief First position whose value is not less than key, via a learned index
+ * @param idx Learned index built over arr
+ * @param arr The sorted array the index was built over
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_learned_index_lower_bound_i32(const MathiLearnedIndex *idx, const int32_t *arr, int32_t key);
+
+/**
+ * @brief Find a key via a learned index
+ * @param idx Learned index built over arr
+ * @param arr The sorted array the index was built over
+ * @param key Value to search for
+ * @return Position of the first occurrence, -1 if absent
+ */
+ptrdiff_t mathi_learned_index_find_i32(const MathiLearnedIndex *idx, const int32_t *arr, int32_t key);
+
+/**
+ * @brief mathi_learned_index_build_i32 for int64_t arrays
+ */
+MathiLearnedIndex* mathi_learned_index_build_i64(const int64_t *sorted, size_t n, size_t eps);
+
+/**
+ * @brief mathi_learned_index_lower_bound_i32 for int64_t arrays
+ */
+size_t mathi_learned_index_lower_bound_i64(const MathiLearnedIndex *idx, const int64_t *arr, int64_t key);
+
+/**
+ * @brief mathi_learned_index_find_i32 for int64_t arrays
+ */
+ptrdiff_t mathi_learned_index_find_i64(const MathiLearnedIndex *idx, const int64_t *arr, int64_t key);
+
+/**
+ * @brief Save a learned index to disk (the keys are not stored)
+ * @param idx Learned index
+ * @param path Output file path
+ * @return 0 on success, -1 on failure
+ */
+int mathi_learned_index_save(const MathiLearnedIndex *idx, const char *path);
+
+/**
+ * @brief Load a learned index saved by mathi_learned_index_save
+ * @param path Input file path
+ * @return Loaded index, or NULL on failure
+ */
+MathiLearnedIndex* mathi_learned_index_load(const char *path);
+
+/**
+ * @brief Free a learned index
+ * @param idx Learned index
+ */
+void mathi_learned_index_free(MathiLearnedIndex *idx);
+
 
 
 
@@ -1813,12 +3057,20 @@ void mathi_insertion_sort(int *arr, int n);
 void mathi_merge_sort(int *arr, int n);
 
 /**
- * @brief Quick Sort
+ * @brief Quick Sort (runs on the Introsort engine)
  * @param arr Pointer to the array
  * @param n Number of elements in the array
  */
 void mathi_quick_sort(int *arr, int n);
 
+/**
+ * @brief Introsort: ninther pivots, three-way partitioning, insertion-sort
+ *        leaves and a heap sort fallback past 2*log2(n) depth
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_intro_sort(int *arr, int n);
+
 /**
  * @brief Heap Sort
  * @param arr Pointer to the array
@@ -1834,6 +3086,227 @@ void mathi_heap_sort(int *arr, int n);
  */
 void mathi_counting_sort(int *arr, int n, int max);
 
+/**
+ * @brief Radix Sort (LSD, four 8-bit passes, full signed 32-bit range)
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_radix_sort(int *arr, int n);
+
+/**
+ * @brief Radix Sort using a caller-supplied scratch buffer
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param scratch Buffer of at least n ints, overwritten during the sort
+ */
+void mathi_radix_sort_buf(int *arr, int n, int *scratch);
+
+/**
+ * @brief Parallel stable Merge Sort on a pthread worker pool
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param threads Number of threads (<= 0 uses all online CPUs)
+ */
+void mathi_parallel_sort(int *arr, int n, int threads);
+
+/**
+ * @brief Adaptive stable natural-run Merge Sort (Timsort), O(n) on sorted input
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_tim_sort(int *arr, int n);
+
+/**
+ * @brief Key types understood by mathi_sort_records.
+ */
+typedef enum {
+    MATHI_KEY_I32, ///< int32_t key
+    MATHI_KEY_U32, ///< uint32_t key
+    MATHI_KEY_I64, ///< int64_t key
+    MATHI_KEY_U64, ///< uint64_t key
+    MATHI_KEY_F32, ///< float key (NaNs sort last)
+    MATHI_KEY_F64  ///< double key (NaNs sort last)
+} MathiSortKey;
+
+/**
+ * @brief Introsort for int32_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_i32(int32_t *arr, size_t n);
+
+/**
+ * @brief Introsort for uint32_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_u32(uint32_t *arr, size_t n);
+
+/**
+ * @brief Introsort for int64_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_i64(int64_t *arr, size_t n);
+
+/**
+ * @brief Introsort for uint64_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_u64(uint64_t *arr, size_t n);
+
+/**
+ * @brief Introsort for float arrays; NaNs are ordered after every number
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_f32(float *arr, size_t n);
+
+/**
+ * @brief Introsort for double arrays; NaNs are ordered after every number
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_f64(double *arr, size_t n);
+
+/**
+ * @brief Sort fixed-size records by a numeric key stored at a byte offset
+ * @param base Pointer to the first record
+ * @param n Number of records
+ * @param size Size of each record in bytes
+ * @param key_offset Byte offset of the key inside a record (e.g. offsetof)
+ * @param key Type of the key
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mathi_sort_records(void *base, size_t n, size_t size, size_t key_offset, MathiSortKey key);
+
+/**
+ * @brief Sort a small array (up to 64 elements) with an AVX2 sorting network,
+ *        falling back to insertion sort without AVX2 and Introsort above 64
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_small(int *arr, int n);
+
+/**
+ * @brief Float variant of mathi_sort_small; blocks containing NaN use the scalar path
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_small_f32(float *arr, int n);
+
+/**
+ * @brief Stable sort of keys that applies the same reordering to a value array
+ * @param keys Pointer to the key array
+ * @param vals Pointer to the value array (reordered with keys)
+ * @param n Number of elements
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_sort_pairs(int *keys, int *vals, int n);
+
+/**
+ * @brief Stable argsort: fill idx with the permutation that sorts keys
+ * @param keys Pointer to the key array (not modified)
+ * @param n Number of elements
+ * @param idx Output array of n indices
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_argsort(const int *keys, int n, int *idx);
+
+/**
+ * @brief Gather one column through an index list: dst[i] = src[idx[i]]
+ * @param idx Index list of length n
+ * @param n Number of elements
+ * @param src Source column
+ * @param dst Destination column (must not overlap src)
+ * @param size Element size in bytes
+ */
+void mathi_gather(const int *idx, int n, const void *src, void *dst, size_t size);
+
+/**
+ * @brief Apply one index list to several columns in cache-sized blocks
+ * @param idx Index list of length n
+ * @param n Number of rows
+ * @param src Array of ncols source columns
+ * @param dst Array of ncols destination columns
+ * @param sizes Element size in bytes of each column
+ * @param ncols Number of columns
+ */
+void mathi_gather_columns(const int *idx, int n, const void *const *src, void *const *dst,
+                          const size_t *sizes, int ncols);
+
+/**
+ * @brief Sort a binary file of ints that may not fit in memory
+ * @param in_path Path of the input file (native-endian ints)
+ * @param out_path Path of the sorted output file (may equal in_path)
+ * @param mem_budget Approximate working memory in bytes
+ * @return 0 on success, -1 on failure
+ */
+int mathi_external_sort(const char *in_path, const char *out_path, size_t mem_budget);
+
+/**
+ * @brief Reorder arr so arr[k] holds its sorted value, smaller values before it
+ *        and larger after (introselect, O(n))
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param k Position to settle (0 <= k < n)
+ */
+void mathi_nth_element(int *arr, int n, int k);
+
+/**
+ * @brief Sort the k smallest values into arr[0..k), rest in unspecified order
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param k Number of smallest values to sort
+ */
+void mathi_partial_sort(int *arr, int n, int k);
+
+/**
+ * @brief Streaming tracker of the k largest values seen (bounded min-heap).
+ */
+typedef struct {
+    int *heap; ///< min-heap of the current top values
+    int size;  ///< values currently held
+    int k;     ///< capacity
+} MathiTopK;
+
+/**
+ * @brief Create a top-k tracker
+ * @param k Number of largest values to keep
+ * @return New tracker, or NULL on failure
+ */
+MathiTopK* mathi_topk_new(int k);
+
+/**
+ * @brief Offer one value to a top-k tracker
+ * @param t Tracker
+ * @param v Value
+ */
+void mathi_topk_push(MathiTopK *t, int v);
+
+/**
+ * @brief Offer a batch of values to a top-k tracker
+ * @param t Tracker
+ * @param arr Values
+ * @param n Number of values
+ */
+void mathi_topk_push_array(MathiTopK *t, const int *arr, int n);
+
+/**
+ * @brief Copy out the current top values, largest first
+ * @param t Tracker
+ * @param out Output array with room for k values
+ * @return Number of values written
+ */
+int mathi_topk_result(const MathiTopK *t, int *out);
+
+/**
+ * @brief Free a top-k tracker
+ * @param t Tracker
+ */
+void mathi_topk_free(MathiTopK *t);
+
 
 
 
@@ -1885,7 +3358,7 @@ double mathi_stddev(int *arr, int n);
  * @brief Compute the mode (most frequent value) of an array
  * @param arr Pointer to the integer array
  * @param n Number of elements in the array
- * @return Mode as integer
+ * @return Mode as integer; the smallest value on ties, 0 if n <= 0
  */
 int mathi_mode(int *arr, int n);
 
@@ -1933,6 +3406,12 @@ char* mathi_get_env(const char *name);
  */
 int mathi_set_env(const char *name, const char *value, int overwrite);
 
+/**
+ * @brief Check whether the running CPU supports AVX2
+ * @return 1 if supported, 0 otherwise (always 0 on non-x86 targets)
+ */
+int mathi_cpu_has_avx2(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2161,4 +3640,191 @@ int mathi_in_range(int value, int min, int max);
 }
 #endif
 
+
+
+// --- vec.h ---
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Allocator interface used by vectors (and anything else that takes one).
+ *
+ * Sizes of the previous allocation are passed back to realloc and free so
+ * that allocators such as arenas need not store them. A NULL allocator
+ * pointer means malloc/realloc/free.
+ */
+typedef struct MathiAllocator {
+    void *(*alloc)(void *ctx, size_t size);                                   ///< Allocate size bytes
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size); ///< Resize ptr
+    void (*free)(void *ctx, void *ptr, size_t size);                         ///< Release ptr
+    void *ctx;                                                                ///< Passed to every callback
+} MathiAllocator;
+
+/**
+ * @brief Bump allocator over a chain of chunks; everything is released at once.
+ */
+typedef struct MathiArena MathiArena;
+
+/**
+ * @brief Create an arena.
+ * @param chunk_size Bytes per chunk (0 uses 64 KiB); larger requests get their own chunk
+ * @return New arena, or NULL on allocation failure
+ */
+MathiArena* mathi_arena_new(size_t chunk_size);
+
+/**
+ * @brief Allocate size bytes, 16-byte aligned, from an arena.
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return Pointer valid until the arena is reset or freed, or NULL on failure
+ */
+void* mathi_arena_alloc(MathiArena *arena, size_t size);
+
+/**
+ * @brief Release every allocation but keep the first chunk for reuse.
+ * @param arena Arena to reset
+ */
+void mathi_arena_reset(MathiArena *arena);
+
+/**
+ * @brief Free an arena and all memory allocated from it.
+ * @param arena Arena to free (may be NULL)
+ */
+void mathi_arena_free(MathiArena *arena);
+
+/**
+ * @brief Allocator that draws from an arena.
+ *
+ * The most recent allocation is grown or released in place; any other free
+ * is a no-op until the arena is reset.
+ *
+ * @param arena Arena backing the allocator
+ * @return Allocator whose ctx is arena
+ */
+MathiAllocator mathi_arena_allocator(MathiArena *arena);
+
+/**
+ * @brief Type-erased growth step behind the vector macros.
+ *
+ * Ensures *data can hold need elements of elem_size bytes, growing the
+ * capacity geometrically (doubling). While *data is inline_buf the
+ * contents are copied out to the heap.
+ *
+ * @param data Address of the vector's element pointer (any T **)
+ * @param len Elements currently in use (copied when moving out of inline_buf)
+ * @param cap Pointer to the capacity in elements
+ * @param need Required capacity in elements
+ * @param elem_size Size of one element
+ * @param inline_buf Inline storage of the vector, or NULL
+ * @param alloc Allocator, or NULL for malloc
+ * @return 0 on success, -1 on overflow or allocation failure (vector unchanged)
+ */
+int mathi_vec_reserve_raw(void *data, size_t len, size_t *cap, size_t need, size_t elem_size,
+                          void *inline_buf, const MathiAllocator *alloc);
+
+/**
+ * @brief Type-erased shrink: moves the elements back inline when they fit,
+ *        otherwise trims the heap buffer to len elements.
+ * @return 0 on success, -1 on allocation failure (vector unchanged)
+ */
+int mathi_vec_shrink_raw(void *data, size_t len, size_t *cap, size_t elem_size, void *inline_buf,
+                         size_t inline_cap, const MathiAllocator *alloc);
+
+/**
+ * @brief Release the heap buffer of a vector (no-op while it is inline).
+ */
+void mathi_vec_free_raw(void *data, size_t cap, size_t elem_size, const void *inline_buf,
+                        const MathiAllocator *alloc);
+
+/* ----------------------------------------
+   Vector types
+---------------------------------------- */
+
+/** @brief Vector of T whose first N elements live inside the struct (no heap allocation). */
+#define MATHI_SMALL_VEC(T, N)                                                   \
+    struct {                                                                    \
+        T *data;                     /* elements; inline_buf while they fit */  \
+        size_t len;                  /* elements in use */                      \
+        size_t cap;                  /* capacity of data, in elements */        \
+        const MathiAllocator *alloc; /* NULL for malloc */                      \
+        T inline_buf[N];                                                        \
+    }
+
+/** @brief Heap-only vector of T (a zero-length inline buffer). */
+#define MATHI_VEC(T) MATHI_SMALL_VEC(T, 0)
+
+/* Inline storage of a vector and its capacity in elements; NULL/0 for MATHI_VEC. */
+#define mathi_vec_inline_(v) (sizeof((v)->inline_buf) ? (void *)(v)->inline_buf : NULL)
+#define mathi_vec_inline_cap_(v) (sizeof((v)->inline_buf) / sizeof(*(v)->data))
+
+/* ----------------------------------------
+   Vector operations
+---------------------------------------- */
+
+/** @brief Initialise an empty vector using allocator a (NULL for malloc). */
+#define mathi_vec_init_alloc(v, a)                                                         \
+    ((v)->len = 0, (v)->alloc = (a),                                                        \
+     (v)->cap = mathi_vec_inline_cap_(v),                                                   \
+     (v)->data = (void *)mathi_vec_inline_(v))
+
+/** @brief Initialise an empty vector backed by malloc. */
+#define mathi_vec_init(v) mathi_vec_init_alloc(v, NULL)
+
+/** @brief Free the vector's heap storage and leave it empty (and reusable). */
+#define mathi_vec_free(v)                                                                  \
+    (mathi_vec_free_raw((v)->data, (v)->cap, sizeof(*(v)->data), mathi_vec_inline_(v),     \
+                        (v)->alloc),                                                       \
+     mathi_vec_init_alloc(v, (v)->alloc))
+
+/** @brief Make room for at least n elements. @return 0, or -1 on failure. */
+#define mathi_vec_reserve(v, n)                                                            \
+    ((n) <= (v)->cap ? 0 : mathi_vec_reserve_raw(&(v)->data, (v)->len, &(v)->cap, \
+                                                 (n), sizeof(*(v)->data),                  \
+                                                 mathi_vec_inline_(v), (v)->alloc))
+
+/** @brief Append x. @return 0, or -1 on allocation failure. */
+#define mathi_vec_push(v, x)                                                               \
+    (mathi_vec_reserve(v, (v)->len + 1) == 0 ? ((v)->data[(v)->len++] = (x), 0) : -1)
+
+/** @brief Append n elements copied from src with one memcpy. @return 0, or -1 on failure. */
+#define mathi_vec_extend(v, src, n)                                                        \
+    ((size_t)(n) > (size_t)-1 - (v)->len ? -1 :                                             \
+     mathi_vec_reserve(v, (v)->len + (n)) == 0                                             \
+         ? (memcpy((v)->data + (v)->len, (src), (n) * sizeof(*(v)->data)), (v)->len += (n), 0) \
+         : -1)
+
+/** @brief Set the length to n; new elements are zero-filled. @return 0, or -1 on failure. */
+#define mathi_vec_resize(v, n)                                                             \
+    (mathi_vec_reserve(v, n) == 0                                                          \
+         ? ((n) > (v)->len ? (void)memset((v)->data + (v)->len, 0,                           \
+                                          ((n) - (v)->len) * sizeof(*(v)->data))            \
+                           : (void)0,                                                      \
+            (v)->len = (n), 0)                                                             \
+         : -1)
+
+/** @brief Trim capacity to the length (back into inline storage if it fits). @return 0 or -1. */
+#define mathi_vec_shrink_to_fit(v)                                                         \
+    mathi_vec_shrink_raw(&(v)->data, (v)->len, &(v)->cap, sizeof(*(v)->data),     \
+                         mathi_vec_inline_(v), mathi_vec_inline_cap_(v), (v)->alloc)
+
+/** @brief Remove and return the last element (the vector must not be empty). */
+#define mathi_vec_pop(v) ((v)->data[--(v)->len])
+
+/** @brief Element i (unchecked), usable as an lvalue. */
+#define mathi_vec_at(v, i) ((v)->data[i])
+
+/** @brief Last element (the vector must not be empty). */
+#define mathi_vec_last(v) ((v)->data[(v)->len - 1])
+
+/** @brief Number of elements. */
+#define mathi_vec_len(v) ((v)->len)
+
+/** @brief Remove all elements, keeping the capacity. */
+#define mathi_vec_clear(v) ((void)((v)->len = 0))
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif // MATHI_H
\ No newline at end of file
@@ -13,6 +13,7 @@
 #define MATHI_MATHISON_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 /**
@@ -41,10 +42,15 @@ struct MathiJSON {
             char **keys;        /**< Array of keys */
             MathiJSON **values; /**< Array of corresponding values */
             size_t count;       /**< Number of key-value pairs */
+            size_t capacity;    /**< Allocated slots in keys and values */
+            size_t *index;      /**< Hash index of key positions + 1, 0 = free (NULL for small objects) */
+            size_t index_cap;   /**< Slots in index (a power of two) */
+            uint64_t seed;      /**< Hash seed of the index */
         } object;
         struct {           /**< JSON array */
             MathiJSON **items; /**< Array of items */
             size_t count;      /**< Number of items */
+            size_t capacity;   /**< Allocated slots in items */
         } array;
         char *str;         /**< JSON string value */
         double num;        /**< JSON numeric value */
@@ -0,0 +1,131 @@
+/*
+ * Mathi C Library - Pseudo-Random Number Generators
+ * prng.h
+ *
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#ifndef MATHI_PRNG_H
+#define MATHI_PRNG_H
+
+#include <stdint.h>
+
+/**
+ * @file mathi/prng.h
+ * @brief Seedable xoshiro256** and PCG64 generators with explicit state,
+ *        jump-ahead for independent streams and unbiased bounded integers.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief xoshiro256** state (period 2^256 - 1; must not be all zero).
+ */
+typedef struct MathiXoshiro256 {
+    uint64_t s[4];
+} MathiXoshiro256;
+
+/**
+ * @brief PCG64 (XSL-RR 128/64) state: 128-bit LCG state and odd increment.
+ */
+typedef struct MathiPcg64 {
+    uint64_t state_hi, state_lo;
+    uint64_t inc_hi, inc_lo;
+} MathiPcg64;
+
+/**
+ * @brief Seed a xoshiro256** generator by expanding seed with splitmix64
+ * @param rng Generator to initialise
+ * @param seed Any 64-bit value
+ */
+void mathi_xoshiro256_seed(MathiXoshiro256 *rng, uint64_t seed);
+
+/**
+ * @brief Next 64-bit output of a xoshiro256** generator
+ * @param rng Generator state
+ * @return Uniform 64-bit value
+ */
+uint64_t mathi_xoshiro256_next(MathiXoshiro256 *rng);
+
+/**
+ * @brief Advance a xoshiro256** generator by 2^128 steps
+ *
+ * Jumping a copy k times yields up to 2^128 non-overlapping streams of
+ * 2^128 outputs each, e.g. one per thread.
+ *
+ * @param rng Generator state
+ */
+void mathi_xoshiro256_jump(MathiXoshiro256 *rng);
+
+/**
+ * @brief Advance a xoshiro256** generator by 2^192 steps
+ * @param rng Generator state
+ */
+void mathi_xoshiro256_long_jump(MathiXoshiro256 *rng);
+
+/**
+ * @brief Unbiased integer in [0, bound) (Lemire's multiply-shift rejection)
+ * @param rng Generator state
+ * @param bound Exclusive upper bound; 0 returns 0
+ * @return Uniform value below bound
+ */
+uint64_t mathi_xoshiro256_bounded(MathiXoshiro256 *rng, uint64_t bound);
+
+/**
+ * @brief Uniform double in [0, 1) with 53 random bits
+ * @param rng Generator state
+ * @return Value in [0, 1)
+ */
+double mathi_xoshiro256_double(MathiXoshiro256 *rng);
+
+/**
+ * @brief Seed a PCG64 generator (same scheme as the reference pcg64_srandom_r)
+ * @param rng Generator to initialise
+ * @param seed Initial state
+ * @param stream Stream selector; different streams give independent sequences
+ */
+void mathi_pcg64_seed(MathiPcg64 *rng, uint64_t seed, uint64_t stream);
+
+/**
+ * @brief Next 64-bit output of a PCG64 generator
+ * @param rng Generator state
+ * @return Uniform 64-bit value
+ */
+uint64_t mathi_pcg64_next(MathiPcg64 *rng);
+
+/**
+ * @brief Advance a PCG64 generator by delta steps in O(log delta)
+ * @param rng Generator state
+ * @param delta Number of outputs to skip
+ */
+void mathi_pcg64_advance(MathiPcg64 *rng, uint64_t delta);
+
+/**
+ * @brief Advance a PCG64 generator by 2^64 steps
+ * @param rng Generator state
+ */
+void mathi_pcg64_jump(MathiPcg64 *rng);
+
+/**
+ * @brief Unbiased integer in [0, bound) (Lemire's multiply-shift rejection)
+ * @param rng Generator state
+ * @param bound Exclusive upper bound; 0 returns 0
+ * @return Uniform value below bound
+ */
+uint64_t mathi_pcg64_bounded(MathiPcg64 *rng, uint64_t bound);
+
+/**
+ * @brief Uniform double in [0, 1) with 53 random bits
+ * @param rng Generator state
+ * @return Value in [0, 1)
+ */
+double mathi_pcg64_double(MathiPcg64 *rng);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MATHI_PRNG_H
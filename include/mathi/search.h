@@ -9,9 +9,13 @@
 #ifndef MATHI_SEARCH_H
 #define MATHI_SEARCH_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 /**
  * @file mathi/search.h
- * @brief Linear, binary, jump, and interpolation search algorithms for integer arrays.
+ * @brief Linear, binary, jump, and interpolation search, a static search index,
+ *        batched lookups and lower/upper bound queries over sorted arrays.
  */
 
 /**
@@ -21,7 +25,7 @@
  * @param key Value to search for
  * @return Index of key if found, -1 otherwise
  */
-int mathi_linear_search(int *arr, int n, int key);
+int mathi_linear_search(const int *arr, size_t n, int key);
 
 /**
  * @brief Perform binary search on a sorted array.
@@ -50,4 +54,221 @@ int mathi_jump_search(int *arr, int n, int key);
  */
 int mathi_interpolation_search(int *arr, int n, int key);
 
+/**
+ * @brief Static search index over a sorted int array (Eytzinger layout).
+ */
+typedef struct {
+    int *keys;      ///< keys in Eytzinger order, 1-based, cache-line aligned
+    uint32_t *rank; ///< rank[k] = position of keys[k] in the original array
+    size_t n;       ///< number of keys
+} MathiSearchIndex;
+
+/**
+ * @brief Build a search index from a sorted array
+ * @param sorted Pointer to sorted integer array (copied, not retained)
+ * @param n Number of elements in the array
+ * @return New index, or NULL on failure
+ */
+MathiSearchIndex* mathi_search_index_build(const int *sorted, size_t n);
+
+/**
+ * @brief Find a key through a search index
+ * @param idx Search index
+ * @param key Value to search for
+ * @return Position of the first occurrence in the original array, -1 if absent
+ */
+ptrdiff_t mathi_search_index_find(const MathiSearchIndex *idx, int key);
+
+/**
+ * @brief Position of the first element >= key in the original array
+ * @param idx Search index
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_search_index_lower_bound(const MathiSearchIndex *idx, int key);
+
+/**
+ * @brief Free a search index
+ * @param idx Search index
+ */
+void mathi_search_index_free(MathiSearchIndex *idx);
+
+/**
+ * @brief Look up many keys in one sorted array with interleaved, prefetched probes
+ * @param arr Pointer to sorted integer array
+ * @param n Number of elements in the array
+ * @param keys Keys to look up
+ * @param m Number of keys
+ * @param out Output: position of the first occurrence of each key, or -1
+ */
+void mathi_binary_search_batch(const int *arr, size_t n, const int *keys, size_t m, ptrdiff_t *out);
+
+/**
+ * @brief Multithreaded mathi_binary_search_batch (splits the keys across threads)
+ * @param arr Pointer to sorted integer array
+ * @param n Number of elements in the array
+ * @param keys Keys to look up
+ * @param m Number of keys
+ * @param out Output: position of the first occurrence of each key, or -1
+ * @param threads Number of threads (<= 0 uses all online CPUs)
+ */
+void mathi_binary_search_batch_mt(const int *arr, size_t n, const int *keys, size_t m, ptrdiff_t *out, int threads);
+
+/**
+ * @brief First position whose value is not less than key (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_lower_bound_i32(const int32_t *arr, size_t n, int32_t key);
+
+/**
+ * @brief First position whose value is greater than key (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_upper_bound_i32(const int32_t *arr, size_t n, int32_t key);
+
+/**
+ * @brief Range [first, last) of elements equal to key (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param key Value to search for
+ * @param first Output: lower bound
+ * @param last Output: upper bound
+ */
+void mathi_equal_range_i32(const int32_t *arr, size_t n, int32_t key, size_t *first, size_t *last);
+
+/**
+ * @brief Number of elements in [lo, hi) (int32_t)
+ * @param arr Pointer to sorted array
+ * @param n Number of elements in the array
+ * @param lo Inclusive lower value
+ * @param hi Exclusive upper value
+ * @return Count of elements v with lo <= v < hi
+ */
+size_t mathi_count_range_i32(const int32_t *arr, size_t n, int32_t lo, int32_t hi);
+
+/**
+ * @brief mathi_lower_bound_i32 for int64_t arrays
+ */
+size_t mathi_lower_bound_i64(const int64_t *arr, size_t n, int64_t key);
+
+/**
+ * @brief mathi_upper_bound_i32 for int64_t arrays
+ */
+size_t mathi_upper_bound_i64(const int64_t *arr, size_t n, int64_t key);
+
+/**
+ * @brief mathi_equal_range_i32 for int64_t arrays
+ */
+void mathi_equal_range_i64(const int64_t *arr, size_t n, int64_t key, size_t *first, size_t *last);
+
+/**
+ * @brief mathi_count_range_i32 for int64_t arrays
+ */
+size_t mathi_count_range_i64(const int64_t *arr, size_t n, int64_t lo, int64_t hi);
+
+/**
+ * @brief mathi_lower_bound_i32 for double arrays (NaNs sort last, as in mathi_sort_f64)
+ */
+size_t mathi_lower_bound_f64(const double *arr, size_t n, double key);
+
+/**
+ * @brief mathi_upper_bound_i32 for double arrays (NaNs sort last)
+ */
+size_t mathi_upper_bound_f64(const double *arr, size_t n, double key);
+
+/**
+ * @brief mathi_equal_range_i32 for double arrays (NaNs sort last)
+ */
+void mathi_equal_range_f64(const double *arr, size_t n, double key, size_t *first, size_t *last);
+
+/**
+ * @brief mathi_count_range_i32 for double arrays (NaNs sort last)
+ */
+size_t mathi_count_range_f64(const double *arr, size_t n, double lo, double hi);
+
+/**
+ * @brief Static learned index: piecewise-linear model of key -> position with error bound eps.
+ */
+typedef struct {
+    int64_t *seg_key;  ///< first key of each segment (ascending)
+    double *seg_slope; ///< positions per key unit in each segment
+    double *seg_pos;   ///< position of each segment's first key
+    size_t nseg;       ///< number of segments
+    size_t n;          ///< number of keys in the indexed array
+    size_t eps;        ///< maximum prediction error, in positions
+    int key_size;      ///< sizeof the key type it was built for
+    uint32_t *radix;   ///< radix table over segment key prefixes (rebuilt on load)
+    size_t radix_size; ///< entries in the radix table
+    int radix_shift;   ///< key offset shift selecting the prefix
+} MathiLearnedIndex;
+
+/**
+ * @brief Fit a learned index over a sorted int32_t array
+ * @param sorted Pointer to sorted array (not retained; pass it again to lookups)
+ * @param n Number of elements in the array
+ * @param eps Maximum prediction error in positions (larger = fewer segments)
+ * @return New index, or NULL on allocation failure
+ */
+MathiLearnedIndex* mathi_learned_index_build_i32(const int32_t *sorted, size_t n, size_t eps);
+
+/**
+ * @brief First position whose value is not less than key, via a learned index
+ * @param idx Learned index built over arr
+ * @param arr The sorted array the index was built over
+ * @param key Value to search for
+ * @return Position in [0, n]
+ */
+size_t mathi_learned_index_lower_bound_i32(const MathiLearnedIndex *idx, const int32_t *arr, int32_t key);
+
+/**
+ * @brief Find a key via a learned index
+ * @param idx Learned index built over arr
+ * @param arr The sorted array the index was built over
+ * @param key Value to search for
+ * @return Position of the first occurrence, -1 if absent
+ */
+ptrdiff_t mathi_learned_index_find_i32(const MathiLearnedIndex *idx, const int32_t *arr, int32_t key);
+
+/**
+ * @brief mathi_learned_index_build_i32 for int64_t arrays
+ */
+MathiLearnedIndex* mathi_learned_index_build_i64(const int64_t *sorted, size_t n, size_t eps);
+
+/**
+ * @brief mathi_learned_index_lower_bound_i32 for int64_t arrays
+ */
+size_t mathi_learned_index_lower_bound_i64(const MathiLearnedIndex *idx, const int64_t *arr, int64_t key);
+
+/**
+ * @brief mathi_learned_index_find_i32 for int64_t arrays
+ */
+ptrdiff_t mathi_learned_index_find_i64(const MathiLearnedIndex *idx, const int64_t *arr, int64_t key);
+
+/**
+ * @brief Save a learned index to disk (the keys are not stored)
+ * @param idx Learned index
+ * @param path Output file path
+ * @return 0 on success, -1 on failure
+ */
+int mathi_learned_index_save(const MathiLearnedIndex *idx, const char *path);
+
+/**
+ * @brief Load a learned index saved by mathi_learned_index_save
+ * @param path Input file path
+ * @return Loaded index, or NULL on failure
+ */
+MathiLearnedIndex* mathi_learned_index_load(const char *path);
+
+/**
+ * @brief Free a learned index
+ * @param idx Learned index
+ */
+void mathi_learned_index_free(MathiLearnedIndex *idx);
+
 #endif // MATHI_SEARCH_H
\ No newline at end of file
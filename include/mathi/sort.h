@@ -9,9 +9,12 @@
 #ifndef MATHI_SORT_H
 #define MATHI_SORT_H
 
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for fixed-width key types
+
 /**
  * @file mathi/sort.h
- * @brief Standard sorting algorithms for integer arrays.
+ * @brief Sorting algorithms for integer arrays, typed numeric arrays and records.
  */
 
 /**
@@ -43,12 +46,20 @@ void mathi_insertion_sort(int *arr, int n);
 void mathi_merge_sort(int *arr, int n);
 
 /**
- * @brief Quick Sort
+ * @brief Quick Sort (runs on the Introsort engine)
  * @param arr Pointer to the array
  * @param n Number of elements in the array
  */
 void mathi_quick_sort(int *arr, int n);
 
+/**
+ * @brief Introsort: ninther pivots, three-way partitioning, insertion-sort
+ *        leaves and a heap sort fallback past 2*log2(n) depth
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_intro_sort(int *arr, int n);
+
 /**
  * @brief Heap Sort
  * @param arr Pointer to the array
@@ -64,4 +75,225 @@ void mathi_heap_sort(int *arr, int n);
  */
 void mathi_counting_sort(int *arr, int n, int max);
 
+/**
+ * @brief Radix Sort (LSD, four 8-bit passes, full signed 32-bit range)
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_radix_sort(int *arr, int n);
+
+/**
+ * @brief Radix Sort using a caller-supplied scratch buffer
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param scratch Buffer of at least n ints, overwritten during the sort
+ */
+void mathi_radix_sort_buf(int *arr, int n, int *scratch);
+
+/**
+ * @brief Parallel stable Merge Sort on a pthread worker pool
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param threads Number of threads (<= 0 uses all online CPUs)
+ */
+void mathi_parallel_sort(int *arr, int n, int threads);
+
+/**
+ * @brief Adaptive stable natural-run Merge Sort (Timsort), O(n) on sorted input
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_tim_sort(int *arr, int n);
+
+/**
+ * @brief Key types understood by mathi_sort_records.
+ */
+typedef enum {
+    MATHI_KEY_I32, ///< int32_t key
+    MATHI_KEY_U32, ///< uint32_t key
+    MATHI_KEY_I64, ///< int64_t key
+    MATHI_KEY_U64, ///< uint64_t key
+    MATHI_KEY_F32, ///< float key (NaNs sort last)
+    MATHI_KEY_F64  ///< double key (NaNs sort last)
+} MathiSortKey;
+
+/**
+ * @brief Introsort for int32_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_i32(int32_t *arr, size_t n);
+
+/**
+ * @brief Introsort for uint32_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_u32(uint32_t *arr, size_t n);
+
+/**
+ * @brief Introsort for int64_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_i64(int64_t *arr, size_t n);
+
+/**
+ * @brief Introsort for uint64_t arrays with a size_t length
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_u64(uint64_t *arr, size_t n);
+
+/**
+ * @brief Introsort for float arrays; NaNs are ordered after every number
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_f32(float *arr, size_t n);
+
+/**
+ * @brief Introsort for double arrays; NaNs are ordered after every number
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_f64(double *arr, size_t n);
+
+/**
+ * @brief Sort fixed-size records by a numeric key stored at a byte offset
+ * @param base Pointer to the first record
+ * @param n Number of records
+ * @param size Size of each record in bytes
+ * @param key_offset Byte offset of the key inside a record (e.g. offsetof)
+ * @param key Type of the key
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mathi_sort_records(void *base, size_t n, size_t size, size_t key_offset, MathiSortKey key);
+
+/**
+ * @brief Sort a small array (up to 64 elements) with an AVX2 sorting network,
+ *        falling back to insertion sort without AVX2 and Introsort above 64
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_small(int *arr, int n);
+
+/**
+ * @brief Float variant of mathi_sort_small; blocks containing NaN use the scalar path
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ */
+void mathi_sort_small_f32(float *arr, int n);
+
+/**
+ * @brief Stable sort of keys that applies the same reordering to a value array
+ * @param keys Pointer to the key array
+ * @param vals Pointer to the value array (reordered with keys)
+ * @param n Number of elements
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_sort_pairs(int *keys, int *vals, int n);
+
+/**
+ * @brief Stable argsort: fill idx with the permutation that sorts keys
+ * @param keys Pointer to the key array (not modified)
+ * @param n Number of elements
+ * @param idx Output array of n indices
+ * @return 0 on success, -1 on allocation failure
+ */
+int mathi_argsort(const int *keys, int n, int *idx);
+
+/**
+ * @brief Gather one column through an index list: dst[i] = src[idx[i]]
+ * @param idx Index list of length n
+ * @param n Number of elements
+ * @param src Source column
+ * @param dst Destination column (must not overlap src)
+ * @param size Element size in bytes
+ */
+void mathi_gather(const int *idx, int n, const void *src, void *dst, size_t size);
+
+/**
+ * @brief Apply one index list to several columns in cache-sized blocks
+ * @param idx Index list of length n
+ * @param n Number of rows
+ * @param src Array of ncols source columns
+ * @param dst Array of ncols destination columns
+ * @param sizes Element size in bytes of each column
+ * @param ncols Number of columns
+ */
+void mathi_gather_columns(const int *idx, int n, const void *const *src, void *const *dst,
+                          const size_t *sizes, int ncols);
+
+/**
+ * @brief Sort a binary file of ints that may not fit in memory
+ * @param in_path Path of the input file (native-endian ints)
+ * @param out_path Path of the sorted output file (may equal in_path)
+ * @param mem_budget Approximate working memory in bytes
+ * @return 0 on success, -1 on failure
+ */
+int mathi_external_sort(const char *in_path, const char *out_path, size_t mem_budget);
+
+/**
+ * @brief Reorder arr so arr[k] holds its sorted value, smaller values before it
+ *        and larger after (introselect, O(n))
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param k Position to settle (0 <= k < n)
+ */
+void mathi_nth_element(int *arr, int n, int k);
+
+/**
+ * @brief Sort the k smallest values into arr[0..k), rest in unspecified order
+ * @param arr Pointer to the array
+ * @param n Number of elements in the array
+ * @param k Number of smallest values to sort
+ */
+void mathi_partial_sort(int *arr, int n, int k);
+
+/**
+ * @brief Streaming tracker of the k largest values seen (bounded min-heap).
+ */
+typedef struct {
+    int *heap; ///< min-heap of the current top values
+    int size;  ///< values currently held
+    int k;     ///< capacity
+} MathiTopK;
+
+/**
+ * @brief Create a top-k tracker
+ * @param k Number of largest values to keep
+ * @return New tracker, or NULL on failure
+ */
+MathiTopK* mathi_topk_new(int k);
+
+/**
+ * @brief Offer one value to a top-k tracker
+ * @param t Tracker
+ * @param v Value
+ */
+void mathi_topk_push(MathiTopK *t, int v);
+
+/**
+ * @brief Offer a batch of values to a top-k tracker
+ * @param t Tracker
+ * @param arr Values
+ * @param n Number of values
+ */
+void mathi_topk_push_array(MathiTopK *t, const int *arr, int n);
+
+/**
+ * @brief Copy out the current top values, largest first
+ * @param t Tracker
+ * @param out Output array with room for k values
+ * @return Number of values written
+ */
+int mathi_topk_result(const MathiTopK *t, int *out);
+
+/**
+ * @brief Free a top-k tracker
+ * @param t Tracker
+ */
+void mathi_topk_free(MathiTopK *t);
+
 #endif // MATHI_SORT_H
\ No newline at end of file
@@ -50,7 +50,7 @@ double mathi_stddev(int *arr, int n);
  * @brief Compute the mode (most frequent value) of an array
  * @param arr Pointer to the integer array
  * @param n Number of elements in the array
- * @return Mode as integer
+ * @return Mode as integer; the smallest value on ties, 0 if n <= 0
  */
 int mathi_mode(int *arr, int n);
 
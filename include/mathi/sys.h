@@ -11,7 +11,7 @@
 
 /**
  * @file mathi/sys.h
- * @brief System and environment utility functions.
+ * @brief System, environment and CPU feature utility functions.
  */
 
 #ifdef __cplusplus
@@ -34,6 +34,12 @@ char* mathi_get_env(const char *name);
  */
 int mathi_set_env(const char *name, const char *value, int overwrite);
 
+/**
+ * @brief Check whether the running CPU supports AVX2
+ * @return 1 if supported, 0 otherwise (always 0 on non-x86 targets)
+ */
+int mathi_cpu_has_avx2(void);
+
 #ifdef __cplusplus
 }
 #endif
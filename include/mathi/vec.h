@@ -0,0 +1,220 @@
+/*
+ * Mathi C Library - Growable Vectors and Arenas
+ * vec.h
+ *
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#ifndef MATHI_VEC_H
+#define MATHI_VEC_H
+
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @file mathi/vec.h
+ * @brief Macro-templated dynamic vectors with geometric growth and optional
+ *        inline storage, a pluggable allocator interface and a bump arena.
+ *
+ * A vector is declared with MATHI_VEC(T) or MATHI_SMALL_VEC(T, N) and driven
+ * through the mathi_vec_* macros, which work for any element type:
+ *
+ * @code
+ * MATHI_SMALL_VEC(int, 8) v;
+ * mathi_vec_init(&v);
+ * for(int i = 0; i < 100; i++) mathi_vec_push(&v, i);
+ * mathi_vec_free(&v);
+ * @endcode
+ *
+ * The macros evaluate their vector argument more than once, so pass a plain
+ * pointer. A small vector points into itself while it uses its inline
+ * storage: do not copy or move it by value. MATHI_VEC relies on the GNU
+ * zero-length array extension (gcc, clang).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Allocator interface used by vectors (and anything else that takes one).
+ *
+ * Sizes of the previous allocation are passed back to realloc and free so
+ * that allocators such as arenas need not store them. A NULL allocator
+ * pointer means malloc/realloc/free.
+ */
+typedef struct MathiAllocator {
+    void *(*alloc)(void *ctx, size_t size);                                   ///< Allocate size bytes
+    void *(*realloc)(void *ctx, void *ptr, size_t old_size, size_t new_size); ///< Resize ptr
+    void (*free)(void *ctx, void *ptr, size_t size);                         ///< Release ptr
+    void *ctx;                                                                ///< Passed to every callback
+} MathiAllocator;
+
+/**
+ * @brief Bump allocator over a chain of chunks; everything is released at once.
+ */
+typedef struct MathiArena MathiArena;
+
+/**
+ * @brief Create an arena.
+ * @param chunk_size Bytes per chunk (0 uses 64 KiB); larger requests get their own chunk
+ * @return New arena, or NULL on allocation failure
+ */
+MathiArena* mathi_arena_new(size_t chunk_size);
+
+/**
+ * @brief Allocate size bytes, 16-byte aligned, from an arena.
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return Pointer valid until the arena is reset or freed, or NULL on failure
+ */
+void* mathi_arena_alloc(MathiArena *arena, size_t size);
+
+/**
+ * @brief Release every allocation but keep the first chunk for reuse.
+ * @param arena Arena to reset
+ */
+void mathi_arena_reset(MathiArena *arena);
+
+/**
+ * @brief Free an arena and all memory allocated from it.
+ * @param arena Arena to free (may be NULL)
+ */
+void mathi_arena_free(MathiArena *arena);
+
+/**
+ * @brief Allocator that draws from an arena.
+ *
+ * The most recent allocation is grown or released in place; any other free
+ * is a no-op until the arena is reset.
+ *
+ * @param arena Arena backing the allocator
+ * @return Allocator whose ctx is arena
+ */
+MathiAllocator mathi_arena_allocator(MathiArena *arena);
+
+/**
+ * @brief Type-erased growth step behind the vector macros.
+ *
+ * Ensures *data can hold need elements of elem_size bytes, growing the
+ * capacity geometrically (doubling). While *data is inline_buf the
+ * contents are copied out to the heap.
+ *
+ * @param data Address of the vector's element pointer (any T **)
+ * @param len Elements currently in use (copied when moving out of inline_buf)
+ * @param cap Pointer to the capacity in elements
+ * @param need Required capacity in elements
+ * @param elem_size Size of one element
+ * @param inline_buf Inline storage of the vector, or NULL
+ * @param alloc Allocator, or NULL for malloc
+ * @return 0 on success, -1 on overflow or allocation failure (vector unchanged)
+ */
+int mathi_vec_reserve_raw(void *data, size_t len, size_t *cap, size_t need, size_t elem_size,
+                          void *inline_buf, const MathiAllocator *alloc);
+
+/**
+ * @brief Type-erased shrink: moves the elements back inline when they fit,
+ *        otherwise trims the heap buffer to len elements.
+ * @return 0 on success, -1 on allocation failure (vector unchanged)
+ */
+int mathi_vec_shrink_raw(void *data, size_t len, size_t *cap, size_t elem_size, void *inline_buf,
+                         size_t inline_cap, const MathiAllocator *alloc);
+
+/**
+ * @brief Release the heap buffer of a vector (no-op while it is inline).
+ */
+void mathi_vec_free_raw(void *data, size_t cap, size_t elem_size, const void *inline_buf,
+                        const MathiAllocator *alloc);
+
+/* ----------------------------------------
+   Vector types
+---------------------------------------- */
+
+/** @brief Vector of T whose first N elements live inside the struct (no heap allocation). */
+#define MATHI_SMALL_VEC(T, N)                                                   \
+    struct {                                                                    \
+        T *data;                     /* elements; inline_buf while they fit */  \
+        size_t len;                  /* elements in use */                      \
+        size_t cap;                  /* capacity of data, in elements */        \
+        const MathiAllocator *alloc; /* NULL for malloc */                      \
+        T inline_buf[N];                                                        \
+    }
+
+/** @brief Heap-only vector of T (a zero-length inline buffer). */
+#define MATHI_VEC(T) MATHI_SMALL_VEC(T, 0)
+
+/* Inline storage of a vector and its capacity in elements; NULL/0 for MATHI_VEC. */
+#define mathi_vec_inline_(v) (sizeof((v)->inline_buf) ? (void *)(v)->inline_buf : NULL)
+#define mathi_vec_inline_cap_(v) (sizeof((v)->inline_buf) / sizeof(*(v)->data))
+
+/* ----------------------------------------
+   Vector operations
+---------------------------------------- */
+
+/** @brief Initialise an empty vector using allocator a (NULL for malloc). */
+#define mathi_vec_init_alloc(v, a)                                                         \
+    ((v)->len = 0, (v)->alloc = (a),                                                        \
+     (v)->cap = mathi_vec_inline_cap_(v),                                                   \
+     (v)->data = (void *)mathi_vec_inline_(v))
+
+/** @brief Initialise an empty vector backed by malloc. */
+#define mathi_vec_init(v) mathi_vec_init_alloc(v, NULL)
+
+/** @brief Free the vector's heap storage and leave it empty (and reusable). */
+#define mathi_vec_free(v)                                                                  \
+    (mathi_vec_free_raw((v)->data, (v)->cap, sizeof(*(v)->data), mathi_vec_inline_(v),     \
+                        (v)->alloc),                                                       \
+     mathi_vec_init_alloc(v, (v)->alloc))
+
+/** @brief Make room for at least n elements. @return 0, or -1 on failure. */
+#define mathi_vec_reserve(v, n)                                                            \
+    ((n) <= (v)->cap ? 0 : mathi_vec_reserve_raw(&(v)->data, (v)->len, &(v)->cap, \
+                                                 (n), sizeof(*(v)->data),                  \
+                                                 mathi_vec_inline_(v), (v)->alloc))
+
+/** @brief Append x. @return 0, or -1 on allocation failure. */
+#define mathi_vec_push(v, x)                                                               \
+    (mathi_vec_reserve(v, (v)->len + 1) == 0 ? ((v)->data[(v)->len++] = (x), 0) : -1)
+
+/** @brief Append n elements copied from src with one memcpy. @return 0, or -1 on failure. */
+#define mathi_vec_extend(v, src, n)                                                        \
+    ((size_t)(n) > (size_t)-1 - (v)->len ? -1 :                                             \
+     mathi_vec_reserve(v, (v)->len + (n)) == 0                                             \
+         ? (memcpy((v)->data + (v)->len, (src), (n) * sizeof(*(v)->data)), (v)->len += (n), 0) \
+         : -1)
+
+/** @brief Set the length to n; new elements are zero-filled. @return 0, or -1 on failure. */
+#define mathi_vec_resize(v, n)                                                             \
+    (mathi_vec_reserve(v, n) == 0                                                          \
+         ? ((n) > (v)->len ? (void)memset((v)->data + (v)->len, 0,                           \
+                                          ((n) - (v)->len) * sizeof(*(v)->data))            \
+                           : (void)0,                                                      \
+            (v)->len = (n), 0)                                                             \
+         : -1)
+
+/** @brief Trim capacity to the length (back into inline storage if it fits). @return 0 or -1. */
+#define mathi_vec_shrink_to_fit(v)                                                         \
+    mathi_vec_shrink_raw(&(v)->data, (v)->len, &(v)->cap, sizeof(*(v)->data),     \
+                         mathi_vec_inline_(v), mathi_vec_inline_cap_(v), (v)->alloc)
+
+/** @brief Remove and return the last element (the vector must not be empty). */
+#define mathi_vec_pop(v) ((v)->data[--(v)->len])
+
+/** @brief Element i (unchecked), usable as an lvalue. */
+#define mathi_vec_at(v, i) ((v)->data[i])
+
+/** @brief Last element (the vector must not be empty). */
+#define mathi_vec_last(v) ((v)->data[(v)->len - 1])
+
+/** @brief Number of elements. */
+#define mathi_vec_len(v) ((v)->len)
+
+/** @brief Remove all elements, keeping the capacity. */
+#define mathi_vec_clear(v) ((void)((v)->len = 0))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MATHI_VEC_H
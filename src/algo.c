@@ -8,6 +8,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "mathi/array.h"
 
 /**
  * @brief Compute the nth Fibonacci number.
@@ -38,15 +39,9 @@ int mathi_fibonacci(int n)
  * @param value Value to count
  * @return Number of occurrences of value in arr
  */
-int mathi_occurs(int arr[], int n, int value)
+int mathi_occurs(const int *restrict arr, size_t n, int value)
 {
-    int count = 0;
-
-    for (int i = 0; i < n; i++)
-        if (arr[i] == value)
-            count++;
-
-    return count;
+    return (int)mathi_arr_count(arr, n, value);
 }
 
 /**
@@ -9,35 +9,167 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <stdint.h>
+#include "mathi/array.h"
+#include "mathi/intmap.h"
+#include "mathi/prng.h"
+#include "mathi/sort.h"
+#include "mathi/sys.h"
+#include "mathi_internal.h"
 
-/**
- * @brief Find the index of a value in an array.
- * @return Index of value or -1 if not found
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARRAY_HAVE_X86 1
+#include <immintrin.h>
+
+/*
+ * AVX2 scan kernels: 16 ints per step as two 8-lane compares. The index
+ * kernel ORs both compare masks and only decodes the movemask once
+ * something matched; the count kernel popcounts the combined mask.
  */
-int mathi_arr_index(int *arr, int n, int value)
+AVX2_TARGET static size_t scan_index_avx2(const int *arr, size_t n, int value)
+{
+    const __m256i k = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(arr + i)), k);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(arr + i + 8)), k);
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b)))
+        {
+            unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(a)) |
+                            (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    for (; i < n; i++)
+        if (arr[i] == value)
+            return i;
+    return n;
+}
+
+AVX2_TARGET static size_t scan_count_avx2(const int *arr, size_t n, int value)
+{
+    const __m256i k = _mm256_set1_epi32(value);
+    size_t count = 0, i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(arr + i)), k);
+        __m256i b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(arr + i + 8)), k);
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(a)) |
+                        (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(b)) << 8;
+        count += __builtin_popcount(mask);
+    }
+    for (; i < n; i++)
+        count += arr[i] == value;
+    return count;
+}
+
+#ifdef __SSE2__
+/* SSE2 (baseline on x86-64) kernels: 8 ints per step as two 4-lane compares. */
+static size_t scan_index_sse2(const int *arr, size_t n, int value)
+{
+    const __m128i k = _mm_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(arr + i)), k);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(arr + i + 4)), k);
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(a)) |
+                        (unsigned)_mm_movemask_ps(_mm_castsi128_ps(b)) << 4;
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    for (; i < n; i++)
+        if (arr[i] == value)
+            return i;
+    return n;
+}
+
+static size_t scan_count_sse2(const int *arr, size_t n, int value)
+{
+    const __m128i k = _mm_set1_epi32(value);
+    size_t count = 0, i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(arr + i)), k);
+        __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(arr + i + 4)), k);
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(a)) |
+                        (unsigned)_mm_movemask_ps(_mm_castsi128_ps(b)) << 4;
+        count += __builtin_popcount(mask);
+    }
+    for (; i < n; i++)
+        count += arr[i] == value;
+    return count;
+}
+#endif
+#endif
+
+/* Position of the first element equal to value, or n; dispatches to the widest kernel available. */
+static size_t scan_index(const int *arr, size_t n, int value)
 {
-    for (int i = 0; i < n; i++)
+#ifdef ARRAY_HAVE_X86
+    if (mathi_cpu_has_avx2())
+        return scan_index_avx2(arr, n, value);
+#ifdef __SSE2__
+    return scan_index_sse2(arr, n, value);
+#endif
+#endif
+    for (size_t i = 0; i < n; i++)
         if (arr[i] == value)
             return i;
+    return n;
+}
 
-    return -1;
+/**
+ * @brief Find the index of a value in an array.
+ *
+ * Compares 16 ints per step with AVX2 (8 with SSE2) when available.
+ *
+ * @return Index of the first occurrence of value, or -1 if not found
+ */
+int mathi_arr_index(const int *restrict arr, size_t n, int value)
+{
+    size_t i = scan_index(arr, n, value);
+    return i < n ? (int)i : -1;
 }
 
 /**
  * @brief Check if an array contains a value.
  * @return 1 if found, 0 otherwise
  */
-int mathi_arr_contains(int *arr, int n, int value)
+int mathi_arr_contains(const int *restrict arr, size_t n, int value)
 {
-    return mathi_arr_index(arr, n, value) != -1;
+    return scan_index(arr, n, value) < n;
+}
+
+/**
+ * @brief Count the elements equal to a value (SIMD compare + popcount).
+ * @return Number of occurrences of value
+ */
+size_t mathi_arr_count(const int *restrict arr, size_t n, int value)
+{
+#ifdef ARRAY_HAVE_X86
+    if (mathi_cpu_has_avx2())
+        return scan_count_avx2(arr, n, value);
+#ifdef __SSE2__
+    return scan_count_sse2(arr, n, value);
+#endif
+#endif
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++)
+        count += arr[i] == value;
+    return count;
 }
 
 /**
  * @brief Reverse an array in place.
  */
-void mathi_arr_reverse(int *arr, int n)
+void mathi_arr_reverse(int *arr, size_t n)
 {
-    for (int i = 0, j = n - 1; i < j; i++, j--)
+    if (n < 2)
+        return;
+
+    for (size_t i = 0, j = n - 1; i < j; i++, j--)
     {
         int tmp = arr[i];
         arr[i] = arr[j];
@@ -48,122 +180,946 @@ void mathi_arr_reverse(int *arr, int n)
 /**
  * @brief Copy one array to another.
  */
-void mathi_arr_copy(int *src, int *dest, int n)
+void mathi_arr_copy(const int *restrict src, int *restrict dest, size_t n)
 {
-    for (int i = 0; i < n; i++)
+    for (size_t i = 0; i < n; i++)
         dest[i] = src[i];
 }
 
 /**
  * @brief Fill an array with a specific value.
  */
-void mathi_arr_fill(int *arr, int n, int value)
+void mathi_arr_fill(int *arr, size_t n, int value)
 {
-    for (int i = 0; i < n; i++)
+    for (size_t i = 0; i < n; i++)
         arr[i] = value;
 }
 
-/**
- * @brief Compute the sum of array elements.
+#ifdef ARRAY_HAVE_X86
+/*
+ * Reduction kernels. Sums widen every lane to int64 before adding, so the
+ * result is exact; min/max keep two independent accumulators per step.
  */
-int mathi_arr_sum(int *arr, int n)
+AVX2_TARGET static int64_t reduce_sum_avx2(const int *arr, size_t n)
 {
-    int sum = 0;
-    for (int i = 0; i < n; i++)
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(arr + i));
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, _mm256_add_epi64(acc0, acc1));
+    int64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; i++)
         sum += arr[i];
+    return sum;
+}
+
+AVX2_TARGET static void reduce_minmax_avx2(const int *arr, size_t n, int *min, int *max)
+{
+    __m256i lo = _mm256_set1_epi32(arr[0]), hi = lo;
+    __m256i lo1 = lo, hi1 = lo;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(arr + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(arr + i + 8));
+        lo = _mm256_min_epi32(lo, a);
+        hi = _mm256_max_epi32(hi, a);
+        lo1 = _mm256_min_epi32(lo1, b);
+        hi1 = _mm256_max_epi32(hi1, b);
+    }
+    int l[8], h[8];
+    _mm256_storeu_si256((__m256i *)l, _mm256_min_epi32(lo, lo1));
+    _mm256_storeu_si256((__m256i *)h, _mm256_max_epi32(hi, hi1));
+    int mn = l[0], mx = h[0];
+    for (int k = 1; k < 8; k++)
+    {
+        if (l[k] < mn)
+            mn = l[k];
+        if (h[k] > mx)
+            mx = h[k];
+    }
+    for (; i < n; i++)
+    {
+        if (arr[i] < mn)
+            mn = arr[i];
+        if (arr[i] > mx)
+            mx = arr[i];
+    }
+    *min = mn;
+    *max = mx;
+}
 
+AVX2_TARGET static double reduce_sqdev_avx2(const int *arr, size_t n, double center)
+{
+    const __m256d c = _mm256_set1_pd(center);
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256d d0 = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(arr + i))), c);
+        __m256d d1 = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(arr + i + 4))), c);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++)
+        sum += (arr[i] - center) * (arr[i] - center);
     return sum;
 }
 
+#ifdef __SSE2__
+/* SSE2 has no 32->64 sign extension or epi32 min/max; emulate them with srai/unpack and compare masks. */
+static int64_t reduce_sum_sse2(const int *arr, size_t n)
+{
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(arr + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    int64_t sum = lanes[0] + lanes[1];
+    for (; i < n; i++)
+        sum += arr[i];
+    return sum;
+}
+
+static void reduce_minmax_sse2(const int *arr, size_t n, int *min, int *max)
+{
+    __m128i lo = _mm_set1_epi32(arr[0]), hi = lo;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(arr + i));
+        __m128i lt = _mm_cmplt_epi32(v, lo), gt = _mm_cmpgt_epi32(v, hi);
+        lo = _mm_or_si128(_mm_and_si128(lt, v), _mm_andnot_si128(lt, lo));
+        hi = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, hi));
+    }
+    int l[4], h[4];
+    _mm_storeu_si128((__m128i *)l, lo);
+    _mm_storeu_si128((__m128i *)h, hi);
+    int mn = l[0], mx = h[0];
+    for (int k = 1; k < 4; k++)
+    {
+        if (l[k] < mn)
+            mn = l[k];
+        if (h[k] > mx)
+            mx = h[k];
+    }
+    for (; i < n; i++)
+    {
+        if (arr[i] < mn)
+            mn = arr[i];
+        if (arr[i] > mx)
+            mx = arr[i];
+    }
+    *min = mn;
+    *max = mx;
+}
+
+static double reduce_sqdev_sse2(const int *arr, size_t n, double center)
+{
+    const __m128d c = _mm_set1_pd(center);
+    __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(arr + i));
+        __m128d d0 = _mm_sub_pd(_mm_cvtepi32_pd(v), c);
+        __m128d d1 = _mm_sub_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2))), c);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(d0, d0));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(d1, d1));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    double sum = lanes[0] + lanes[1];
+    for (; i < n; i++)
+        sum += (arr[i] - center) * (arr[i] - center);
+    return sum;
+}
+#endif
+#endif
+
 /**
- * @brief Find the maximum element in an array.
+ * @brief Compute the sum of array elements.
+ *
+ * Every element is widened to int64 before it is added, so the result is
+ * exact for any array of fewer than 2^32 elements.
  */
-int mathi_arr_max(int *arr, int n)
+int64_t mathi_arr_sum(const int *restrict arr, size_t n)
 {
-    if (n <= 0) 
-        return 0;
+#ifdef ARRAY_HAVE_X86
+    if (mathi_cpu_has_avx2())
+        return reduce_sum_avx2(arr, n);
+#ifdef __SSE2__
+    return reduce_sum_sse2(arr, n);
+#endif
+#endif
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += arr[i];
+    return sum;
+}
+
+/* One-pass min/max of a non-empty array; dispatches like scan_index. */
+static void reduce_minmax(const int *arr, size_t n, int *min, int *max)
+{
+#ifdef ARRAY_HAVE_X86
+    if (mathi_cpu_has_avx2())
+    {
+        reduce_minmax_avx2(arr, n, min, max);
+        return;
+    }
+#ifdef __SSE2__
+    reduce_minmax_sse2(arr, n, min, max);
+    return;
+#endif
+#endif
+    int mn = arr[0], mx = arr[0];
+    for (size_t i = 1; i < n; i++)
+    {
+        if (arr[i] < mn)
+            mn = arr[i];
+        if (arr[i] > mx)
+            mx = arr[i];
+    }
+    *min = mn;
+    *max = mx;
+}
 
-    int max = arr[0];
+/**
+ * @brief Find the minimum and maximum elements in a single pass.
+ * @return 0 on success, -1 if n == 0 (min and max are set to 0).
+ */
+int mathi_arr_minmax(const int *restrict arr, size_t n, int *min, int *max)
+{
+    int mn = 0, mx = 0, rc = -1;
+    if (n > 0)
+    {
+        reduce_minmax(arr, n, &mn, &mx);
+        rc = 0;
+    }
 
-    for (int i = 1; i < n; i++)
-        if (arr[i] > max)
-            max = arr[i];
+    if (min)
+        *min = mn;
+    if (max)
+        *max = mx;
+    return rc;
+}
 
+/**
+ * @brief Find the maximum element in an array.
+ */
+int mathi_arr_max(const int *restrict arr, size_t n)
+{
+    int max;
+    mathi_arr_minmax(arr, n, NULL, &max);
     return max;
 }
 
 /**
  * @brief Find the minimum element in an array.
  */
-int mathi_arr_min(int *arr, int n)
+int mathi_arr_min(const int *restrict arr, size_t n)
 {
-    if (n <= 0) 
+    int min;
+    mathi_arr_minmax(arr, n, &min, NULL);
+    return min;
+}
+
+/**
+ * @brief Compute the average of array elements (from the exact int64 sum).
+ */
+double mathi_arr_average(const int *restrict arr, size_t n)
+{
+    if (n == 0)
         return 0;
 
-    int min = arr[0];
+    return (double)mathi_arr_sum(arr, n) / n;
+}
 
-    for (int i = 1; i < n; i++)
-        if (arr[i] < min)
-            min = arr[i];
+/**
+ * @brief Sum of squared deviations of the elements from center.
+ *
+ * Accumulates in double lanes, so the result may differ from a sequential
+ * loop in the last bits.
+ */
+double mathi_arr_sqdev(const int *restrict arr, size_t n, double center)
+{
+#ifdef ARRAY_HAVE_X86
+    if (mathi_cpu_has_avx2())
+        return reduce_sqdev_avx2(arr, n, center);
+#ifdef __SSE2__
+    return reduce_sqdev_sse2(arr, n, center);
+#endif
+#endif
+    double sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += (arr[i] - center) * (arr[i] - center);
+    return sum;
+}
 
-    return min;
+/* Multithreaded reductions only split arrays with at least this many elements per thread. */
+#define ARRAY_MT_MIN (1 << 18)
+
+enum { REDUCE_SUM, REDUCE_MINMAX };
+
+typedef struct
+{
+    const int *arr;
+    size_t n;
+    int op;
+    int64_t sum;
+    int min, max;
+} ReduceTask;
+
+static void reduce_slice(void *ctx, int slice)
+{
+    ReduceTask *t = (ReduceTask *)ctx + slice;
+    if (t->op == REDUCE_SUM)
+        t->sum = mathi_arr_sum(t->arr, t->n);
+    else
+        mathi_arr_minmax(t->arr, t->n, &t->min, &t->max);
+}
+
+/*
+ * Run one reduction over contiguous slices and combine the partial results
+ * into *out. Small arrays and thread creation failures fall back to running
+ * on the calling thread.
+ */
+static void reduce_mt(const int *arr, size_t n, int op, int threads, ReduceTask *out)
+{
+    ReduceTask whole = {arr, n, op, 0, 0, 0};
+    threads = mathi_default_threads(threads);
+    if ((size_t)threads > n / ARRAY_MT_MIN)
+        threads = (int)(n / ARRAY_MT_MIN);
+
+    ReduceTask *tasks = threads > 1 ? malloc(threads * sizeof(ReduceTask)) : NULL;
+    if (!tasks)
+    {
+        reduce_slice(&whole, 0);
+        *out = whole;
+        return;
+    }
+
+    size_t chunk = (n + threads - 1) / threads;
+    for (int t = 0; t < threads; t++)
+    {
+        size_t lo = (size_t)t * chunk, hi = lo + chunk < n ? lo + chunk : n;
+        ReduceTask task = {arr + lo, hi - lo, op, 0, 0, 0};
+        tasks[t] = task;
+    }
+    mathi_run_slices(reduce_slice, tasks, threads);
+
+    whole.min = tasks[0].min;
+    whole.max = tasks[0].max;
+    for (int t = 0; t < threads; t++)
+    {
+        whole.sum += tasks[t].sum;
+        if (tasks[t].min < whole.min)
+            whole.min = tasks[t].min;
+        if (tasks[t].max > whole.max)
+            whole.max = tasks[t].max;
+    }
+    *out = whole;
+
+    free(tasks);
 }
 
 /**
- * @brief Compute the average of array elements.
+ * @brief Multithreaded mathi_arr_sum.
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
  */
-double mathi_arr_average(int *arr, int n)
+int64_t mathi_arr_sum_mt(const int *restrict arr, size_t n, int threads)
 {
-    if (n <= 0) 
-        return 0;
+    ReduceTask r;
+    reduce_mt(arr, n, REDUCE_SUM, threads, &r);
+    return r.sum;
+}
 
-    return (double)mathi_arr_sum(arr, n) / n;
+/**
+ * @brief Multithreaded mathi_arr_minmax.
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ * @return 0 on success, -1 if n == 0.
+ */
+int mathi_arr_minmax_mt(const int *restrict arr, size_t n, int *min, int *max, int threads)
+{
+    if (n == 0)
+        return mathi_arr_minmax(arr, n, min, max);
+
+    ReduceTask r;
+    reduce_mt(arr, n, REDUCE_MINMAX, threads, &r);
+    if (min)
+        *min = r.min;
+    if (max)
+        *max = r.max;
+    return 0;
 }
 
+/*
+ * Prefix sums (scans). Every kernel scans n elements starting from carry and returns carry plus
+ * their total. An inclusive scan writes out[i] = carry + in[0] + ... + in[i];
+ * an exclusive one stops before in[i]. out may equal in. Integer scans wrap
+ * around on overflow.
+ */
+
+/* Sequential kernel and a four-accumulator total; U is the type the arithmetic is done in. */
+#define DEFINE_SCAN_SCALAR(sfx, T, U)                                                \
+static T scan_scalar_##sfx(const T *in, T *out, size_t n, T carry, int exclusive)    \
+{                                                                                    \
+    U acc = (U)carry;                                                                \
+    for (size_t i = 0; i < n; i++)                                                   \
+    {                                                                                \
+        U x = (U)in[i];                                                              \
+        out[i] = (T)(exclusive ? acc : acc + x);                                     \
+        acc += x;                                                                    \
+    }                                                                                \
+    return (T)acc;                                                                   \
+}                                                                                    \
+                                                                                     \
+static T scan_total_##sfx(const T *in, size_t n)                                     \
+{                                                                                    \
+    U a = 0, b = 0, c = 0, d = 0;                                                    \
+    size_t i = 0;                                                                    \
+    for (; i + 4 <= n; i += 4)                                                       \
+    {                                                                                \
+        a += (U)in[i];                                                               \
+        b += (U)in[i + 1];                                                           \
+        c += (U)in[i + 2];                                                           \
+        d += (U)in[i + 3];                                                           \
+    }                                                                                \
+    for (; i < n; i++)                                                               \
+        a += (U)in[i];                                                               \
+    return (T)((a + b) + (c + d));                                                   \
+}
+
+DEFINE_SCAN_SCALAR(i32, int32_t, uint32_t)
+DEFINE_SCAN_SCALAR(i64, int64_t, uint64_t)
+DEFINE_SCAN_SCALAR(f64, double, double)
+
+/*
+ * The SIMD kernels scan one register in log2(lanes) shift-and-add steps. AVX2
+ * byte shifts stay inside 128-bit halves, so each half is scanned and the low
+ * half's total is then added to the high half. The exclusive result is the
+ * in-register scan moved up one lane. Only the running carry is a dependency
+ * between registers.
+ */
+#ifdef ARRAY_HAVE_X86
+AVX2_TARGET
+static int32_t scan_i32_avx2(const int32_t *in, int32_t *out, size_t n, int32_t carry, int exclusive)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i up_one = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i last = _mm256_set1_epi32(7);
+    __m256i c = _mm256_set1_epi32(carry);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(in + i));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+        x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+        x = _mm256_add_epi32(x, _mm256_shuffle_epi32(_mm256_permute2x128_si256(x, x, 0x08), 0xFF));
+        __m256i r = exclusive ? _mm256_blend_epi32(_mm256_permutevar8x32_epi32(x, up_one), zero, 0x01) : x;
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi32(r, c));
+        c = _mm256_add_epi32(c, _mm256_permutevar8x32_epi32(x, last));
+    }
+    carry = _mm_cvtsi128_si32(_mm256_castsi256_si128(c));
+    return scan_scalar_i32(in + i, out + i, n - i, carry, exclusive);
+}
+
+AVX2_TARGET
+static int64_t scan_i64_avx2(const int64_t *in, int64_t *out, size_t n, int64_t carry, int exclusive)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i c = _mm256_set1_epi64x(carry);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(in + i));
+        x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+        x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x50), zero, 0x0F));
+        __m256i r = exclusive ? _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), zero, 0x03) : x;
+        _mm256_storeu_si256((__m256i *)(out + i), _mm256_add_epi64(r, c));
+        c = _mm256_add_epi64(c, _mm256_permute4x64_epi64(x, 0xFF));
+    }
+    _mm_storel_epi64((__m128i *)&carry, _mm256_castsi256_si128(c));
+    return scan_scalar_i64(in + i, out + i, n - i, carry, exclusive);
+}
+
+AVX2_TARGET
+static double scan_f64_avx2(const double *in, double *out, size_t n, double carry, int exclusive)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d c = _mm256_set1_pd(carry);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d x = _mm256_loadu_pd(in + i);
+        x = _mm256_add_pd(x, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(x), 8)));
+        x = _mm256_add_pd(x, _mm256_blend_pd(_mm256_permute4x64_pd(x, 0x50), zero, 0x3));
+        __m256d r = exclusive ? _mm256_blend_pd(_mm256_permute4x64_pd(x, 0x90), zero, 0x1) : x;
+        _mm256_storeu_pd(out + i, _mm256_add_pd(r, c));
+        c = _mm256_add_pd(c, _mm256_permute4x64_pd(x, 0xFF));
+    }
+    carry = _mm_cvtsd_f64(_mm256_castpd256_pd128(c));
+    return scan_scalar_f64(in + i, out + i, n - i, carry, exclusive);
+}
+
+#ifdef __SSE2__
+static int32_t scan_i32_sse2(const int32_t *in, int32_t *out, size_t n, int32_t carry, int exclusive)
+{
+    __m128i c = _mm_set1_epi32(carry);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        __m128i r = exclusive ? _mm_slli_si128(x, 4) : x;
+        _mm_storeu_si128((__m128i *)(out + i), _mm_add_epi32(r, c));
+        c = _mm_add_epi32(c, _mm_shuffle_epi32(x, 0xFF));
+    }
+    carry = _mm_cvtsi128_si32(c);
+    return scan_scalar_i32(in + i, out + i, n - i, carry, exclusive);
+}
+
+static int64_t scan_i64_sse2(const int64_t *in, int64_t *out, size_t n, int64_t carry, int exclusive)
+{
+    __m128i c = _mm_set1_epi64x(carry);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+        x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+        __m128i r = exclusive ? _mm_slli_si128(x, 8) : x;
+        _mm_storeu_si128((__m128i *)(out + i), _mm_add_epi64(r, c));
+        c = _mm_add_epi64(c, _mm_unpackhi_epi64(x, x));
+    }
+    _mm_storel_epi64((__m128i *)&carry, c);
+    return scan_scalar_i64(in + i, out + i, n - i, carry, exclusive);
+}
+
+static double scan_f64_sse2(const double *in, double *out, size_t n, double carry, int exclusive)
+{
+    __m128d c = _mm_set1_pd(carry);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d x = _mm_loadu_pd(in + i);
+        x = _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)));
+        __m128d r = exclusive ? _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)) : x;
+        _mm_storeu_pd(out + i, _mm_add_pd(r, c));
+        c = _mm_add_pd(c, _mm_unpackhi_pd(x, x));
+    }
+    carry = _mm_cvtsd_f64(c);
+    return scan_scalar_f64(in + i, out + i, n - i, carry, exclusive);
+}
+#endif
+#endif
+
+/* Scan dispatch: the widest kernel available for each element type. */
+#if defined(ARRAY_HAVE_X86) && defined(__SSE2__)
+#define DEFINE_SCAN_DISPATCH(sfx, T)                                                \
+static T scan_##sfx(const T *in, T *out, size_t n, T carry, int exclusive)          \
+{                                                                                   \
+    if (mathi_cpu_has_avx2())                                                       \
+        return scan_##sfx##_avx2(in, out, n, carry, exclusive);                     \
+    return scan_##sfx##_sse2(in, out, n, carry, exclusive);                         \
+}
+#elif defined(ARRAY_HAVE_X86)
+#define DEFINE_SCAN_DISPATCH(sfx, T)                                                \
+static T scan_##sfx(const T *in, T *out, size_t n, T carry, int exclusive)          \
+{                                                                                   \
+    if (mathi_cpu_has_avx2())                                                       \
+        return scan_##sfx##_avx2(in, out, n, carry, exclusive);                     \
+    return scan_scalar_##sfx(in, out, n, carry, exclusive);                         \
+}
+#else
+#define DEFINE_SCAN_DISPATCH(sfx, T)                                                \
+static T scan_##sfx(const T *in, T *out, size_t n, T carry, int exclusive)          \
+{                                                                                   \
+    return scan_scalar_##sfx(in, out, n, carry, exclusive);                         \
+}
+#endif
+
+DEFINE_SCAN_DISPATCH(i32, int32_t)
+DEFINE_SCAN_DISPATCH(i64, int64_t)
+DEFINE_SCAN_DISPATCH(f64, double)
+
+/*
+ * Two-pass parallel scan: pass 1 totals every slice but the last, the
+ * calling thread turns the totals into slice offsets, and pass 2 scans each
+ * slice from its offset. Arrays are read twice and written once.
+ */
+enum { SCAN_I32, SCAN_I64, SCAN_F64 };
+
+typedef union
+{
+    int32_t i32;
+    int64_t i64;
+    double f64;
+} ScanValue;
+
+typedef struct
+{
+    int type;
+    int pass;
+    const void *in;
+    void *out;
+    size_t n;
+    int exclusive;
+    ScanValue value; // pass 1: total of the slice; pass 2: its offset
+} ScanTask;
+
+static void scan_slice(void *ctx, int slice)
+{
+    ScanTask *t = (ScanTask *)ctx + slice;
+    switch (t->type)
+    {
+    case SCAN_I32:
+        if (t->pass == 1)
+            t->value.i32 = scan_total_i32(t->in, t->n);
+        else
+            scan_i32(t->in, t->out, t->n, t->value.i32, t->exclusive);
+        break;
+    case SCAN_I64:
+        if (t->pass == 1)
+            t->value.i64 = scan_total_i64(t->in, t->n);
+        else
+            scan_i64(t->in, t->out, t->n, t->value.i64, t->exclusive);
+        break;
+    default:
+        if (t->pass == 1)
+            t->value.f64 = scan_total_f64(t->in, t->n);
+        else
+            scan_f64(t->in, t->out, t->n, t->value.f64, t->exclusive);
+        break;
+    }
+}
+
+/* Run tasks[0..count) for one pass and wait for all of them. */
+static void scan_run(ScanTask *tasks, int count, int pass)
+{
+    for (int t = 0; t < count; t++)
+        tasks[t].pass = pass;
+    mathi_run_slices(scan_slice, tasks, count);
+}
+
+static void scan_mt(int type, const void *in, void *out, size_t n, size_t elem_size, int exclusive,
+                    int threads)
+{
+    ScanTask whole = {type, 2, in, out, n, exclusive, {0}};
+    threads = mathi_default_threads(threads);
+    if ((size_t)threads > n / ARRAY_MT_MIN)
+        threads = (int)(n / ARRAY_MT_MIN);
+
+    ScanTask *tasks = threads > 1 ? malloc(threads * sizeof(ScanTask)) : NULL;
+    if (!tasks)
+    {
+        scan_slice(&whole, 0);
+        return;
+    }
+
+    size_t chunk = (n + threads - 1) / threads;
+    for (int t = 0; t < threads; t++)
+    {
+        size_t lo = (size_t)t * chunk, hi = lo + chunk < n ? lo + chunk : n;
+        ScanTask task = {type, 1, (const char *)in + lo * elem_size, (char *)out + lo * elem_size,
+                         hi - lo, exclusive, {0}};
+        tasks[t] = task;
+    }
+
+    scan_run(tasks, threads - 1, 1);
+
+    // Exclusive scan of the slice totals gives each slice its starting offset.
+    ScanValue offset = {0};
+    for (int t = 0; t < threads; t++)
+    {
+        ScanValue total = tasks[t].value;
+        tasks[t].value = offset;
+        if (type == SCAN_I32)
+            offset.i32 = (int32_t)((uint32_t)offset.i32 + (uint32_t)total.i32);
+        else if (type == SCAN_I64)
+            offset.i64 = (int64_t)((uint64_t)offset.i64 + (uint64_t)total.i64);
+        else
+            offset.f64 += total.f64;
+    }
+
+    scan_run(tasks, threads, 2);
+
+    free(tasks);
+}
+
+/* Segmented scans run the scan kernel over each run between flags. */
+#define DEFINE_SCAN_SEGMENTED(sfx, T)                                               \
+void mathi_scan_segmented_##sfx(const T *in, const unsigned char *flags, T *out,    \
+                                size_t n)                                           \
+{                                                                                   \
+    size_t start = 0;                                                               \
+    while (start < n)                                                               \
+    {                                                                               \
+        size_t end = start + 1;                                                     \
+        while (end < n && !flags[end])                                              \
+            end++;                                                                  \
+        scan_##sfx(in + start, out + start, end - start, 0, 0);                     \
+        start = end;                                                                \
+    }                                                                               \
+}
+
+/* Public scans; see array.h for the documentation of each. */
+#define DEFINE_SCANS(sfx, T, TYPE)                                                  \
+void mathi_scan_inclusive_##sfx(const T *in, T *out, size_t n)                      \
+{                                                                                   \
+    scan_##sfx(in, out, n, 0, 0);                                                   \
+}                                                                                   \
+                                                                                    \
+void mathi_scan_exclusive_##sfx(const T *in, T *out, size_t n)                      \
+{                                                                                   \
+    scan_##sfx(in, out, n, 0, 1);                                                   \
+}                                                                                   \
+                                                                                    \
+void mathi_scan_inclusive_##sfx##_mt(const T *in, T *out, size_t n, int threads)    \
+{                                                                                   \
+    scan_mt(TYPE, in, out, n, sizeof(T), 0, threads);                               \
+}                                                                                   \
+                                                                                    \
+void mathi_scan_exclusive_##sfx##_mt(const T *in, T *out, size_t n, int threads)    \
+{                                                                                   \
+    scan_mt(TYPE, in, out, n, sizeof(T), 1, threads);                               \
+}                                                                                   \
+                                                                                    \
+DEFINE_SCAN_SEGMENTED(sfx, T)
+
+DEFINE_SCANS(i32, int32_t, SCAN_I32)
+DEFINE_SCANS(i64, int64_t, SCAN_I64)
+DEFINE_SCANS(f64, double, SCAN_F64)
+
 /**
  * @brief Check if two arrays are equal.
  */
-int mathi_arr_equal(int *a, int *b, int n)
+int mathi_arr_equal(const int *restrict a, const int *restrict b, size_t n)
 {
-    for (int i = 0; i < n; i++)
+    for (size_t i = 0; i < n; i++)
         if (a[i] != b[i])
             return 0;
 
     return 1;
 }
 
+/* Per-thread generator behind mathi_arr_shuffle, seeded on first use. */
+static _Thread_local MathiXoshiro256 shuffle_rng;
+static _Thread_local int shuffle_rng_ready;
+
 /**
  * @brief Shuffle an array randomly.
+ *
+ * Uses a per-thread xoshiro256** generator seeded once from the clock and
+ * the generator's own address, so back-to-back calls and concurrent
+ * threads get different permutations.
  */
-void mathi_arr_shuffle(int *arr, int n)
+void mathi_arr_shuffle(int *arr, size_t n)
 {
-    srand((unsigned int)time(NULL));
+    if (!shuffle_rng_ready)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        uint64_t seed = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+        mathi_xoshiro256_seed(&shuffle_rng, seed ^ (uint64_t)(uintptr_t)&shuffle_rng);
+        shuffle_rng_ready = 1;
+    }
 
-    for (int i = n - 1; i > 0; i--)
+    mathi_arr_shuffle_r(arr, n, &shuffle_rng);
+}
+
+/**
+ * @brief Fisher-Yates shuffle driven by an explicit generator.
+ *
+ * Indices come from Lemire's unbiased bounded method, so every permutation
+ * is equally likely and the result is reproducible from the seed.
+ */
+void mathi_arr_shuffle_r(int *arr, size_t n, MathiXoshiro256 *rng)
+{
+    for (size_t i = n; i > 1; i--)
     {
-        int j = rand() % (i + 1);
-        int tmp = arr[i];
-        arr[i] = arr[j];
+        size_t j = (size_t)mathi_xoshiro256_bounded(rng, i);
+        int tmp = arr[i - 1];
+        arr[i - 1] = arr[j];
         arr[j] = tmp;
     }
 }
 
+/* MergeShuffle leaf blocks hold at least this many elements. */
+#define SHUFFLE_MT_BLOCK (1 << 16)
+
+/* Upper bound on leaf blocks (a power of two); also bounds the worker threads. */
+#define SHUFFLE_MAX_BLOCKS 64
+
+/*
+ * Merge two independently shuffled runs t[0..mid) and t[mid..n) into a
+ * uniform shuffle of t[0..n) in place (Bacher et al., MergeShuffle): a fair
+ * coin picks the side of each output slot until one side runs out, and the
+ * leftover elements are then inserted with Fisher-Yates steps.
+ */
+static void shuffle_merge(int *t, size_t mid, size_t n, MathiXoshiro256 *rng)
+{
+    size_t i = 0, j = mid;
+    uint64_t bits = 0;
+    int left = 0;
+
+    for (;;)
+    {
+        if (left == 0)
+        {
+            bits = mathi_xoshiro256_next(rng);
+            left = 64;
+        }
+        int take_right = (int)(bits & 1);
+        bits >>= 1;
+        left--;
+
+        if (take_right)
+        {
+            if (j == n)
+                break;
+            int tmp = t[i];
+            t[i] = t[j];
+            t[j] = tmp;
+            j++;
+        }
+        else if (i == j)
+            break;
+        i++;
+    }
+
+    for (; i < n; i++)
+    {
+        size_t k = (size_t)mathi_xoshiro256_bounded(rng, i + 1);
+        int tmp = t[i];
+        t[i] = t[k];
+        t[k] = tmp;
+    }
+}
+
+typedef struct
+{
+    int *arr;
+    size_t n, nblocks;
+    size_t width; // blocks per merge input; 0 shuffles the leaf blocks
+    MathiXoshiro256 *rngs;
+    int first, stride;
+} ShuffleTask;
+
+/* Start of leaf block b; block sizes differ by at most one. */
+static size_t shuffle_block_start(size_t n, size_t nblocks, size_t b)
+{
+    return (size_t)((uint64_t)n / nblocks * b + (uint64_t)n % nblocks * b / nblocks);
+}
+
+static void shuffle_slice(void *ctx, int slice)
+{
+    ShuffleTask *t = (ShuffleTask *)ctx + slice;
+    if (t->width == 0)
+    {
+        for (size_t b = t->first; b < t->nblocks; b += t->stride)
+        {
+            size_t lo = shuffle_block_start(t->n, t->nblocks, b);
+            size_t hi = shuffle_block_start(t->n, t->nblocks, b + 1);
+            mathi_arr_shuffle_r(t->arr + lo, hi - lo, &t->rngs[b]);
+        }
+        return;
+    }
+
+    size_t merges = t->nblocks / (2 * t->width);
+    for (size_t m = t->first; m < merges; m += t->stride)
+    {
+        size_t b = m * 2 * t->width;
+        size_t lo = shuffle_block_start(t->n, t->nblocks, b);
+        size_t mid = shuffle_block_start(t->n, t->nblocks, b + t->width);
+        size_t hi = shuffle_block_start(t->n, t->nblocks, b + 2 * t->width);
+        // The merged run keeps drawing from the stream of its leftmost block.
+        shuffle_merge(t->arr + lo, mid - lo, hi - lo, &t->rngs[b]);
+    }
+}
+
 /**
- * @brief Remove duplicate elements from an array in place.
- * @param n Pointer to size of array; updated with new size
+ * @brief Parallel MergeShuffle of a large array without heap allocation.
+ *
+ * The array is cut into a power-of-two number of blocks that depends only
+ * on n; each block is shuffled with its own stream (a copy of rng jumped
+ * once per block) and adjacent runs are then merged pairwise, level by
+ * level, in parallel. The result therefore depends on rng and n but not on
+ * the thread count. rng is left jumped past every stream used. Arrays of
+ * fewer than 2 * SHUFFLE_MT_BLOCK elements use mathi_arr_shuffle_r.
+ *
+ * @param threads Number of threads; <= 0 uses the number of online CPUs
  */
-void mathi_arr_distinct(int *arr, int *n)
+void mathi_arr_shuffle_mt(int *arr, size_t n, MathiXoshiro256 *rng, int threads)
 {
-    if (*n <= 1) 
+    size_t nblocks = 1;
+    while (nblocks < SHUFFLE_MAX_BLOCKS && n / (2 * nblocks) >= SHUFFLE_MT_BLOCK)
+        nblocks *= 2;
+    if (nblocks == 1)
+    {
+        mathi_arr_shuffle_r(arr, n, rng);
         return;
+    }
 
-    int j = 0;
+    MathiXoshiro256 rngs[SHUFFLE_MAX_BLOCKS];
+    for (size_t b = 0; b < nblocks; b++)
+    {
+        rngs[b] = *rng;
+        mathi_xoshiro256_jump(rng);
+    }
+
+    threads = mathi_default_threads(threads);
+    if ((size_t)threads > nblocks)
+        threads = (int)nblocks;
 
-    for (int i = 1; i < *n; i++)
+    ShuffleTask tasks[SHUFFLE_MAX_BLOCKS];
+
+    for (size_t width = 0; width < nblocks; width = width ? 2 * width : 1)
+    {
+        size_t jobs = width ? nblocks / (2 * width) : nblocks;
+        int nt = (size_t)threads < jobs ? threads : (int)jobs;
+        for (int t = 0; t < nt; t++)
+        {
+            ShuffleTask task = {arr, n, nblocks, width, rngs, t, nt};
+            tasks[t] = task;
+        }
+        mathi_run_slices(shuffle_slice, tasks, nt);
+    }
+}
+
+/* Inputs up to this size are deduplicated by the quadratic scan, which beats building a table. */
+#define DISTINCT_SMALL_N 16
+
+/* The bitmap mode is used while its size stays within this many bits per element (the hash set's footprint). */
+#define DISTINCT_BITMAP_BITS_PER_ELEM 64
+
+/* Keys handed to the hash set per bulk insert. */
+#define DISTINCT_BLOCK 256
+
+/* Order-preserving O(n^2) dedup; no allocation. */
+static size_t distinct_scan(int *arr, size_t n)
+{
+    size_t j = 0;
+
+    for (size_t i = 1; i < n; i++)
     {
         int found = 0;
 
-        for (int k = 0; k <= j; k++)
+        for (size_t k = 0; k <= j; k++)
             if (arr[i] == arr[k])
             {
                 found = 1;
@@ -174,27 +1130,159 @@ void mathi_arr_distinct(int *arr, int *n)
             arr[++j] = arr[i];
     }
 
-    *n = j + 1;
+    return j + 1;
+}
+
+/*
+ * Order-preserving dedup through a MathiI32Set, fed a block at a time so the
+ * set can prefetch the slots of upcoming keys. The set is sized for all n
+ * keys up front, so no insert can fail once it exists. Returns the new
+ * length, or 0 on allocation failure.
+ */
+static size_t distinct_hash(int *arr, size_t n)
+{
+    MathiI32Set seen;
+    if (mathi_i32set_init(&seen, n) != 0)
+    {
+        mathi_i32set_free(&seen);
+        return 0;
+    }
+
+    unsigned char added[DISTINCT_BLOCK];
+    size_t j = 0;
+    for (size_t i = 0; i < n; i += DISTINCT_BLOCK)
+    {
+        size_t len = n - i < DISTINCT_BLOCK ? n - i : DISTINCT_BLOCK;
+        mathi_i32set_add_many(&seen, arr + i, len, added);
+        for (size_t k = 0; k < len; k++)
+            if (added[k])
+                arr[j++] = arr[i + k];
+    }
+
+    mathi_i32set_free(&seen);
+    return j;
+}
+
+/*
+ * Order-preserving dedup of values in [min, max] through a bitmap of
+ * max - min + 1 bits. Returns the new length, or 0 on allocation failure.
+ */
+static size_t distinct_bitmap(int *arr, size_t n, int min, int max)
+{
+    uint64_t range = (uint64_t)((int64_t)max - min) + 1;
+    uint64_t *bits = calloc((size_t)((range + 63) / 64), sizeof(uint64_t));
+    if (!bits)
+        return 0;
+
+    size_t j = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t off = (uint64_t)((int64_t)arr[i] - min);
+        uint64_t bit = 1ull << (off & 63);
+        if (!(bits[off >> 6] & bit))
+        {
+            bits[off >> 6] |= bit;
+            arr[j++] = arr[i];
+        }
+    }
+
+    free(bits);
+    return j;
+}
+
+/* Sort, then keep the first of each run; no allocation. */
+static size_t distinct_sorted(int *arr, size_t n)
+{
+    mathi_sort_i32(arr, n);
+
+    size_t j = 0;
+    for (size_t i = 1; i < n; i++)
+        if (arr[i] != arr[j])
+            arr[++j] = arr[i];
+
+    return j + 1;
+}
+
+/**
+ * @brief Remove duplicate elements from an array in place.
+ *
+ * MATHI_DISTINCT_HASH and MATHI_DISTINCT_BITMAP keep the first occurrence
+ * of each value in its original order; MATHI_DISTINCT_SORTED leaves the
+ * distinct values in ascending order. The bitmap mode falls back to the
+ * hash set when max - min exceeds DISTINCT_BITMAP_BITS_PER_ELEM * n.
+ *
+ * @param n Pointer to size of array; updated with new size
+ * @return 0 on success, -1 on an unknown mode or allocation failure
+ *         (arr and *n are then left unchanged)
+ */
+int mathi_arr_distinct_mode(int *arr, size_t *n, MathiDistinctMode mode)
+{
+    size_t len = *n, kept;
+
+    if (mode == MATHI_DISTINCT_SORTED)
+    {
+        if (len > 1)
+            *n = distinct_sorted(arr, len);
+        return 0;
+    }
+    if (mode != MATHI_DISTINCT_HASH && mode != MATHI_DISTINCT_BITMAP)
+        return -1;
+    if (len <= 1)
+        return 0;
+    if (len <= DISTINCT_SMALL_N)
+    {
+        *n = distinct_scan(arr, len);
+        return 0;
+    }
+
+    int min, max;
+    if (mode == MATHI_DISTINCT_BITMAP && mathi_arr_minmax(arr, len, &min, &max) == 0 &&
+        (uint64_t)((int64_t)max - min) < (uint64_t)len * DISTINCT_BITMAP_BITS_PER_ELEM)
+        kept = distinct_bitmap(arr, len, min, max);
+    else
+        kept = distinct_hash(arr, len);
+
+    if (kept == 0)
+        return -1;
+    *n = kept;
+    return 0;
+}
+
+/**
+ * @brief Remove duplicate elements from an array in place, keeping
+ * first-seen order (expected O(n) via a hash set).
+ * @param n Pointer to size of array; updated with new size
+ */
+void mathi_arr_distinct(int *arr, size_t *n)
+{
+    // Without memory for the set, fall back to the allocation-free scan.
+    if (mathi_arr_distinct_mode(arr, n, MATHI_DISTINCT_HASH) != 0 && *n > 1)
+        *n = distinct_scan(arr, *n);
 }
 
 /**
  * @brief Rotate array elements to the right k times.
  */
-void mathi_arr_rotate(int *arr, int n, int k)
+void mathi_arr_rotate(int *arr, size_t n, size_t k)
 {
+    if (n == 0)
+        return;
+
     k = k % n;
     if (k == 0) 
         return;
 
     int *tmp = (int *)malloc(k * sizeof(int));
+    if (!tmp)
+        return;
 
-    for (int i = 0; i < k; i++)
+    for (size_t i = 0; i < k; i++)
         tmp[i] = arr[n - k + i];
 
-    for (int i = n - 1; i >= k; i--)
+    for (size_t i = n - 1; i >= k; i--)
         arr[i] = arr[i - k];
 
-    for (int i = 0; i < k; i++)
+    for (size_t i = 0; i < k; i++)
         arr[i] = tmp[i];
 
     free(tmp);
@@ -204,10 +1292,10 @@ void mathi_arr_rotate(int *arr, int n, int k)
  * @brief Check if an array is sorted in ascending order.
  * @return 1 if sorted, 0 otherwise
  */
-int mathi_arr_sorted(int *arr, int n)
+int mathi_arr_sorted(const int *restrict arr, size_t n)
 {
-    for (int i = 0; i < n - 1; i++)
-        if (arr[i] > arr[i + 1])
+    for (size_t i = 1; i < n; i++)
+        if (arr[i - 1] > arr[i])
             return 0;
 
     return 1;
@@ -9,6 +9,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include "mathi/hashx.h"
 
 typedef struct Node 
 {
@@ -205,60 +207,364 @@ void mathi_queue_free(Queue *q)
     free(q);
 }
 
+/* Default maximum load factor; Robin Hood probing keeps probe lengths short up to here. */
+#define HASHMAP_DEFAULT_LOAD 0.875
+
+/* Smallest table, in slots (always a power of two). */
+#define HASHMAP_MIN_CAP 8
+
+/* Old-table slots moved per insert or remove while a resize is in progress. */
+#define HASHMAP_MIGRATE_STEP 8
+
+/*
+ * One open-addressing table. Slots are stored as parallel arrays so probing
+ * only touches the hashes; a stored hash of 0 marks an empty slot.
+ */
 typedef struct 
 {
-    char *key;
-    int val;
-} Pair;
+    char **keys;
+    void **values;
+    uint32_t *hashes;
+    size_t mask;    // capacity - 1
+    size_t count;
+} HashTable;
 
-typedef struct 
+/*
+ * Growing allocates a table twice the size and drains the old one into it a
+ * few slots per insert/remove. Until it is empty, lookups check both tables.
+ */
+struct MathiHashMap 
 {
-    Pair *tab;
-    int n;
-} Hash;
+    HashTable cur;    // receives every insert
+    HashTable old;    // being drained while old.hashes != NULL
+    size_t migrate;   // next old slot to move
+    double max_load;
+    uint64_t seed;    // per-map hash seed
+};
+
+typedef struct MathiHashMap MathiHashMap;
+typedef struct MathiHashMap Hash;
+
+/* Low 32 bits of the table's seeded hash of the key; never 0. */
+static uint32_t hash_key(const MathiHashMap *m, const char *s)
+{
+    uint32_t h = (uint32_t)mathi_hash_str(s, m->seed);
+    return h ? h : 1;
+}
+
+static int table_init(HashTable *t, size_t cap)
+{
+    size_t slot = sizeof(char *) + sizeof(void *) + sizeof(uint32_t);
+    if (cap > SIZE_MAX / slot) return -1;
+    char *block = malloc(cap * slot);
+    if (!block) return -1;
+    t->keys = (char **)block;
+    t->values = (void **)(block + cap * sizeof(char *));
+    t->hashes = (uint32_t *)(block + cap * (sizeof(char *) + sizeof(void *)));
+    memset(t->hashes, 0, cap * sizeof(uint32_t));
+    t->mask = cap - 1;
+    t->count = 0;
+    return 0;
+}
+
+static void table_release(HashTable *t)
+{
+    free(t->keys);
+    t->keys = NULL;
+    t->values = NULL;
+    t->hashes = NULL;
+}
+
+/* How far the entry in slot i sits from its home slot. */
+static inline size_t table_dist(const HashTable *t, size_t i)
+{
+    return (i - (t->hashes[i] & t->mask)) & t->mask;
+}
+
+/* Slot holding key, or SIZE_MAX. Stops as soon as an entry is closer to home than key would be. */
+static size_t table_find(const HashTable *t, uint32_t h, const char *key)
+{
+    if (!t->hashes) return SIZE_MAX;
+    size_t i = h & t->mask;
+    for (size_t dist = 0; ; dist++) 
+    {
+        uint32_t sh = t->hashes[i];
+        if (!sh || table_dist(t, i) < dist) return SIZE_MAX;
+        if (sh == h && !strcmp(t->keys[i], key)) return i;
+        i = (i + 1) & t->mask;
+    }
+}
+
+/* Robin Hood insert of a key known to be absent: richer entries give up their slot. */
+static void table_insert(HashTable *t, uint32_t h, char *key, void *value)
+{
+    size_t i = h & t->mask;
+    for (size_t dist = 0; ; dist++) 
+    {
+        if (!t->hashes[i]) 
+        {
+            t->hashes[i] = h;
+            t->keys[i] = key;
+            t->values[i] = value;
+            t->count++;
+            return;
+        }
+        size_t sd = table_dist(t, i);
+        if (sd < dist) 
+        {
+            uint32_t th = t->hashes[i];
+            char *tk = t->keys[i];
+            void *tv = t->values[i];
+            t->hashes[i] = h;
+            t->keys[i] = key;
+            t->values[i] = value;
+            h = th;
+            key = tk;
+            value = tv;
+            dist = sd;
+        }
+        i = (i + 1) & t->mask;
+    }
+}
+
+/* Backward-shift deletion: later entries of the run move one slot closer to home, so no tombstones. */
+static void table_erase(HashTable *t, size_t i)
+{
+    size_t j = (i + 1) & t->mask;
+    while (t->hashes[j] && table_dist(t, j) > 0) 
+    {
+        t->hashes[i] = t->hashes[j];
+        t->keys[i] = t->keys[j];
+        t->values[i] = t->values[j];
+        i = j;
+        j = (j + 1) & t->mask;
+    }
+    t->hashes[i] = 0;
+    t->count--;
+}
+
+/*
+ * Move at least budget old slots into the current table, then finish the run
+ * being moved. The cursor therefore always rests on an empty slot: no probe
+ * sequence left in the old table passes through a drained slot, so lookups
+ * and backward shifts there stay correct.
+ */
+static void hashmap_migrate(MathiHashMap *m, size_t budget)
+{
+    HashTable *old = &m->old;
+    while (old->hashes && old->count && (budget || old->hashes[m->migrate])) 
+    {
+        size_t i = m->migrate;
+        if (old->hashes[i]) 
+        {
+            table_insert(&m->cur, old->hashes[i], old->keys[i], old->values[i]);
+            old->hashes[i] = 0;
+            old->count--;
+        }
+        m->migrate = (i + 1) & old->mask;
+        if (budget) budget--;
+    }
+    if (old->hashes && !old->count) 
+        table_release(old);
+}
 
-static unsigned hash_str(const char *s)
+/* Start draining the current table into one of twice the size. Returns -1 if it cannot be allocated. */
+static int hashmap_grow(MathiHashMap *m)
 {
-    unsigned h = 5381;
-    while (*s) h = ((h << 5) + h) + *s++;
-    return h;
+    hashmap_migrate(m, SIZE_MAX);
+
+    HashTable bigger;
+    if ((m->cur.mask + 1) > SIZE_MAX / 2 || table_init(&bigger, (m->cur.mask + 1) * 2) < 0) 
+        return -1;
+
+    m->old = m->cur;
+    m->cur = bigger;
+    // Draining starts at an empty slot; one always exists because the load stays below 1.
+    m->migrate = 0;
+    while (m->old.hashes[m->migrate]) 
+        m->migrate++;
+    if (!m->old.count) 
+        table_release(&m->old);
+    return 0;
 }
 
+/**
+ * @brief Create a hash map from strings to void * values.
+ * @param capacity Expected number of entries (0 for the minimum).
+ * @param max_load Load factor that triggers growth; 0 selects HASHMAP_DEFAULT_LOAD.
+ * @return New map, or NULL on allocation failure.
+ */
+MathiHashMap* mathi_hashmap_new(size_t capacity, double max_load)
+{
+    MathiHashMap *m = malloc(sizeof(MathiHashMap));
+    if (!m) return NULL;
+    if (!(max_load > 0)) max_load = HASHMAP_DEFAULT_LOAD;
+    if (max_load < 0.25) max_load = 0.25;
+    if (max_load > 0.95) max_load = 0.95;
+    m->max_load = max_load;
+    m->seed = mathi_hash_seed();
+
+    size_t cap = HASHMAP_MIN_CAP;
+    while (cap < SIZE_MAX / 2 && (double)cap * max_load < (double)capacity) 
+        cap *= 2;
+    memset(&m->old, 0, sizeof(m->old));
+    m->migrate = 0;
+    if (table_init(&m->cur, cap) < 0) 
+    {
+        free(m);
+        return NULL;
+    }
+    return m;
+}
+
+/**
+ * @brief Insert or update a key. The map stores its own copy of the key.
+ * @return 0 on success, -1 on allocation failure (map unchanged).
+ */
+int mathi_hashmap_set(MathiHashMap *m, const char *key, void *value)
+{
+    uint32_t h = hash_key(m, key);
+    size_t i = table_find(&m->cur, h, key);
+    if (i != SIZE_MAX) 
+    {
+        m->cur.values[i] = value;
+        return 0;
+    }
+    i = table_find(&m->old, h, key);
+    if (i != SIZE_MAX) 
+    {
+        m->old.values[i] = value;
+        return 0;
+    }
+
+    size_t cap = m->cur.mask + 1, total = m->cur.count + m->old.count;
+    if ((double)(total + 1) > m->max_load * (double)cap && hashmap_grow(m) < 0) 
+    {
+        // Over the load factor is still fine as long as an empty slot remains.
+        if (m->cur.count + 1 >= cap) return -1;
+    }
+
+    char *copy = strdup(key);
+    if (!copy) return -1;
+    table_insert(&m->cur, h, copy, value);
+    hashmap_migrate(m, HASHMAP_MIGRATE_STEP);
+    return 0;
+}
+
+/**
+ * @brief Look up a key.
+ * @param value Receives the stored value when found (may be NULL).
+ * @return 1 if the key is present, 0 otherwise.
+ */
+int mathi_hashmap_get(const MathiHashMap *m, const char *key, void **value)
+{
+    uint32_t h = hash_key(m, key);
+    const HashTable *t = &m->cur;
+    size_t i = table_find(t, h, key);
+    if (i == SIZE_MAX) 
+    {
+        t = &m->old;
+        i = table_find(t, h, key);
+        if (i == SIZE_MAX) return 0;
+    }
+    if (value) *value = t->values[i];
+    return 1;
+}
+
+/**
+ * @brief Remove a key.
+ * @param value Receives the removed value when found (may be NULL).
+ * @return 1 if the key was present, 0 otherwise.
+ */
+int mathi_hashmap_remove(MathiHashMap *m, const char *key, void **value)
+{
+    uint32_t h = hash_key(m, key);
+    HashTable *t = &m->cur;
+    size_t i = table_find(t, h, key);
+    if (i == SIZE_MAX) 
+    {
+        t = &m->old;
+        i = table_find(t, h, key);
+        if (i == SIZE_MAX) return 0;
+    }
+    if (value) *value = t->values[i];
+    free(t->keys[i]);
+    table_erase(t, i);
+    hashmap_migrate(m, HASHMAP_MIGRATE_STEP);
+    return 1;
+}
+
+/**
+ * @brief Number of entries in the map.
+ */
+size_t mathi_hashmap_size(const MathiHashMap *m)
+{
+    return m->cur.count + m->old.count;
+}
+
+/**
+ * @brief Iterate over the entries; *iter starts at 0.
+ *
+ * The map must not be modified during the iteration.
+ *
+ * @return 1 with *key and *value set (either may be NULL), or 0 when done.
+ */
+int mathi_hashmap_next(const MathiHashMap *m, size_t *iter, const char **key, void **value)
+{
+    size_t cur_cap = m->cur.mask + 1;
+    size_t end = cur_cap + (m->old.hashes ? m->old.mask + 1 : 0);
+    for (; *iter < end; (*iter)++) 
+    {
+        const HashTable *t = *iter < cur_cap ? &m->cur : &m->old;
+        size_t i = *iter < cur_cap ? *iter : *iter - cur_cap;
+        if (t->hashes[i]) 
+        {
+            if (key) *key = t->keys[i];
+            if (value) *value = t->values[i];
+            (*iter)++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Free the map and its copies of the keys (not the values).
+ */
+void mathi_hashmap_free(MathiHashMap *m)
+{
+    if (!m) return;
+    HashTable *tables[2] = {&m->cur, &m->old};
+    for (int k = 0; k < 2; k++) 
+    {
+        HashTable *t = tables[k];
+        if (!t->hashes) continue;
+        for (size_t i = 0; i <= t->mask; i++) 
+            if (t->hashes[i]) free(t->keys[i]);
+        table_release(t);
+    }
+    free(m);
+}
+
+/* The original int-valued Hash API, kept as a thin wrapper over MathiHashMap. */
+
 Hash* mathi_hash_new(int n)
 {
-    Hash *h = malloc(sizeof(Hash));
-    h->tab = calloc(n, sizeof(Pair));
-    h->n = n;
-    return h;
+    return mathi_hashmap_new(n > 0 ? (size_t)n : 0, 0);
 }
 
 void mathi_hash_set(Hash *h, const char *k, int v)
 {
-    unsigned idx = hash_str(k) % h->n;
-    while (h->tab[idx].key && strcmp(h->tab[idx].key, k)) 
-        idx = (idx + 1) % h->n;
-    
-    if (!h->tab[idx].key) 
-        h->tab[idx].key = strdup(k);
-    
-    h->tab[idx].val = v;
+    mathi_hashmap_set(h, k, (void *)(intptr_t)v);
 }
 
 int mathi_hash_get(Hash *h, const char *k)
 {
-    unsigned idx = hash_str(k) % h->n;
-    while (h->tab[idx].key) 
-    { 
-        if (!strcmp(h->tab[idx].key, k)) return h->tab[idx].val; 
-        idx = (idx + 1) % h->n; 
-    }
-    return 0;
+    void *v;
+    return mathi_hashmap_get(h, k, &v) ? (int)(intptr_t)v : 0;
 }
 
 void mathi_hash_free(Hash *h)
 {
-    for (int i = 0; i < h->n; i++) 
-        free(h->tab[i].key);
-    free(h->tab);
-    free(h);
-}
\ No newline at end of file
+    mathi_hashmap_free(h);
+}
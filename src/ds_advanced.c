@@ -1,6 +1,6 @@
 /*
  * Mathi C Library - Advanced Data Structures Implementation
- * DS Advanced (Heap, Graph, Trie)
+ * DS Advanced (Heap, Graph, Trie, Swiss-table map)
  *
  * Copyright (c) 2025 Macharia Nyamū
  * Licensed under the MIT License. See LICENSE file for details.
@@ -9,8 +9,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include "mathi/ds.h"
 #include "mathi/ds_advanced.h"
+#include "mathi/hashx.h"
 
 
 struct Heap 
@@ -280,4 +285,375 @@ void mathi_trie_free(Trie *t)
     if (!t) return;
     trie_node_free(t->root);
     free(t);
-}
\ No newline at end of file
+}
+
+/*
+ * Swiss-table string map. Every slot has a control byte: EMPTY, DELETED, or
+ * the low 7 bits of the key's hash. Groups of 16 control bytes are matched
+ * against the wanted tag at once, so keys are only compared for slots whose
+ * tag matches (1 in 128 false positives). The remaining hash bits choose the
+ * starting group; groups are probed in triangular order.
+ */
+
+#define SWISS_GROUP 16
+
+/* Control bytes: negative means free, 0..127 is the 7-bit tag of a full slot. */
+#define SWISS_EMPTY   ((signed char)-128)
+#define SWISS_DELETED ((signed char)-2)
+
+/* Keys up to this many bytes are stored inside the slot instead of on the heap. */
+#define SWISS_INLINE_KEY 15
+
+/* Default maximum load factor (tombstones included). */
+#define SWISS_DEFAULT_LOAD 0.875
+
+struct SwissSlot 
+{
+    union 
+    {
+        char inline_key[SWISS_INLINE_KEY + 1];
+        char *heap_key;
+    } k;
+    size_t len;     // key length; > SWISS_INLINE_KEY means heap_key
+    void *value;
+};
+
+struct MathiSwissMap 
+{
+    signed char *ctrl;       // one control byte per slot
+    struct SwissSlot *slots;
+    size_t group_mask;       // number of groups - 1 (a power of two)
+    size_t count;
+    size_t growth_left;      // inserts into EMPTY slots allowed before a sweep or rehash
+    double max_load;
+    uint64_t seed;           // per-map hash seed
+};
+
+/* The map's seeded hash of a key; the low 7 bits become the tag. */
+static inline uint64_t swiss_hash(const MathiSwissMap *m, const char *key, size_t len)
+{
+    return mathi_hash64(key, len, m->seed);
+}
+
+/* Bit i set where ctrl[i] == tag. */
+static inline unsigned swiss_match(const signed char *ctrl, signed char tag)
+{
+#ifdef __SSE2__
+    __m128i g = _mm_loadu_si128((const __m128i *)ctrl);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(tag)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < SWISS_GROUP; i++) 
+        mask |= (unsigned)(ctrl[i] == tag) << i;
+    return mask;
+#endif
+}
+
+/* Bit i set where slot i is EMPTY or DELETED (the control byte's sign bit). */
+static inline unsigned swiss_match_free(const signed char *ctrl)
+{
+#ifdef __SSE2__
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < SWISS_GROUP; i++) 
+        mask |= (unsigned)(ctrl[i] < 0) << i;
+    return mask;
+#endif
+}
+
+static inline const char* swiss_key(const struct SwissSlot *s)
+{
+    return s->len > SWISS_INLINE_KEY ? s->k.heap_key : s->k.inline_key;
+}
+
+static inline size_t swiss_capacity(const MathiSwissMap *m)
+{
+    return (m->group_mask + 1) * SWISS_GROUP;
+}
+
+/* Slot index holding key, or SIZE_MAX. A group with an EMPTY slot ends the probe. */
+static size_t swiss_find(const MathiSwissMap *m, const char *key, size_t len, uint64_t h)
+{
+    signed char tag = (signed char)(h & 0x7F);
+    size_t g = (size_t)(h >> 7) & m->group_mask;
+    for (size_t step = 1; ; step++) 
+    {
+        const signed char *ctrl = m->ctrl + g * SWISS_GROUP;
+        for (unsigned mask = swiss_match(ctrl, tag); mask; mask &= mask - 1) 
+        {
+            size_t i = g * SWISS_GROUP + __builtin_ctz(mask);
+            const struct SwissSlot *s = &m->slots[i];
+            if (s->len == len && !memcmp(swiss_key(s), key, len)) return i;
+        }
+        if (swiss_match(ctrl, SWISS_EMPTY) || step > m->group_mask) return SIZE_MAX;
+        g = (g + step) & m->group_mask;
+    }
+}
+
+/* First free slot on the probe sequence of h. */
+static size_t swiss_find_free(const MathiSwissMap *m, uint64_t h)
+{
+    size_t g = (size_t)(h >> 7) & m->group_mask;
+    for (size_t step = 1; ; step++) 
+    {
+        unsigned mask = swiss_match_free(m->ctrl + g * SWISS_GROUP);
+        if (mask) return g * SWISS_GROUP + __builtin_ctz(mask);
+        g = (g + step) & m->group_mask;
+    }
+}
+
+/* Inserts into EMPTY slots a table of this size allows while it holds no tombstones. */
+static size_t swiss_growth_limit(const MathiSwissMap *m)
+{
+    size_t cap = swiss_capacity(m);
+    size_t limit = (size_t)(m->max_load * (double)cap);
+    return limit >= cap ? cap - 1 : limit;
+}
+
+static int swiss_alloc(MathiSwissMap *m, size_t groups)
+{
+    size_t cap = groups * SWISS_GROUP;
+    signed char *ctrl = malloc(cap);
+    struct SwissSlot *slots = malloc(cap * sizeof(struct SwissSlot));
+    if (!ctrl || !slots) 
+    {
+        free(ctrl);
+        free(slots);
+        return -1;
+    }
+    memset(ctrl, SWISS_EMPTY, cap);
+    m->ctrl = ctrl;
+    m->slots = slots;
+    m->group_mask = groups - 1;
+    m->growth_left = swiss_growth_limit(m);
+    return 0;
+}
+
+/* Move every entry into a fresh table of the given size; tombstones are dropped. */
+static int swiss_rehash(MathiSwissMap *m, size_t groups)
+{
+    signed char *old_ctrl = m->ctrl;
+    struct SwissSlot *old_slots = m->slots;
+    size_t old_cap = swiss_capacity(m);
+
+    if (swiss_alloc(m, groups) < 0) return -1;
+    for (size_t i = 0; i < old_cap; i++) 
+    {
+        if (old_ctrl[i] < 0) continue;
+        const struct SwissSlot *s = &old_slots[i];
+        uint64_t h = swiss_hash(m, swiss_key(s), s->len);
+        size_t j = swiss_find_free(m, h);
+        m->ctrl[j] = (signed char)(h & 0x7F);
+        m->slots[j] = *s;
+    }
+    m->growth_left -= m->count;
+    free(old_ctrl);
+    free(old_slots);
+    return 0;
+}
+
+/*
+ * Drop every tombstone without allocating. Full slots are first marked
+ * DELETED ("still to place") and free ones EMPTY; each marked entry then
+ * moves to the first free slot on its probe sequence. An entry whose own
+ * group comes first stays put; one whose target still holds a marked entry
+ * swaps with it, and the entry swapped in is placed next.
+ */
+static void swiss_sweep(MathiSwissMap *m)
+{
+    size_t cap = swiss_capacity(m);
+    for (size_t i = 0; i < cap; i++) m->ctrl[i] = m->ctrl[i] < 0 ? SWISS_EMPTY : SWISS_DELETED;
+
+    for (size_t i = 0; i < cap; i++) 
+    {
+        while (m->ctrl[i] == SWISS_DELETED) 
+        {
+            struct SwissSlot *s = &m->slots[i];
+            uint64_t h = swiss_hash(m, swiss_key(s), s->len);
+            signed char tag = (signed char)(h & 0x7F);
+            size_t j = swiss_find_free(m, h);
+            if (j / SWISS_GROUP == i / SWISS_GROUP) 
+            {
+                m->ctrl[i] = tag;
+            }
+            else if (m->ctrl[j] == SWISS_EMPTY) 
+            {
+                m->slots[j] = *s;
+                m->ctrl[j] = tag;
+                m->ctrl[i] = SWISS_EMPTY;
+            }
+            else 
+            {
+                struct SwissSlot tmp = m->slots[j];
+                m->slots[j] = *s;
+                *s = tmp;
+                m->ctrl[j] = tag;
+            }
+        }
+    }
+    m->growth_left = swiss_growth_limit(m) - m->count;
+}
+
+/**
+ * @brief Create a Swiss-table map from strings to void * values.
+ * @param capacity Expected number of entries (0 for one group).
+ * @param max_load Load factor that triggers growth; 0 selects SWISS_DEFAULT_LOAD.
+ * @return New map, or NULL on allocation failure.
+ */
+MathiSwissMap* mathi_swissmap_new(size_t capacity, double max_load) 
+{
+    MathiSwissMap *m = malloc(sizeof(MathiSwissMap));
+    if (!m) return NULL;
+    if (!(max_load > 0)) max_load = SWISS_DEFAULT_LOAD;
+    if (max_load < 0.25) max_load = 0.25;
+    if (max_load > 0.95) max_load = 0.95;
+    m->max_load = max_load;
+    m->seed = mathi_hash_seed();
+    m->count = 0;
+
+    size_t groups = 1;
+    while (groups < SIZE_MAX / (2 * SWISS_GROUP) &&
+           (double)(groups * SWISS_GROUP) * max_load < (double)capacity) 
+        groups *= 2;
+    if (swiss_alloc(m, groups) < 0) 
+    {
+        free(m);
+        return NULL;
+    }
+    return m;
+}
+
+/**
+ * @brief Insert or update a key. Keys longer than SWISS_INLINE_KEY bytes are copied to the heap.
+ * @return 0 on success, -1 on allocation failure (map unchanged).
+ */
+int mathi_swissmap_set(MathiSwissMap *m, const char *key, void *value) 
+{
+    size_t len = strlen(key);
+    uint64_t h = swiss_hash(m, key, len);
+    size_t i = swiss_find(m, key, len, h);
+    if (i != SIZE_MAX) 
+    {
+        m->slots[i].value = value;
+        return 0;
+    }
+
+    char *heap_key = NULL;
+    if (len > SWISS_INLINE_KEY) 
+    {
+        heap_key = malloc(len + 1);
+        if (!heap_key) return -1;
+        memcpy(heap_key, key, len + 1);
+    }
+
+    i = swiss_find_free(m, h);
+    if (m->ctrl[i] == SWISS_EMPTY && m->growth_left == 0) 
+    {
+        // Mostly tombstones: clean up in place; otherwise double.
+        if ((double)m->count < m->max_load * (double)swiss_capacity(m) / 2) swiss_sweep(m);
+        else if (swiss_rehash(m, 2 * (m->group_mask + 1)) < 0) 
+        {
+            free(heap_key);
+            return -1;
+        }
+        i = swiss_find_free(m, h);
+    }
+
+    if (m->ctrl[i] == SWISS_EMPTY) m->growth_left--;
+    m->ctrl[i] = (signed char)(h & 0x7F);
+    struct SwissSlot *s = &m->slots[i];
+    s->len = len;
+    if (heap_key) s->k.heap_key = heap_key;
+    else memcpy(s->k.inline_key, key, len + 1);
+    s->value = value;
+    m->count++;
+    return 0;
+}
+
+/**
+ * @brief Look up a key.
+ * @param value Receives the stored value when found (may be NULL).
+ * @return 1 if the key is present, 0 otherwise.
+ */
+int mathi_swissmap_get(const MathiSwissMap *m, const char *key, void **value) 
+{
+    size_t len = strlen(key);
+    size_t i = swiss_find(m, key, len, swiss_hash(m, key, len));
+    if (i == SIZE_MAX) return 0;
+    if (value) *value = m->slots[i].value;
+    return 1;
+}
+
+/**
+ * @brief Remove a key.
+ *
+ * The slot becomes EMPTY again when its group still has an EMPTY slot (no
+ * probe can have passed through a group that was never full); otherwise it
+ * becomes a tombstone until the next sweep or rehash.
+ *
+ * @param value Receives the removed value when found (may be NULL).
+ * @return 1 if the key was present, 0 otherwise.
+ */
+int mathi_swissmap_remove(MathiSwissMap *m, const char *key, void **value) 
+{
+    size_t len = strlen(key);
+    size_t i = swiss_find(m, key, len, swiss_hash(m, key, len));
+    if (i == SIZE_MAX) return 0;
+
+    struct SwissSlot *s = &m->slots[i];
+    if (value) *value = s->value;
+    if (s->len > SWISS_INLINE_KEY) free(s->k.heap_key);
+
+    const signed char *group = m->ctrl + (i & ~(size_t)(SWISS_GROUP - 1));
+    if (swiss_match(group, SWISS_EMPTY)) 
+    {
+        m->ctrl[i] = SWISS_EMPTY;
+        m->growth_left++;
+    }
+    else m->ctrl[i] = SWISS_DELETED;
+    m->count--;
+    return 1;
+}
+
+/**
+ * @brief Number of entries in the map.
+ */
+size_t mathi_swissmap_size(const MathiSwissMap *m) 
+{
+    return m->count;
+}
+
+/**
+ * @brief Iterate over the entries; *iter starts at 0.
+ * @return 1 with *key and *value set (either may be NULL), or 0 when done.
+ */
+int mathi_swissmap_next(const MathiSwissMap *m, size_t *iter, const char **key, void **value) 
+{
+    size_t cap = swiss_capacity(m);
+    for (; *iter < cap; (*iter)++) 
+    {
+        if (m->ctrl[*iter] < 0) continue;
+        const struct SwissSlot *s = &m->slots[*iter];
+        if (key) *key = swiss_key(s);
+        if (value) *value = s->value;
+        (*iter)++;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Free the map and its heap-allocated keys (not the values).
+ */
+void mathi_swissmap_free(MathiSwissMap *m) 
+{
+    if (!m) return;
+    size_t cap = swiss_capacity(m);
+    for (size_t i = 0; i < cap; i++) 
+        if (m->ctrl[i] >= 0 && m->slots[i].len > SWISS_INLINE_KEY) 
+            free(m->slots[i].k.heap_key);
+    free(m->ctrl);
+    free(m->slots);
+    free(m);
+}
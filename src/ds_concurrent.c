@@ -0,0 +1,553 @@
+/*
+ * Mathi C Library - Concurrent Data Structures
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#include "mathi/ds_concurrent.h"
+#include "mathi/hashx.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/membarrier.h>
+#endif
+
+/* Writer lock stripes (a power of two); a table never has fewer buckets than stripes. */
+#define CMAP_STRIPES 64
+
+/* Buckets a thread claims at a time while moving a table to its successor. */
+#define CMAP_MIGRATE_CHUNK 64
+
+/* Default average chain length that triggers growth. */
+#define CMAP_DEFAULT_LOAD 0.75
+
+/* Stripes and thread records are aligned to this to keep them off each other's cache lines. */
+#define CMAP_CACHE_LINE 64
+
+/* Retired pointers a thread collects between attempts to free them. */
+#define EPOCH_RECLAIM_BATCH 256
+
+/* ---------------------------------------------------------------------------
+ * Epoch-based reclamation
+ *
+ * A thread inside a map operation announces the global epoch it saw on
+ * entry. The global epoch advances only when every announcing thread has
+ * seen the current one. Memory unlinked during epoch e can no longer be
+ * reached by anyone once the epoch reaches e + 2, and is freed then by the
+ * thread that retired it. One registry serves every map in the process.
+ *
+ * The announcement must be visible before the thread reads any shared
+ * pointer. A fence on every entry would stop consecutive lookups from
+ * overlapping their cache misses, so on Linux entering costs only a
+ * compiler barrier and the rare epoch advance runs membarrier(), which
+ * makes every running thread of the process execute a full fence.
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+    void *ptr;
+    uint64_t epoch;  // global epoch when ptr was retired
+} EpochRetired;
+
+typedef struct EpochRecord {
+    _Alignas(CMAP_CACHE_LINE) atomic_uint_fast64_t active;  // (epoch << 1) | 1 inside an operation, 0 outside
+    atomic_int in_use;          // owned by a running thread
+    unsigned depth;             // nesting of epoch_enter
+    EpochRetired *retired;      // oldest first
+    size_t count, cap;
+    size_t next_scan;           // count at which to try freeing again
+    struct EpochRecord *next;   // registry link; records are reused, never unlinked
+} EpochRecord;
+
+static atomic_uint_fast64_t epoch_global = 1;
+static _Atomic(EpochRecord *) epoch_records;
+static _Thread_local EpochRecord *epoch_self;
+static pthread_key_t epoch_key;
+static pthread_once_t epoch_once = PTHREAD_ONCE_INIT;
+static int epoch_key_ok;
+static int epoch_membarrier;  // readers skip their fence; epoch_try_advance issues membarrier()
+
+/* Make every thread's announcement visible before the registry is scanned. */
+static void epoch_barrier(void)
+{
+#if defined(__linux__) && defined(__NR_membarrier)
+    if(epoch_membarrier && syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) == 0) return;
+#endif
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/* Advance the global epoch if every thread inside an operation has seen it. @return The global epoch. */
+static uint64_t epoch_try_advance(void)
+{
+    epoch_barrier();
+    uint64_t e = atomic_load(&epoch_global);
+    for(EpochRecord *r = atomic_load(&epoch_records); r; r = r->next)
+    {
+        uint64_t a = atomic_load(&r->active);
+        if((a & 1) && (a >> 1) != e) return e;
+    }
+    if(atomic_compare_exchange_strong(&epoch_global, &e, e + 1)) return e + 1;
+    return e;
+}
+
+/* Free the retired pointers nobody can reach any more. */
+static void epoch_reclaim(EpochRecord *r)
+{
+    uint64_t e = epoch_try_advance();
+    size_t done = 0;
+    while(done < r->count && r->retired[done].epoch + 2 <= e) free(r->retired[done++].ptr);
+    memmove(r->retired, r->retired + done, (r->count - done) * sizeof(EpochRetired));
+    r->count -= done;
+    r->next_scan = r->count + EPOCH_RECLAIM_BATCH;
+}
+
+/* Thread exit: free what can be freed and hand the record (with anything left) to the next thread. */
+static void epoch_thread_exit(void *arg)
+{
+    EpochRecord *r = arg;
+    r->depth = 0;
+    atomic_store(&r->active, 0);
+    epoch_reclaim(r);
+    epoch_self = NULL;
+    atomic_store_explicit(&r->in_use, 0, memory_order_release);
+}
+
+static void epoch_init(void)
+{
+    epoch_key_ok = pthread_key_create(&epoch_key, epoch_thread_exit) == 0;
+#if defined(__linux__) && defined(__NR_membarrier)
+    epoch_membarrier = syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+#endif
+}
+
+/* Claim a record left by an exited thread, or add a new one to the registry. */
+static EpochRecord* epoch_register(void)
+{
+    pthread_once(&epoch_once, epoch_init);
+
+    EpochRecord *r;
+    for(r = atomic_load(&epoch_records); r; r = r->next)
+    {
+        int unused = 0;
+        if(atomic_compare_exchange_strong(&r->in_use, &unused, 1)) break;
+    }
+    if(!r)
+    {
+        r = aligned_alloc(CMAP_CACHE_LINE, sizeof(EpochRecord));
+        if(!r) return NULL;
+        atomic_init(&r->active, 0);
+        atomic_init(&r->in_use, 1);
+        r->depth = 0;
+        r->retired = NULL;
+        r->count = r->cap = 0;
+        r->next_scan = EPOCH_RECLAIM_BATCH;
+        r->next = atomic_load(&epoch_records);
+        while(!atomic_compare_exchange_weak(&epoch_records, &r->next, r))
+            ;
+    }
+    if(epoch_key_ok) pthread_setspecific(epoch_key, r);
+    epoch_self = r;
+    return r;
+}
+
+/* Enter an operation (calls nest). @return The thread's record, or NULL if it cannot be registered. */
+static EpochRecord* epoch_enter(void)
+{
+    EpochRecord *r = epoch_self ? epoch_self : epoch_register();
+    if(r && r->depth++ == 0)
+    {
+        atomic_store_explicit(&r->active, (atomic_load(&epoch_global) << 1) | 1, memory_order_relaxed);
+        if(epoch_membarrier) atomic_signal_fence(memory_order_seq_cst);
+        else atomic_thread_fence(memory_order_seq_cst);
+    }
+    return r;
+}
+
+static void epoch_exit(EpochRecord *r)
+{
+    if(--r->depth == 0) atomic_store_explicit(&r->active, 0, memory_order_release);
+}
+
+/* Free ptr once no thread can still be reading it. ptr must already be unreachable. */
+static void epoch_retire(EpochRecord *r, void *ptr)
+{
+    if(r->count == r->cap)
+    {
+        size_t cap = r->cap ? 2 * r->cap : EPOCH_RECLAIM_BATCH;
+        EpochRetired *grown = realloc(r->retired, cap * sizeof(EpochRetired));
+        // Without room to defer the free, leaking is the only safe choice.
+        if(!grown) return;
+        r->retired = grown;
+        r->cap = cap;
+    }
+    // The unlink must be visible before the epoch is read, or a reader that found ptr
+    // could announce a later epoch than the one recorded.
+    atomic_thread_fence(memory_order_seq_cst);
+    r->retired[r->count].ptr = ptr;
+    r->retired[r->count++].epoch = atomic_load(&epoch_global);
+    if(r->count >= r->next_scan) epoch_reclaim(r);
+}
+
+/* ---------------------------------------------------------------------------
+ * Map
+ *
+ * Separate chaining over a power-of-two bucket array. Bucket b is guarded by
+ * stripe b % CMAP_STRIPES; since every table has at least CMAP_STRIPES
+ * buckets, that is also hash % CMAP_STRIPES, so a key keeps its stripe
+ * across resizes and a writer can lock it before knowing which table holds
+ * the key.
+ *
+ * Resizing relinks the existing nodes rather than copying them. Each node
+ * has two chain links, and consecutive tables use alternate ones, so moving
+ * a bucket into the successor leaves the old chain intact for lookups still
+ * walking it. A moved bucket's head becomes cmap_moved, which sends lookups
+ * and writers on to the successor. The next resize reuses the old table's
+ * links, so it waits until the epoch shows no thread can still be in the
+ * old table.
+ * ------------------------------------------------------------------------- */
+
+typedef struct CmapNode {
+    _Atomic(struct CmapNode *) next[2];  // chain links; a table uses next[table->link]
+    _Atomic(void *) value;
+    uint64_t hash;
+    char key[];
+} CmapNode;
+
+typedef struct CmapTable {
+    size_t mask;                          // buckets - 1
+    size_t stripe_limit;                  // entries in one stripe that trigger growth
+    unsigned link;                        // index into CmapNode.next
+    _Atomic(struct CmapTable *) next;     // successor being filled by a resize, or NULL
+    atomic_size_t claimed;                // buckets handed out to migrating threads
+    atomic_size_t moved;                  // buckets fully migrated
+    _Atomic(CmapNode *) buckets[];
+} CmapTable;
+
+typedef struct {
+    _Alignas(CMAP_CACHE_LINE) pthread_mutex_t lock;
+    atomic_size_t count;                  // entries whose hash falls in this stripe
+} CmapStripe;
+
+struct MathiCMap {
+    _Atomic(CmapTable *) table;           // current table
+    atomic_uint_fast64_t grow_epoch;      // global epoch from which the next resize may start
+    uint64_t seed;
+    double max_load;
+    CmapStripe stripes[CMAP_STRIPES];
+};
+
+/* Head of a bucket that has moved to the table's successor. */
+static CmapNode cmap_moved;
+
+static CmapTable* cmap_table_new(size_t buckets, unsigned link, double max_load)
+{
+    if(buckets > (SIZE_MAX - sizeof(CmapTable)) / sizeof(_Atomic(CmapNode *))) return NULL;
+    CmapTable *t = malloc(sizeof(CmapTable) + buckets * sizeof(_Atomic(CmapNode *)));
+    if(!t) return NULL;
+    t->mask = buckets - 1;
+    t->stripe_limit = (size_t)(buckets * max_load / CMAP_STRIPES) + 1;
+    t->link = link;
+    atomic_init(&t->next, NULL);
+    atomic_init(&t->claimed, 0);
+    atomic_init(&t->moved, 0);
+    for(size_t b = 0; b < buckets; b++) atomic_init(&t->buckets[b], NULL);
+    return t;
+}
+
+/* Table holding hash's bucket, following moved buckets; *head receives the bucket's first node. */
+static CmapTable* cmap_locate(CmapTable *t, uint64_t hash, CmapNode **head)
+{
+    for(;;)
+    {
+        CmapNode *n = atomic_load_explicit(&t->buckets[hash & t->mask], memory_order_acquire);
+        if(n != &cmap_moved)
+        {
+            *head = n;
+            return t;
+        }
+        t = atomic_load_explicit(&t->next, memory_order_acquire);
+    }
+}
+
+static CmapNode* cmap_chain_find(CmapNode *n, unsigned link, uint64_t hash, const char *key)
+{
+    for(; n; n = atomic_load_explicit(&n->next[link], memory_order_acquire))
+        if(n->hash == hash && strcmp(n->key, key) == 0) return n;
+    return NULL;
+}
+
+/*
+ * Move buckets of t into its successor, chunk by chunk, until none is left
+ * to claim or max_chunks chunks are done. Whoever moves the last bucket
+ * makes the successor current and retires t.
+ */
+static void cmap_migrate(MathiCMap *m, EpochRecord *r, CmapTable *t, size_t max_chunks)
+{
+    CmapTable *next = atomic_load_explicit(&t->next, memory_order_acquire);
+    size_t buckets = t->mask + 1;
+
+    for(size_t c = 0; c < max_chunks; c++)
+    {
+        size_t start = atomic_fetch_add(&t->claimed, CMAP_MIGRATE_CHUNK);
+        if(start >= buckets) return;
+        size_t end = buckets - start > CMAP_MIGRATE_CHUNK ? start + CMAP_MIGRATE_CHUNK : buckets;
+
+        for(size_t b = start; b < end; b++)
+        {
+            pthread_mutex_t *lock = &m->stripes[b & (CMAP_STRIPES - 1)].lock;
+            pthread_mutex_lock(lock);
+            // The successor's buckets b and b + buckets are private until b is marked moved.
+            CmapNode *n = atomic_load_explicit(&t->buckets[b], memory_order_relaxed);
+            while(n)
+            {
+                CmapNode *following = atomic_load_explicit(&n->next[t->link], memory_order_relaxed);
+                _Atomic(CmapNode *) *dst = &next->buckets[n->hash & next->mask];
+                atomic_store_explicit(&n->next[next->link], atomic_load_explicit(dst, memory_order_relaxed),
+                                      memory_order_relaxed);
+                atomic_store_explicit(dst, n, memory_order_relaxed);
+                n = following;
+            }
+            atomic_store_explicit(&t->buckets[b], &cmap_moved, memory_order_release);
+            pthread_mutex_unlock(lock);
+        }
+
+        if(atomic_fetch_add(&t->moved, end - start) + (end - start) == buckets)
+        {
+            atomic_store(&m->grow_epoch, UINT64_MAX);
+            atomic_store_explicit(&m->table, next, memory_order_release);
+            // Threads that loaded t announced at most this epoch; two advances see them out.
+            atomic_store(&m->grow_epoch, atomic_load(&epoch_global) + 2);
+            epoch_retire(r, t);
+            return;
+        }
+    }
+}
+
+/* Start doubling the table if stripe s has outgrown it. */
+static void cmap_maybe_grow(MathiCMap *m, EpochRecord *r, const CmapStripe *s)
+{
+    CmapTable *t = atomic_load_explicit(&m->table, memory_order_acquire);
+    if(atomic_load_explicit(&s->count, memory_order_relaxed) <= t->stripe_limit) return;
+    if(atomic_load_explicit(&t->next, memory_order_acquire)) return;
+    if(epoch_try_advance() < atomic_load(&m->grow_epoch)) return;
+
+    CmapTable *bigger = cmap_table_new(2 * (t->mask + 1), !t->link, m->max_load);
+    if(!bigger) return;
+    CmapTable *expected = NULL;
+    if(!atomic_compare_exchange_strong(&t->next, &expected, bigger))
+    {
+        free(bigger);
+        return;
+    }
+    cmap_migrate(m, r, t, SIZE_MAX);
+}
+
+/* Writers move one chunk of a resize in progress, so it finishes without stalling anyone. */
+static void cmap_help(MathiCMap *m, EpochRecord *r)
+{
+    CmapTable *t = atomic_load_explicit(&m->table, memory_order_acquire);
+    if(atomic_load_explicit(&t->next, memory_order_acquire)) cmap_migrate(m, r, t, 1);
+}
+
+/**
+ * @brief Create a map with at least CMAP_STRIPES buckets and room for capacity entries.
+ * @return New map, or NULL on allocation failure.
+ */
+MathiCMap* mathi_cmap_new(size_t capacity, double max_load)
+{
+    if(max_load <= 0) max_load = CMAP_DEFAULT_LOAD;
+    else if(max_load < 0.25) max_load = 0.25;
+    else if(max_load > 4) max_load = 4;
+
+    size_t buckets = CMAP_STRIPES;
+    while(buckets < capacity / max_load && buckets <= SIZE_MAX / 4) buckets *= 2;
+
+    MathiCMap *m = aligned_alloc(CMAP_CACHE_LINE, sizeof(MathiCMap));
+    if(!m) return NULL;
+    CmapTable *t = cmap_table_new(buckets, 0, max_load);
+    if(!t)
+    {
+        free(m);
+        return NULL;
+    }
+    atomic_init(&m->table, t);
+    atomic_init(&m->grow_epoch, 0);
+    m->seed = mathi_hash_seed();
+    m->max_load = max_load;
+    for(int i = 0; i < CMAP_STRIPES; i++)
+    {
+        pthread_mutex_init(&m->stripes[i].lock, NULL);
+        atomic_init(&m->stripes[i].count, 0);
+    }
+    return m;
+}
+
+/**
+ * @brief Insert or update under the key's stripe lock; an update is a single atomic store.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int mathi_cmap_set(MathiCMap *m, const char *key, void *value)
+{
+    if(!m || !key) return -1;
+    EpochRecord *r = epoch_enter();
+    if(!r) return -1;
+
+    uint64_t hash = mathi_hash_str(key, m->seed);
+    CmapStripe *s = &m->stripes[hash & (CMAP_STRIPES - 1)];
+    int rc = 0, inserted = 0;
+
+    pthread_mutex_lock(&s->lock);
+    CmapNode *head;
+    CmapTable *t = cmap_locate(atomic_load_explicit(&m->table, memory_order_acquire), hash, &head);
+    CmapNode *n = cmap_chain_find(head, t->link, hash, key);
+    if(n) atomic_store_explicit(&n->value, value, memory_order_release);
+    else
+    {
+        size_t len = strlen(key);
+        n = malloc(sizeof(CmapNode) + len + 1);
+        if(n)
+        {
+            memcpy(n->key, key, len + 1);
+            n->hash = hash;
+            atomic_init(&n->value, value);
+            atomic_init(&n->next[t->link], head);
+            atomic_init(&n->next[!t->link], NULL);
+            atomic_store_explicit(&t->buckets[hash & t->mask], n, memory_order_release);
+            atomic_fetch_add_explicit(&s->count, 1, memory_order_relaxed);
+            inserted = 1;
+        }
+        else rc = -1;
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    if(inserted) cmap_maybe_grow(m, r, s);
+    cmap_help(m, r);
+    epoch_exit(r);
+    return rc;
+}
+
+/**
+ * @brief Lock-free lookup: walks the key's chain inside an epoch.
+ * @return 1 if found, 0 if not (or if the thread could not be registered).
+ */
+int mathi_cmap_get(MathiCMap *m, const char *key, void **value)
+{
+    if(!m || !key) return 0;
+    EpochRecord *r = epoch_enter();
+    if(!r) return 0;
+
+    uint64_t hash = mathi_hash_str(key, m->seed);
+    CmapNode *head;
+    CmapTable *t = cmap_locate(atomic_load_explicit(&m->table, memory_order_acquire), hash, &head);
+    CmapNode *n = cmap_chain_find(head, t->link, hash, key);
+    if(n && value) *value = atomic_load_explicit(&n->value, memory_order_acquire);
+
+    epoch_exit(r);
+    return n != NULL;
+}
+
+/**
+ * @brief Unlink a key under its stripe lock; the node is freed once no reader can hold it.
+ * @return 1 if removed, 0 if absent.
+ */
+int mathi_cmap_remove(MathiCMap *m, const char *key, void **value)
+{
+    if(!m || !key) return 0;
+    EpochRecord *r = epoch_enter();
+    if(!r) return 0;
+
+    uint64_t hash = mathi_hash_str(key, m->seed);
+    CmapStripe *s = &m->stripes[hash & (CMAP_STRIPES - 1)];
+
+    pthread_mutex_lock(&s->lock);
+    CmapNode *n;
+    CmapTable *t = cmap_locate(atomic_load_explicit(&m->table, memory_order_acquire), hash, &n);
+    _Atomic(CmapNode *) *link = &t->buckets[hash & t->mask];
+    while(n && !(n->hash == hash && strcmp(n->key, key) == 0))
+    {
+        link = &n->next[t->link];
+        n = atomic_load_explicit(link, memory_order_relaxed);
+    }
+    if(n)
+    {
+        if(value) *value = atomic_load_explicit(&n->value, memory_order_relaxed);
+        atomic_store_explicit(link, atomic_load_explicit(&n->next[t->link], memory_order_relaxed),
+                              memory_order_release);
+        atomic_fetch_sub_explicit(&s->count, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    if(n) epoch_retire(r, n);
+    cmap_help(m, r);
+    epoch_exit(r);
+    return n != NULL;
+}
+
+/**
+ * @brief Sum of the per-stripe entry counts.
+ */
+size_t mathi_cmap_size(MathiCMap *m)
+{
+    if(!m) return 0;
+    size_t total = 0;
+    for(int i = 0; i < CMAP_STRIPES; i++)
+        total += atomic_load_explicit(&m->stripes[i].count, memory_order_relaxed);
+    return total;
+}
+
+/* Visit bucket b of t; a moved bucket was split into buckets b and b + size of the successor. */
+static void cmap_visit(CmapTable *t, size_t b, void (*fn)(const char *, void *, void *), void *ctx)
+{
+    CmapNode *n = atomic_load_explicit(&t->buckets[b], memory_order_acquire);
+    if(n == &cmap_moved)
+    {
+        CmapTable *next = atomic_load_explicit(&t->next, memory_order_acquire);
+        cmap_visit(next, b, fn, ctx);
+        cmap_visit(next, b + t->mask + 1, fn, ctx);
+        return;
+    }
+    for(; n; n = atomic_load_explicit(&n->next[t->link], memory_order_acquire))
+        fn(n->key, atomic_load_explicit(&n->value, memory_order_acquire), ctx);
+}
+
+/**
+ * @brief Walk every bucket of the current table inside one epoch.
+ */
+void mathi_cmap_foreach(MathiCMap *m, void (*fn)(const char *key, void *value, void *ctx), void *ctx)
+{
+    if(!m || !fn) return;
+    EpochRecord *r = epoch_enter();
+    if(!r) return;
+    CmapTable *t = atomic_load_explicit(&m->table, memory_order_acquire);
+    for(size_t b = 0; b <= t->mask; b++) cmap_visit(t, b, fn, ctx);
+    epoch_exit(r);
+}
+
+/**
+ * @brief Free the current table and its nodes. Every thread that claims
+ *        buckets of a resize moves them before returning, and the starting
+ *        thread claims whatever is left, so no resize outlives the calls
+ *        that took part in it and there is no successor to free.
+ */
+void mathi_cmap_free(MathiCMap *m)
+{
+    if(!m) return;
+    CmapTable *t = atomic_load(&m->table);
+    for(size_t b = 0; b <= t->mask; b++)
+    {
+        CmapNode *n = atomic_load(&t->buckets[b]);
+        while(n)
+        {
+            CmapNode *next = atomic_load(&n->next[t->link]);
+            free(n);
+            n = next;
+        }
+    }
+    free(t);
+    for(int i = 0; i < CMAP_STRIPES; i++) pthread_mutex_destroy(&m->stripes[i].lock);
+    free(m);
+}
@@ -0,0 +1,230 @@
+/*
+ * Mathi C Library - Hash Functions
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#include "mathi/hashx.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/* ---------------------------------------------------------------------------
+ * Little-endian loads (memcpy keeps them legal at any alignment)
+ * ------------------------------------------------------------------------- */
+
+static inline uint64_t load64(const unsigned char *p)
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint64_t load32(const unsigned char *p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+/* ---------------------------------------------------------------------------
+ * wyhash, final version 4 (Wang Yi), default secret
+ * ------------------------------------------------------------------------- */
+
+static const uint64_t hash_secret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+                                        0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+/* Full 64x64 -> 128 product: *a receives the low half, *b the high half. */
+static inline void mum(uint64_t *a, uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 r = (unsigned __int128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t a0 = (uint32_t)*a, a1 = *a >> 32, b0 = (uint32_t)*b, b1 = *b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *a = (mid << 32) | (uint32_t)p00;
+    *b = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
+
+/* Multiply and fold the two halves together. */
+static inline uint64_t mix(uint64_t a, uint64_t b)
+{
+    mum(&a, &b);
+    return a ^ b;
+}
+
+/**
+ * @brief Seeded 64-bit hash of len bytes.
+ *
+ * Short inputs are read as (possibly overlapping) 4- or 8-byte words so
+ * there is no byte loop; every length ends in one 128-bit multiply of two
+ * words against the running state.
+ */
+uint64_t mathi_hash64(const void *data, size_t len, uint64_t seed)
+{
+    const unsigned char *p = data;
+    uint64_t a, b;
+    seed ^= mix(seed ^ hash_secret[0], hash_secret[1]);
+
+    if(len <= 16)
+    {
+        if(len >= 4)
+        {
+            size_t mid = (len >> 3) << 2;
+            a = (load32(p) << 32) | load32(p + mid);
+            b = (load32(p + len - 4) << 32) | load32(p + len - 4 - mid);
+        }
+        else if(len > 0)
+        {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        }
+        else a = b = 0;
+    }
+    else
+    {
+        size_t i = len;
+        if(i >= 48)
+        {
+            uint64_t lane1 = seed, lane2 = seed;
+            do
+            {
+                seed = mix(load64(p) ^ hash_secret[1], load64(p + 8) ^ seed);
+                lane1 = mix(load64(p + 16) ^ hash_secret[2], load64(p + 24) ^ lane1);
+                lane2 = mix(load64(p + 32) ^ hash_secret[3], load64(p + 40) ^ lane2);
+                p += 48;
+                i -= 48;
+            } while(i >= 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while(i > 16)
+        {
+            seed = mix(load64(p) ^ hash_secret[1], load64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        // The last 16 bytes of the input, overlapping what was already mixed if need be.
+        a = load64(p + i - 16);
+        b = load64(p + i - 8);
+    }
+
+    a ^= hash_secret[1];
+    b ^= seed;
+    mum(&a, &b);
+    return mix(a ^ hash_secret[0] ^ len, b ^ hash_secret[1]);
+}
+
+/**
+ * @brief Seeded 64-bit hash of a null-terminated string.
+ */
+uint64_t mathi_hash_str(const char *s, uint64_t seed)
+{
+    return mathi_hash64(s, strlen(s), seed);
+}
+
+/* ---------------------------------------------------------------------------
+ * SipHash (Aumasson & Bernstein)
+ * ------------------------------------------------------------------------- */
+
+static inline uint64_t rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+#define SIP_ROUND(v0, v1, v2, v3)                                  \
+    do                                                             \
+    {                                                              \
+        v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32); \
+        v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;                     \
+        v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;                     \
+        v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32); \
+    } while(0)
+
+/* SipHash-c-d: c rounds per 8-byte block, d rounds of finalisation. */
+static uint64_t siphash(const unsigned char *p, size_t len, uint64_t k0, uint64_t k1, int c, int d)
+{
+    uint64_t v0 = 0x736f6d6570736575ull ^ k0, v1 = 0x646f72616e646f6dull ^ k1;
+    uint64_t v2 = 0x6c7967656e657261ull ^ k0, v3 = 0x7465646279746573ull ^ k1;
+
+    const unsigned char *end = p + (len & ~(size_t)7);
+    for(; p < end; p += 8)
+    {
+        uint64_t m = load64(p);
+        v3 ^= m;
+        for(int r = 0; r < c; r++) SIP_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    // Final block: the remaining bytes with the length in the top byte.
+    uint64_t m = (uint64_t)len << 56;
+    for(size_t i = 0; i < (len & 7); i++) m |= (uint64_t)p[i] << (8 * i);
+    v3 ^= m;
+    for(int r = 0; r < c; r++) SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= m;
+
+    v2 ^= 0xff;
+    for(int r = 0; r < d; r++) SIP_ROUND(v0, v1, v2, v3);
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/**
+ * @brief SipHash-1-3 of len bytes under the 128-bit key (k0, k1).
+ */
+uint64_t mathi_siphash13(const void *data, size_t len, uint64_t k0, uint64_t k1)
+{
+    return siphash(data, len, k0, k1, 1, 3);
+}
+
+/**
+ * @brief SipHash-2-4 of len bytes under the 128-bit key (k0, k1).
+ */
+uint64_t mathi_siphash24(const void *data, size_t len, uint64_t k0, uint64_t k1)
+{
+    return siphash(data, len, k0, k1, 2, 4);
+}
+
+/* ---------------------------------------------------------------------------
+ * Per-table seeds
+ * ------------------------------------------------------------------------- */
+
+static uint64_t seed_secret;
+static pthread_once_t seed_once = PTHREAD_ONCE_INIT;
+static atomic_uint_fast64_t seed_counter;
+
+/* Read the process secret from /dev/urandom; without it, mix the clock and ASLR'd addresses. */
+static void seed_init(void)
+{
+    FILE *f = fopen("/dev/urandom", "rb");
+    int ok = f && fread(&seed_secret, sizeof(seed_secret), 1, f) == 1;
+    if(f) fclose(f);
+    if(ok) return;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    int local;
+    seed_secret = mix((uint64_t)ts.tv_sec ^ hash_secret[0], (uint64_t)ts.tv_nsec ^ hash_secret[1]);
+    seed_secret = mix(seed_secret ^ (uint64_t)(uintptr_t)&local,
+                      (uint64_t)(uintptr_t)&seed_secret ^ hash_secret[2]);
+}
+
+/**
+ * @brief Random seed for one hash table: the process secret mixed with a call counter.
+ */
+uint64_t mathi_hash_seed(void)
+{
+    pthread_once(&seed_once, seed_init);
+    uint64_t n = atomic_fetch_add_explicit(&seed_counter, 1, memory_order_relaxed);
+    return mix(seed_secret ^ hash_secret[3], (n + 1) * 0x9E3779B97F4A7C15ull);
+}
@@ -0,0 +1,12 @@
+/*
+ * Mathi C Library - Integer Hash Maps and Sets
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#include "mathi/intmap.h"
+
+MATHI_INTMAP_DEFINE(MathiI32Map, mathi_i32map, int32_t, int64_t)
+MATHI_INTMAP_DEFINE(MathiI64Map, mathi_i64map, int64_t, int64_t)
+MATHI_INTSET_DEFINE(MathiI32Set, mathi_i32set, int32_t)
+MATHI_INTSET_DEFINE(MathiI64Set, mathi_i64set, int64_t)
@@ -0,0 +1,29 @@
+/*
+ * Mathi C Library - Internal helpers shared by the library sources
+ * mathi_internal.h
+ *
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ *
+ * Not installed and not part of the public API.
+ */
+
+#ifndef MATHI_INTERNAL_H
+#define MATHI_INTERNAL_H
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+/* Compile one function for AVX2; callers dispatch to it only when mathi_cpu_has_avx2() is true. */
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+/* threads if positive, else the number of online CPUs (at least 1). Defined in sys.c. */
+int mathi_default_threads(int threads);
+
+/*
+ * Call fn(ctx, i) for every slice i in [0, nslices) and return once all have
+ * finished. Slices 1.. get a thread each; slice 0 runs on the calling thread,
+ * as does any slice whose thread fails to start. Defined in sys.c.
+ */
+void mathi_run_slices(void (*fn)(void *ctx, int slice), void *ctx, int nslices);
+
+#endif // MATHI_INTERNAL_H
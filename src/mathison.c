@@ -9,6 +9,8 @@
 */
 
 #include "mathi/mathison.h"
+#include "mathi/vec.h"
+#include "mathi/hashx.h"
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
@@ -24,6 +26,10 @@ MathiJSON* mathison_new_object()
     json->data.object.keys = NULL;
     json->data.object.values = NULL;
     json->data.object.count = 0;
+    json->data.object.capacity = 0;
+    json->data.object.index = NULL;
+    json->data.object.index_cap = 0;
+    json->data.object.seed = 0;
     return json;
 }
 
@@ -35,6 +41,7 @@ MathiJSON* mathison_new_array()
     json->type = JSON_ARRAY;
     json->data.array.items = NULL;
     json->data.array.count = 0;
+    json->data.array.capacity = 0;
     return json;
 }
 
@@ -114,6 +121,7 @@ int mathison_free(MathiJSON *json)
             }
             free(json->data.object.keys);
             free(json->data.object.values);
+            free(json->data.object.index);
             break;
 
         default:
@@ -136,6 +144,7 @@ int mathison_clear(MathiJSON *json_obj)
         free(json_obj->data.array.items);
         json_obj->data.array.items = NULL;
         json_obj->data.array.count = 0;
+        json_obj->data.array.capacity = 0;
     } 
     else if (json_obj->type == JSON_OBJECT) 
     {
@@ -146,9 +155,13 @@ int mathison_clear(MathiJSON *json_obj)
         }
         free(json_obj->data.object.keys);
         free(json_obj->data.object.values);
+        free(json_obj->data.object.index);
         json_obj->data.object.keys = NULL;
         json_obj->data.object.values = NULL;
+        json_obj->data.object.index = NULL;
         json_obj->data.object.count = 0;
+        json_obj->data.object.capacity = 0;
+        json_obj->data.object.index_cap = 0;
     }
     return 0;
 }
@@ -162,16 +175,76 @@ bool mathison_is_bool(MathiJSON *json_obj) { return json_obj && json_obj->type =
 bool mathison_is_null(MathiJSON *json_obj) { return json_obj && json_obj->type == JSON_NULL; }
 
 
+// Grow an array's item buffer geometrically (amortised O(1) appends)
+static int json_array_reserve(MathiJSON *json_array, size_t need)
+{
+    return mathi_vec_reserve_raw(&json_array->data.array.items, json_array->data.array.count,
+                                 &json_array->data.array.capacity, need, sizeof(MathiJSON*), NULL, NULL);
+}
+
+// Grow an object's parallel key and value buffers to the same capacity
+static int json_object_reserve(MathiJSON *json_obj, size_t need)
+{
+    size_t n = json_obj->data.object.count;
+    size_t key_cap = json_obj->data.object.capacity, value_cap = key_cap;
+    if (mathi_vec_reserve_raw(&json_obj->data.object.keys, n, &key_cap, need, sizeof(char*), NULL, NULL) != 0) return -1;
+    if (mathi_vec_reserve_raw(&json_obj->data.object.values, n, &value_cap, need, sizeof(MathiJSON*), NULL, NULL) != 0) return -1;
+    json_obj->data.object.capacity = value_cap;
+    return 0;
+}
+
+/* Objects with at least this many keys get a hash index; smaller ones are scanned linearly. */
+#define JSON_INDEX_MIN 8
+
+// Record key position pos in the index (linear probing; the index is at most half full)
+static void json_index_insert(MathiJSON *json_obj, size_t pos)
+{
+    size_t mask = json_obj->data.object.index_cap - 1;
+    size_t i = (size_t)mathi_hash_str(json_obj->data.object.keys[pos], json_obj->data.object.seed) & mask;
+    while (json_obj->data.object.index[i]) i = (i + 1) & mask;
+    json_obj->data.object.index[i] = pos + 1;
+}
+
+// (Re)build the index over every key; without memory the object just falls back to scanning
+static void json_index_build(MathiJSON *json_obj)
+{
+    size_t n = json_obj->data.object.count, cap = 16;
+    while (cap < 2 * n + 2) cap *= 2;
+    free(json_obj->data.object.index);
+    json_obj->data.object.index = calloc(cap, sizeof(size_t));
+    json_obj->data.object.index_cap = json_obj->data.object.index ? cap : 0;
+    if (!json_obj->data.object.index) return;
+    if (!json_obj->data.object.seed) json_obj->data.object.seed = mathi_hash_seed();
+    for (size_t i = 0; i < n; i++) json_index_insert(json_obj, i);
+}
+
+// Position of key in the object, or count when it is absent. Only reads the object:
+// the index is maintained by the writers, and lookups scan while it is NULL.
+static size_t json_object_find(MathiJSON *json_obj, const char *key)
+{
+    size_t n = json_obj->data.object.count;
+    if (json_obj->data.object.index) 
+    {
+        size_t mask = json_obj->data.object.index_cap - 1;
+        size_t i = (size_t)mathi_hash_str(key, json_obj->data.object.seed) & mask;
+        for (; json_obj->data.object.index[i]; i = (i + 1) & mask) 
+        {
+            size_t pos = json_obj->data.object.index[i] - 1;
+            if (strcmp(json_obj->data.object.keys[pos], key) == 0) return pos;
+        }
+        return n;
+    }
+    for (size_t i = 0; i < n; i++)
+        if (strcmp(json_obj->data.object.keys[i], key) == 0) return i;
+    return n;
+}
+
 // Append a value to a JSON array
 int mathison_append_array(MathiJSON *json_array, MathiJSON *value) 
 {
     if (!json_array || json_array->type != JSON_ARRAY || !value) return -1;
-    size_t n = json_array->data.array.count;
-    MathiJSON **new_items = realloc(json_array->data.array.items, (n + 1) * sizeof(MathiJSON*));
-    if (!new_items) return -1;
-    new_items[n] = value;
-    json_array->data.array.items = new_items;
-    json_array->data.array.count++;
+    if (json_array_reserve(json_array, json_array->data.array.count + 1) != 0) return -1;
+    json_array->data.array.items[json_array->data.array.count++] = value;
     return 0;
 }
 
@@ -207,28 +280,27 @@ int mathison_set_value(MathiJSON *json_obj, const char *key, MathiJSON *value)
     if (!json_obj || json_obj->type != JSON_OBJECT || !key || !value) return -1;
 
     // Replace value if key exists
-    for (size_t i = 0; i < json_obj->data.object.count; i++) 
+    size_t i = json_object_find(json_obj, key);
+    if (i < json_obj->data.object.count) 
     {
-        if (strcmp(json_obj->data.object.keys[i], key) == 0) 
-        {
-            mathison_free(json_obj->data.object.values[i]);
-            json_obj->data.object.values[i] = value;
-            return 0;
-        }
+        mathison_free(json_obj->data.object.values[i]);
+        json_obj->data.object.values[i] = value;
+        return 0;
     }
 
     // Key doesn't exist, append
     size_t n = json_obj->data.object.count;
-    char **new_keys = realloc(json_obj->data.object.keys, (n + 1) * sizeof(char*));
-    MathiJSON **new_values = realloc(json_obj->data.object.values, (n + 1) * sizeof(MathiJSON*));
-    if (!new_keys || !new_values) return -1;
-
-    new_keys[n] = strdup(key);
-    new_values[n] = value;
+    if (json_object_reserve(json_obj, n + 1) != 0) return -1;
+    char *key_copy = strdup(key);
+    if (!key_copy) return -1;
 
-    json_obj->data.object.keys = new_keys;
-    json_obj->data.object.values = new_values;
+    json_obj->data.object.keys[n] = key_copy;
+    json_obj->data.object.values[n] = value;
     json_obj->data.object.count++;
+    if (json_obj->data.object.index && 2 * json_obj->data.object.count + 2 <= json_obj->data.object.index_cap)
+        json_index_insert(json_obj, n);
+    else if (json_obj->data.object.count >= JSON_INDEX_MIN)
+        json_index_build(json_obj);
     return 0;
 }
 
@@ -236,57 +308,51 @@ int mathison_set_value(MathiJSON *json_obj, const char *key, MathiJSON *value)
 int mathison_get_value(MathiJSON *json_obj, const char *key, MathiJSON **value) 
 {
     if (!json_obj || json_obj->type != JSON_OBJECT || !key || !value) return -1;
-    for (size_t i = 0; i < json_obj->data.object.count; i++) 
-    {
-        if (strcmp(json_obj->data.object.keys[i], key) == 0) 
-        {
-            *value = json_obj->data.object.values[i];
-            return 0;
-        }
-    }
-    return -1;
+    size_t i = json_object_find(json_obj, key);
+    if (i == json_obj->data.object.count) return -1;
+    *value = json_obj->data.object.values[i];
+    return 0;
 }
 
 // Remove a key/value pair from object
 int mathison_remove_key(MathiJSON *json_obj, const char *key) 
 {
     if (!json_obj || json_obj->type != JSON_OBJECT || !key) return -1;
-    for (size_t i = 0; i < json_obj->data.object.count; i++) 
+    size_t i = json_object_find(json_obj, key);
+    if (i == json_obj->data.object.count) return -1;
+
+    free(json_obj->data.object.keys[i]);
+    mathison_free(json_obj->data.object.values[i]);
+    for (size_t j = i; j < json_obj->data.object.count - 1; j++) 
     {
-        if (strcmp(json_obj->data.object.keys[i], key) == 0) 
-        {
-            free(json_obj->data.object.keys[i]);
-            mathison_free(json_obj->data.object.values[i]);
-            for (size_t j = i; j < json_obj->data.object.count - 1; j++) 
-            {
-                json_obj->data.object.keys[j] = json_obj->data.object.keys[j+1];
-                json_obj->data.object.values[j] = json_obj->data.object.values[j+1];
-            }
-            json_obj->data.object.count--;
-            if (json_obj->data.object.count == 0) 
-            {
-                free(json_obj->data.object.keys);
-                free(json_obj->data.object.values);
-                json_obj->data.object.keys = NULL;
-                json_obj->data.object.values = NULL;
-            } 
-            else 
-            {
-                json_obj->data.object.keys = realloc(json_obj->data.object.keys, json_obj->data.object.count * sizeof(char*));
-                json_obj->data.object.values = realloc(json_obj->data.object.values, json_obj->data.object.count * sizeof(MathiJSON*));
-            }
-            return 0;
-        }
+        json_obj->data.object.keys[j] = json_obj->data.object.keys[j+1];
+        json_obj->data.object.values[j] = json_obj->data.object.values[j+1];
     }
-    return -1;
+    json_obj->data.object.count--;
+
+    // Later positions moved down, so the index is rebuilt over the remaining keys
+    if (json_obj->data.object.count >= JSON_INDEX_MIN) json_index_build(json_obj);
+    else 
+    {
+        free(json_obj->data.object.index);
+        json_obj->data.object.index = NULL;
+        json_obj->data.object.index_cap = 0;
+    }
+    if (json_obj->data.object.count == 0) 
+    {
+        free(json_obj->data.object.keys);
+        free(json_obj->data.object.values);
+        json_obj->data.object.keys = NULL;
+        json_obj->data.object.values = NULL;
+        json_obj->data.object.capacity = 0;
+    } 
+    return 0;
 }
 
 // Check if a key exists
 bool mathison_has_key(MathiJSON *json_obj, const char *key) {
     if (!json_obj || json_obj->type != JSON_OBJECT || !key) return false;
-    for (size_t i = 0; i < json_obj->data.object.count; i++)
-        if (strcmp(json_obj->data.object.keys[i], key) == 0) return true;
-    return false;
+    return json_object_find(json_obj, key) < json_obj->data.object.count;
 }
 
 int mathison_parse(const char *str, MathiJSON **json_obj, const char **endptr)
@@ -480,11 +546,10 @@ int mathison_prepend_array(MathiJSON *json_array, MathiJSON *value)
 {
     if (!json_array || json_array->type != JSON_ARRAY || !value) return -1;
     size_t n = json_array->data.array.count;
-    MathiJSON **new_items = realloc(json_array->data.array.items, (n + 1) * sizeof(MathiJSON*));
-    if (!new_items) return -1;
-    for (size_t i = n; i > 0; i--) new_items[i] = new_items[i-1]; // shift right
-    new_items[0] = value;
-    json_array->data.array.items = new_items;
+    if (json_array_reserve(json_array, n + 1) != 0) return -1;
+    MathiJSON **items = json_array->data.array.items;
+    memmove(items + 1, items, n * sizeof(MathiJSON*)); // shift right
+    items[0] = value;
     json_array->data.array.count++;
     return 0;
 }
@@ -495,11 +560,10 @@ int mathison_insert_array(MathiJSON *json_array, size_t index, MathiJSON *value)
     if (!json_array || json_array->type != JSON_ARRAY || !value) return -1;
     size_t n = json_array->data.array.count;
     if (index > n) return -1;
-    MathiJSON **new_items = realloc(json_array->data.array.items, (n + 1) * sizeof(MathiJSON*));
-    if (!new_items) return -1;
-    for (size_t i = n; i > index; i--) new_items[i] = new_items[i-1];
-    new_items[index] = value;
-    json_array->data.array.items = new_items;
+    if (json_array_reserve(json_array, n + 1) != 0) return -1;
+    MathiJSON **items = json_array->data.array.items;
+    memmove(items + index + 1, items + index, (n - index) * sizeof(MathiJSON*));
+    items[index] = value;
     json_array->data.array.count++;
     return 0;
 }
@@ -517,11 +581,8 @@ int mathison_remove_array_index(MathiJSON *json_array, size_t index)
     {
         free(json_array->data.array.items);
         json_array->data.array.items = NULL;
+        json_array->data.array.capacity = 0;
     } 
-    else 
-    {
-        json_array->data.array.items = realloc(json_array->data.array.items, json_array->data.array.count * sizeof(MathiJSON*));
-    }
     return 0;
 }
 
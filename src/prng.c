@@ -0,0 +1,307 @@
+/*
+ * Mathi C Library - Pseudo-Random Number Generators
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#include "mathi/prng.h"
+#include <stdint.h>
+
+/* 128-bit unsigned arithmetic for PCG64 and 64-bit Lemire reduction; native where the compiler has it. */
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 u128;
+#define U128(hi, lo) (((u128)(hi) << 64) | (lo))
+#define U128_HI(x) ((uint64_t)((x) >> 64))
+#define U128_LO(x) ((uint64_t)(x))
+#define u128_add(a, b) ((a) + (b))
+#define u128_mul(a, b) ((a) * (b))
+#define u128_mul64(a, b) ((u128)(a) * (b))
+#else
+typedef struct { uint64_t hi, lo; } u128;
+
+static u128 U128(uint64_t hi, uint64_t lo)
+{
+    u128 r = {hi, lo};
+    return r;
+}
+#define U128_HI(x) ((x).hi)
+#define U128_LO(x) ((x).lo)
+
+static u128 u128_add(u128 a, u128 b)
+{
+    u128 r = {a.hi + b.hi, a.lo + b.lo};
+    r.hi += r.lo < a.lo;
+    return r;
+}
+
+/* Full 64x64 -> 128 product from 32-bit halves. */
+static u128 u128_mul64(uint64_t a, uint64_t b)
+{
+    uint64_t a0 = (uint32_t)a, a1 = a >> 32, b0 = (uint32_t)b, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    u128 r = {p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32), (mid << 32) | (uint32_t)p00};
+    return r;
+}
+
+/* Product modulo 2^128. */
+static u128 u128_mul(u128 a, u128 b)
+{
+    u128 r = u128_mul64(a.lo, b.lo);
+    r.hi += a.hi * b.lo + a.lo * b.hi;
+    return r;
+}
+#endif
+
+/* ---------------------------------------------------------------------------
+ * xoshiro256** (Blackman & Vigna)
+ * ------------------------------------------------------------------------- */
+
+static inline uint64_t rotl64(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Seed a xoshiro256** generator.
+ *
+ * The four state words come from splitmix64(seed), as recommended by the
+ * xoshiro authors; splitmix64 never yields an all-zero state.
+ *
+ * @param rng Generator to initialise.
+ * @param seed Any 64-bit value.
+ */
+void mathi_xoshiro256_seed(MathiXoshiro256 *rng, uint64_t seed)
+{
+    for(int i = 0; i < 4; i++) rng->s[i] = splitmix64(&seed);
+}
+
+/**
+ * @brief Next 64-bit output of a xoshiro256** generator.
+ * @param rng Generator state.
+ * @return Uniform 64-bit value.
+ */
+uint64_t mathi_xoshiro256_next(MathiXoshiro256 *rng)
+{
+    uint64_t *s = rng->s;
+    uint64_t result = rotl64(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl64(s[3], 45);
+
+    return result;
+}
+
+/* Apply a precomputed jump polynomial: the state becomes the XOR of the states at its set bits. */
+static void xoshiro256_apply_jump(MathiXoshiro256 *rng, const uint64_t poly[4])
+{
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for(int i = 0; i < 4; i++)
+        for(int b = 0; b < 64; b++)
+        {
+            if(poly[i] & (1ull << b))
+            {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            mathi_xoshiro256_next(rng);
+        }
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+/**
+ * @brief Advance a xoshiro256** generator by 2^128 steps.
+ * @param rng Generator state.
+ */
+void mathi_xoshiro256_jump(MathiXoshiro256 *rng)
+{
+    static const uint64_t poly[4] = {0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+                                     0xa9582618e03fc9aaull, 0x39abdc4529b1661cull};
+    xoshiro256_apply_jump(rng, poly);
+}
+
+/**
+ * @brief Advance a xoshiro256** generator by 2^192 steps.
+ * @param rng Generator state.
+ */
+void mathi_xoshiro256_long_jump(MathiXoshiro256 *rng)
+{
+    static const uint64_t poly[4] = {0x76e15d3efefdcbbfull, 0xc5004e441c522fb3ull,
+                                     0x77710069854ee241ull, 0x39109bb02acbe635ull};
+    xoshiro256_apply_jump(rng, poly);
+}
+
+/*
+ * Lemire's nearly divisionless bounded integer: the high word of x * bound is
+ * uniform in [0, bound) once the few low words below 2^64 mod bound are
+ * rejected. The modulo only runs when a rejection is possible at all.
+ */
+#define DEFINE_BOUNDED(name, rng_type, next)                          \
+uint64_t name(rng_type *rng, uint64_t bound)                          \
+{                                                                     \
+    if(bound == 0) return 0;                                          \
+    u128 m = u128_mul64(next(rng), bound);                            \
+    if(U128_LO(m) < bound)                                            \
+    {                                                                 \
+        uint64_t threshold = (0 - bound) % bound;                     \
+        while(U128_LO(m) < threshold) m = u128_mul64(next(rng), bound); \
+    }                                                                 \
+    return U128_HI(m);                                                \
+}
+
+/**
+ * @brief Unbiased integer in [0, bound) from a xoshiro256** generator.
+ * @param rng Generator state.
+ * @param bound Exclusive upper bound; 0 returns 0.
+ * @return Uniform value below bound.
+ */
+DEFINE_BOUNDED(mathi_xoshiro256_bounded, MathiXoshiro256, mathi_xoshiro256_next)
+
+/**
+ * @brief Uniform double in [0, 1) from the top 53 bits of one output.
+ * @param rng Generator state.
+ * @return Value in [0, 1).
+ */
+double mathi_xoshiro256_double(MathiXoshiro256 *rng)
+{
+    return (mathi_xoshiro256_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* ---------------------------------------------------------------------------
+ * PCG64, XSL-RR 128/64 output over a 128-bit LCG (O'Neill)
+ * ------------------------------------------------------------------------- */
+
+#define PCG64_MULT_HI 0x2360ED051FC65DA4ull
+#define PCG64_MULT_LO 0x4385DF649FCCF645ull
+
+static inline u128 pcg64_state(const MathiPcg64 *rng)
+{
+    return U128(rng->state_hi, rng->state_lo);
+}
+
+static inline void pcg64_set_state(MathiPcg64 *rng, u128 state)
+{
+    rng->state_hi = U128_HI(state);
+    rng->state_lo = U128_LO(state);
+}
+
+static inline void pcg64_step(MathiPcg64 *rng)
+{
+    u128 state = u128_add(u128_mul(pcg64_state(rng), U128(PCG64_MULT_HI, PCG64_MULT_LO)),
+                          U128(rng->inc_hi, rng->inc_lo));
+    pcg64_set_state(rng, state);
+}
+
+/**
+ * @brief Seed a PCG64 generator.
+ *
+ * Follows pcg64_srandom_r with seed and stream zero-extended to 128 bits,
+ * so the output matches the reference implementation.
+ *
+ * @param rng Generator to initialise.
+ * @param seed Initial state.
+ * @param stream Stream selector.
+ */
+void mathi_pcg64_seed(MathiPcg64 *rng, uint64_t seed, uint64_t stream)
+{
+    rng->state_hi = rng->state_lo = 0;
+    rng->inc_hi = stream >> 63;
+    rng->inc_lo = (stream << 1) | 1;
+    pcg64_step(rng);
+    pcg64_set_state(rng, u128_add(pcg64_state(rng), U128(0, seed)));
+    pcg64_step(rng);
+}
+
+/**
+ * @brief Next 64-bit output of a PCG64 generator.
+ * @param rng Generator state.
+ * @return Uniform 64-bit value.
+ */
+uint64_t mathi_pcg64_next(MathiPcg64 *rng)
+{
+    pcg64_step(rng);
+    uint64_t x = rng->state_hi ^ rng->state_lo;
+    unsigned rot = (unsigned)(rng->state_hi >> 58);
+    return (x >> rot) | (x << ((64 - rot) & 63));
+}
+
+/*
+ * Jump the LCG by delta steps (Brown, "Random number generation with
+ * arbitrary strides"): square-and-multiply on the affine map
+ * x -> mult * x + inc.
+ */
+static void pcg64_advance128(MathiPcg64 *rng, u128 delta)
+{
+    u128 cur_mult = U128(PCG64_MULT_HI, PCG64_MULT_LO), cur_plus = U128(rng->inc_hi, rng->inc_lo);
+    u128 acc_mult = U128(0, 1), acc_plus = U128(0, 0);
+    uint64_t hi = U128_HI(delta), lo = U128_LO(delta);
+
+    while(hi | lo)
+    {
+        if(lo & 1)
+        {
+            acc_mult = u128_mul(acc_mult, cur_mult);
+            acc_plus = u128_add(u128_mul(acc_plus, cur_mult), cur_plus);
+        }
+        cur_plus = u128_mul(u128_add(cur_mult, U128(0, 1)), cur_plus);
+        cur_mult = u128_mul(cur_mult, cur_mult);
+        lo = (lo >> 1) | (hi << 63);
+        hi >>= 1;
+    }
+    pcg64_set_state(rng, u128_add(u128_mul(acc_mult, pcg64_state(rng)), acc_plus));
+}
+
+/**
+ * @brief Advance a PCG64 generator by delta steps in O(log delta).
+ * @param rng Generator state.
+ * @param delta Number of outputs to skip.
+ */
+void mathi_pcg64_advance(MathiPcg64 *rng, uint64_t delta)
+{
+    pcg64_advance128(rng, U128(0, delta));
+}
+
+/**
+ * @brief Advance a PCG64 generator by 2^64 steps.
+ * @param rng Generator state.
+ */
+void mathi_pcg64_jump(MathiPcg64 *rng)
+{
+    pcg64_advance128(rng, U128(1, 0));
+}
+
+/**
+ * @brief Unbiased integer in [0, bound) from a PCG64 generator.
+ * @param rng Generator state.
+ * @param bound Exclusive upper bound; 0 returns 0.
+ * @return Uniform value below bound.
+ */
+DEFINE_BOUNDED(mathi_pcg64_bounded, MathiPcg64, mathi_pcg64_next)
+
+/**
+ * @brief Uniform double in [0, 1) from the top 53 bits of one output.
+ * @param rng Generator state.
+ * @return Value in [0, 1).
+ */
+double mathi_pcg64_double(MathiPcg64 *rng)
+{
+    return (mathi_pcg64_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
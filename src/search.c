@@ -6,20 +6,29 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "mathi/search.h"
+#include "mathi/array.h"
+#include "mathi/filex.h"
+#include "mathi/sys.h"
+#include "mathi_internal.h"
 
 /**
  * @brief Perform linear search on an integer array.
+ *
+ * The scan is the vectorised mathi_arr_index kernel.
+ *
  * @param arr Pointer to the array.
  * @param n Number of elements in the array.
  * @param key Value to search for.
  * @return Index of the key if found, -1 otherwise.
  */
-int mathi_linear_search(int *arr, int n, int key)
+int mathi_linear_search(const int *arr, size_t n, int key)
 {
-    for(int i = 0; i < n; i++) 
-        if(arr[i] == key) return i;
-    return -1;
+    return mathi_arr_index(arr, n, key);
 }
 
 /**
@@ -94,4 +103,643 @@ int mathi_interpolation_search(int *arr, int n, int key)
         else high = pos - 1;
     }
     return -1;
-}
\ No newline at end of file
+}
+
+/* Alignment of the Eytzinger key array: one cache line. */
+#define SEARCH_INDEX_ALIGN 64
+
+/* Keys per cache line; descending prefetches this many levels' worth ahead. */
+#define SEARCH_INDEX_LINE_KEYS (SEARCH_INDEX_ALIGN / (int)sizeof(int))
+
+/**
+ * @brief Lay sorted[] out in Eytzinger order by an in-order walk of the implicit tree.
+ * @return Next unconsumed position of sorted[].
+ */
+static size_t eytzinger_fill(const int *sorted, int *keys, uint32_t *rank, size_t i, size_t k, size_t n)
+{
+    if(k <= n)
+    {
+        i = eytzinger_fill(sorted, keys, rank, i, 2 * k, n);
+        keys[k] = sorted[i];
+        rank[k] = (uint32_t)i;
+        i++;
+        i = eytzinger_fill(sorted, keys, rank, i, 2 * k + 1, n);
+    }
+    return i;
+}
+
+/**
+ * @brief Build a cache-friendly search index over a sorted array.
+ *
+ * Keys are re-laid in Eytzinger (BFS) order, 1-based, in a cache-line
+ * aligned array, so the top levels of the search share a few hot lines
+ * and the 16 descendants four levels below any node sit in one line that
+ * can be prefetched. A parallel rank array maps each slot back to its
+ * position in the original array.
+ *
+ * @param sorted Sorted array (ascending; duplicates allowed). Not retained.
+ * @param n Number of elements.
+ * @return New index, or NULL if n is too large (>= 2^32) or allocation fails.
+ */
+MathiSearchIndex* mathi_search_index_build(const int *sorted, size_t n)
+{
+    if(n >= UINT32_MAX) return NULL;
+    MathiSearchIndex *idx = malloc(sizeof(MathiSearchIndex));
+    if(!idx) return NULL;
+
+    size_t bytes = (n + 1) * sizeof(int);
+    bytes = (bytes + SEARCH_INDEX_ALIGN - 1) / SEARCH_INDEX_ALIGN * SEARCH_INDEX_ALIGN;
+    idx->keys = aligned_alloc(SEARCH_INDEX_ALIGN, bytes);
+    idx->rank = malloc((n + 1) * sizeof(uint32_t));
+    idx->n = n;
+    if(!idx->keys || !idx->rank)
+    {
+        mathi_search_index_free(idx);
+        return NULL;
+    }
+
+    eytzinger_fill(sorted, idx->keys, idx->rank, 0, 1, n);
+    return idx;
+}
+
+/**
+ * @brief Eytzinger slot of the first key >= key, or 0 if there is none.
+ *
+ * The descent is branch-free (the comparison feeds the index arithmetic)
+ * and prefetches the line holding the node's descendants four levels down.
+ * The final shift undoes the trailing right turns taken after the answer.
+ */
+static inline size_t search_index_slot(const MathiSearchIndex *idx, int key)
+{
+    const int *keys = idx->keys;
+    size_t n = idx->n, k = 1;
+    while(k <= n)
+    {
+#ifdef __GNUC__
+        __builtin_prefetch(keys + SEARCH_INDEX_LINE_KEYS * k);
+#endif
+        k = 2 * k + (keys[k] < key);
+    }
+#ifdef __GNUC__
+    k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+#else
+    while(k & 1) k >>= 1;
+    k >>= 1;
+#endif
+    return k;
+}
+
+/**
+ * @brief Position of the first element >= key in the original sorted array.
+ * @param idx Search index.
+ * @param key Value to search for.
+ * @return Position in [0, n]; n when every element is smaller than key.
+ */
+size_t mathi_search_index_lower_bound(const MathiSearchIndex *idx, int key)
+{
+    size_t k = search_index_slot(idx, key);
+    return k ? idx->rank[k] : idx->n;
+}
+
+/**
+ * @brief Find a key through a search index.
+ * @param idx Search index.
+ * @param key Value to search for.
+ * @return Position of the first occurrence of key in the original array, -1 if absent.
+ */
+ptrdiff_t mathi_search_index_find(const MathiSearchIndex *idx, int key)
+{
+    size_t k = search_index_slot(idx, key);
+    return k && idx->keys[k] == key ? (ptrdiff_t)idx->rank[k] : -1;
+}
+
+/**
+ * @brief Free a search index.
+ * @param idx Search index (may be NULL).
+ */
+void mathi_search_index_free(MathiSearchIndex *idx)
+{
+    if(!idx) return;
+    free(idx->keys);
+    free(idx->rank);
+    free(idx);
+}
+
+/* Searches advanced in lockstep by mathi_binary_search_batch. */
+#define SEARCH_BATCH_GROUP 16
+
+/* Keys per thread below which mathi_binary_search_batch_mt stays single-threaded. */
+#define SEARCH_BATCH_MT_MIN (1 << 16)
+
+/**
+ * @brief Lower-bound search for up to SEARCH_BATCH_GROUP keys at once.
+ *
+ * Every search in the group runs the same branch-free halving loop (the
+ * remaining length depends only on n), so the group advances in lockstep:
+ * each round issues one independent load per key and prefetches each
+ * key's next probe, keeping several cache misses in flight at once.
+ */
+static void search_batch_group(const int *arr, size_t n, const int *keys, size_t g, ptrdiff_t *out)
+{
+    const int *base[SEARCH_BATCH_GROUP];
+    for(size_t j = 0; j < g; j++) base[j] = arr;
+
+    size_t len = n;
+    while(len > 1)
+    {
+        size_t half = len / 2;
+        size_t next = (len - half) / 2;
+        for(size_t j = 0; j < g; j++)
+        {
+            base[j] = base[j][half] < keys[j] ? base[j] + half : base[j];
+#ifdef __GNUC__
+            __builtin_prefetch(base[j] + next);
+#endif
+        }
+        len -= half;
+    }
+
+    for(size_t j = 0; j < g; j++)
+    {
+        size_t pos = (size_t)(base[j] - arr) + (*base[j] < keys[j]);
+        out[j] = pos < n && arr[pos] == keys[j] ? (ptrdiff_t)pos : -1;
+    }
+}
+
+/**
+ * @brief Look up many keys in one sorted array.
+ *
+ * Keys are processed in groups of SEARCH_BATCH_GROUP whose binary searches
+ * advance in lockstep with software prefetch, hiding memory latency on
+ * arrays much larger than the caches.
+ *
+ * @param arr Sorted array.
+ * @param n Number of elements in arr.
+ * @param keys Keys to look up (any order).
+ * @param m Number of keys.
+ * @param out Output array of m positions: first occurrence of each key, or -1.
+ */
+void mathi_binary_search_batch(const int *arr, size_t n, const int *keys, size_t m, ptrdiff_t *out)
+{
+    if(n == 0)
+    {
+        for(size_t i = 0; i < m; i++) out[i] = -1;
+        return;
+    }
+    for(size_t i = 0; i < m; i += SEARCH_BATCH_GROUP)
+    {
+        size_t g = m - i < SEARCH_BATCH_GROUP ? m - i : SEARCH_BATCH_GROUP;
+        search_batch_group(arr, n, keys + i, g, out + i);
+    }
+}
+
+typedef struct
+{
+    const int *arr;
+    size_t n;
+    const int *keys;
+    size_t m;
+    ptrdiff_t *out;
+} SearchBatchTask;
+
+static void search_batch_slice(void *ctx, int slice)
+{
+    SearchBatchTask *t = (SearchBatchTask *)ctx + slice;
+    mathi_binary_search_batch(t->arr, t->n, t->keys, t->m, t->out);
+}
+
+/**
+ * @brief Multithreaded mathi_binary_search_batch.
+ *
+ * Splits the keys into one contiguous slice per thread. Small batches (under
+ * SEARCH_BATCH_MT_MIN keys per thread) and thread creation failures fall
+ * back to running on the calling thread.
+ *
+ * @param arr Sorted array.
+ * @param n Number of elements in arr.
+ * @param keys Keys to look up.
+ * @param m Number of keys.
+ * @param out Output array of m positions (first occurrence, or -1).
+ * @param threads Number of threads; <= 0 uses the number of online CPUs.
+ */
+void mathi_binary_search_batch_mt(const int *arr, size_t n, const int *keys, size_t m, ptrdiff_t *out, int threads)
+{
+    threads = mathi_default_threads(threads);
+    if((size_t)threads > m / SEARCH_BATCH_MT_MIN) threads = (int)(m / SEARCH_BATCH_MT_MIN);
+    SearchBatchTask *tasks = threads > 1 ? malloc(threads * sizeof(SearchBatchTask)) : NULL;
+    if(!tasks)
+    {
+        mathi_binary_search_batch(arr, n, keys, m, out);
+        return;
+    }
+
+    size_t chunk = (m + threads - 1) / threads;
+    for(int t = 0; t < threads; t++)
+    {
+        size_t lo = (size_t)t * chunk, hi = lo + chunk < m ? lo + chunk : m;
+        SearchBatchTask task = {arr, n, keys + lo, hi - lo, out + lo};
+        tasks[t] = task;
+    }
+    mathi_run_slices(search_batch_slice, tasks, threads);
+
+    free(tasks);
+}
+
+/* Ranges at or below this many bytes (one cache line) are finished by a linear scan. */
+#define BOUND_WINDOW_BYTES 64
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SEARCH_HAVE_X86 1
+#include <immintrin.h>
+
+/*
+ * Final-window kernels: count the lanes of base[0..len) (len <= one cache
+ * line) that sort before key (lower bound) or not after it (upper bound).
+ * Masked loads keep the scan inside the array.
+ */
+AVX2_TARGET static size_t bound_scan_avx2_i32(const int32_t *base, size_t len, int32_t key, int upper)
+{
+    const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i k = _mm256_set1_epi32(key);
+    size_t count = 0;
+    for(size_t i = 0; i < len; i += 8)
+    {
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(len - i)), iota);
+        __m256i v = _mm256_maskload_epi32((const int *)base + i, mask);
+        __m256i hit = upper ? _mm256_andnot_si256(_mm256_cmpgt_epi32(v, k), mask)
+                            : _mm256_and_si256(_mm256_cmpgt_epi32(k, v), mask);
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+    }
+    return count;
+}
+
+AVX2_TARGET static size_t bound_scan_avx2_i64(const int64_t *base, size_t len, int64_t key, int upper)
+{
+    const __m256i iota = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i k = _mm256_set1_epi64x(key);
+    size_t count = 0;
+    for(size_t i = 0; i < len; i += 4)
+    {
+        __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)(len - i)), iota);
+        __m256i v = _mm256_maskload_epi64((const long long *)base + i, mask);
+        __m256i hit = upper ? _mm256_andnot_si256(_mm256_cmpgt_epi64(v, k), mask)
+                            : _mm256_and_si256(_mm256_cmpgt_epi64(k, v), mask);
+        count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(hit)));
+    }
+    return count;
+}
+
+/* Same ordering as mathi_sort_f64: NaNs sort after every number. */
+AVX2_TARGET static size_t bound_scan_avx2_f64(const double *base, size_t len, double key, int upper)
+{
+    const __m256i iota = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256d k = _mm256_set1_pd(key);
+    int key_nan = key != key;
+    if(upper && key_nan) return len;
+    size_t count = 0;
+    for(size_t i = 0; i < len; i += 4)
+    {
+        __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)(len - i)), iota);
+        __m256d v = _mm256_maskload_pd(base + i, mask);
+        __m256d hit;
+        if(upper) hit = _mm256_cmp_pd(v, k, _CMP_LE_OQ);
+        else if(key_nan) hit = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+        else hit = _mm256_cmp_pd(v, k, _CMP_LT_OQ);
+        hit = _mm256_and_pd(hit, _mm256_castsi256_pd(mask));
+        count += __builtin_popcount(_mm256_movemask_pd(hit));
+    }
+    return count;
+}
+#endif
+
+#define BOUND_LESS(a, b) ((a) < (b))
+
+/* Orders NaNs after every number, matching mathi_sort_f64. */
+#define BOUND_FLOAT_LESS(a, b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+
+#ifdef SEARCH_HAVE_X86
+#define BOUND_SCAN_AVX2(sfx, base, len, key, upper) \
+    if(mathi_cpu_has_avx2()) return bound_scan_avx2_##sfx(base, len, key, upper);
+#else
+#define BOUND_SCAN_AVX2(sfx, base, len, key, upper)
+#endif
+
+/*
+ * Generates lower/upper bound, equal range and range count for one
+ * element type. The halving loop keeps the answer inside [base, base + len]
+ * and moves base with a conditional select instead of a branch; once the
+ * range fits in one cache line the rest is counted by the window scan.
+ */
+#define DEFINE_BOUNDS(sfx, T, LESS)                                              \
+static size_t bound_scan_##sfx(const T *base, size_t len, T key, int upper)     \
+{                                                                               \
+    BOUND_SCAN_AVX2(sfx, base, len, key, upper)                                 \
+    size_t count = 0;                                                           \
+    for(size_t i = 0; i < len; i++)                                             \
+        count += upper ? !LESS(key, base[i]) : LESS(base[i], key);              \
+    return count;                                                               \
+}                                                                               \
+                                                                                \
+size_t mathi_lower_bound_##sfx(const T *arr, size_t n, T key)                   \
+{                                                                               \
+    const T *base = arr;                                                        \
+    size_t len = n;                                                             \
+    while(len > BOUND_WINDOW_BYTES / sizeof(T))                                 \
+    {                                                                           \
+        size_t half = len / 2;                                                  \
+        base = LESS(base[half], key) ? base + half : base;                      \
+        len -= half;                                                            \
+    }                                                                           \
+    return (size_t)(base - arr) + bound_scan_##sfx(base, len, key, 0);          \
+}                                                                               \
+                                                                                \
+size_t mathi_upper_bound_##sfx(const T *arr, size_t n, T key)                   \
+{                                                                               \
+    const T *base = arr;                                                        \
+    size_t len = n;                                                             \
+    while(len > BOUND_WINDOW_BYTES / sizeof(T))                                 \
+    {                                                                           \
+        size_t half = len / 2;                                                  \
+        base = !LESS(key, base[half]) ? base + half : base;                     \
+        len -= half;                                                            \
+    }                                                                           \
+    return (size_t)(base - arr) + bound_scan_##sfx(base, len, key, 1);          \
+}                                                                               \
+                                                                                \
+void mathi_equal_range_##sfx(const T *arr, size_t n, T key, size_t *first, size_t *last) \
+{                                                                               \
+    *first = mathi_lower_bound_##sfx(arr, n, key);                              \
+    *last = mathi_upper_bound_##sfx(arr + *first, n - *first, key) + *first;    \
+}                                                                               \
+                                                                                \
+size_t mathi_count_range_##sfx(const T *arr, size_t n, T lo, T hi)              \
+{                                                                               \
+    if(!LESS(lo, hi)) return 0;                                                 \
+    size_t a = mathi_lower_bound_##sfx(arr, n, lo);                             \
+    return mathi_lower_bound_##sfx(arr + a, n - a, hi);                         \
+}
+
+DEFINE_BOUNDS(i32, int32_t, BOUND_LESS)
+DEFINE_BOUNDS(i64, int64_t, BOUND_LESS)
+DEFINE_BOUNDS(f64, double, BOUND_FLOAT_LESS)
+
+/* File magic and format version for mathi_learned_index_save / _load. */
+#define LEARNED_MAGIC 0x58494C4Du   /* "MLIX" */
+#define LEARNED_VERSION 1u
+
+/* Lookup windows are widened by this much to absorb floating-point rounding. */
+#define LEARNED_SLACK 1
+
+/* Upper bound on the radix table size, in bits of key prefix. */
+#define LEARNED_RADIX_MAX_BITS 20
+
+static MathiLearnedIndex *learned_alloc(size_t cap)
+{
+    MathiLearnedIndex *idx = calloc(1, sizeof(MathiLearnedIndex));
+    if(!idx) return NULL;
+    idx->seg_key = malloc((cap ? cap : 1) * sizeof(int64_t));
+    idx->seg_slope = malloc((cap ? cap : 1) * sizeof(double));
+    idx->seg_pos = malloc((cap ? cap : 1) * sizeof(double));
+    if(!idx->seg_key || !idx->seg_slope || !idx->seg_pos)
+    {
+        mathi_learned_index_free(idx);
+        return NULL;
+    }
+    return idx;
+}
+
+/* Close the current segment: slope in the middle of the surviving cone. */
+static void learned_close(MathiLearnedIndex *idx, int64_t x0, size_t y0, double lo, double hi)
+{
+    size_t s = idx->nseg++;
+    idx->seg_key[s] = x0;
+    idx->seg_pos[s] = (double)y0;
+    idx->seg_slope[s] = hi == INFINITY ? 0 : (lo + hi) / 2;
+}
+
+/*
+ * Radix table over the segment keys (RadixSpline style): radix[b] is the
+ * first segment whose key offset from the smallest key, shifted right by
+ * radix_shift, is at least b. A lookup then only searches the few segments
+ * sharing its prefix. Derived from the segments, so it is rebuilt on load.
+ */
+static int learned_build_radix(MathiLearnedIndex *idx)
+{
+    if(idx->nseg == 0) return 0;
+
+    uint64_t base = (uint64_t)idx->seg_key[0];
+    uint64_t span = (uint64_t)idx->seg_key[idx->nseg - 1] - base;
+    int bits = 1;
+    while(bits < LEARNED_RADIX_MAX_BITS && ((size_t)1 << bits) < 2 * idx->nseg) bits++;
+    int span_bits = 0;
+    while(span_bits < 64 && (span >> span_bits) != 0) span_bits++;
+    idx->radix_shift = span_bits > bits ? span_bits - bits : 0;
+    idx->radix_size = (size_t)(span >> idx->radix_shift) + 2;
+
+    idx->radix = malloc(idx->radix_size * sizeof(uint32_t));
+    if(!idx->radix) return -1;
+    size_t seg = 0;
+    for(size_t b = 0; b < idx->radix_size; b++)
+    {
+        while(seg < idx->nseg && (((uint64_t)idx->seg_key[seg] - base) >> idx->radix_shift) < b) seg++;
+        idx->radix[b] = (uint32_t)seg;
+    }
+    return 0;
+}
+
+/* Segment covering key (last segment whose first key <= key), or -1 if key precedes them all. */
+static inline ptrdiff_t learned_segment(const MathiLearnedIndex *idx, int64_t key)
+{
+    if(idx->nseg == 0 || key < idx->seg_key[0]) return -1;
+    uint64_t b = ((uint64_t)key - (uint64_t)idx->seg_key[0]) >> idx->radix_shift;
+    if(b > idx->radix_size - 2) b = idx->radix_size - 2;
+    size_t lo = idx->radix[b], hi = idx->radix[b + 1];
+    return (ptrdiff_t)(lo + mathi_upper_bound_i64(idx->seg_key + lo, hi - lo, key)) - 1;
+}
+
+/*
+ * Generates the builder and lookups for one key type. The builder walks the
+ * distinct keys (position = first occurrence) with a shrinking cone: each
+ * point narrows the slopes that keep every point of the segment within eps
+ * of its true position, and an empty cone starts a new segment there.
+ * Lookups find the segment through the radix table, predict a position and finish
+ * with a lower bound over the +-eps window. Absent keys can land outside the
+ * window; those are finished inside the segment's own position range.
+ */
+#define DEFINE_LEARNED(sfx, T)                                                   \
+MathiLearnedIndex* mathi_learned_index_build_##sfx(const T *sorted, size_t n, size_t eps) \
+{                                                                               \
+    size_t distinct = 0;                                                        \
+    for(size_t i = 0; i < n; i++) distinct += i == 0 || sorted[i] != sorted[i - 1]; \
+    MathiLearnedIndex *idx = learned_alloc(distinct);                           \
+    if(!idx) return NULL;                                                       \
+    idx->n = n;                                                                 \
+    idx->eps = eps;                                                             \
+    idx->key_size = sizeof(T);                                                  \
+    if(n == 0) return idx;                                                      \
+                                                                                \
+    int64_t x0 = sorted[0];                                                     \
+    size_t y0 = 0;                                                              \
+    double lo = -INFINITY, hi = INFINITY;                                       \
+    for(size_t i = 1; i < n; i++)                                               \
+    {                                                                           \
+        if(sorted[i] == sorted[i - 1]) continue;                                \
+        double dx = (double)sorted[i] - (double)x0;                             \
+        double plo = ((double)i - (double)eps - (double)y0) / dx;               \
+        double phi = ((double)i + (double)eps - (double)y0) / dx;               \
+        if(plo > hi || phi < lo)                                                \
+        {                                                                       \
+            learned_close(idx, x0, y0, lo, hi);                                 \
+            x0 = sorted[i];                                                     \
+            y0 = i;                                                             \
+            lo = -INFINITY;                                                     \
+            hi = INFINITY;                                                      \
+            continue;                                                           \
+        }                                                                       \
+        if(plo > lo) lo = plo;                                                  \
+        if(phi < hi) hi = phi;                                                  \
+    }                                                                           \
+    learned_close(idx, x0, y0, lo, hi);                                         \
+    if(learned_build_radix(idx) != 0)                                           \
+    {                                                                           \
+        mathi_learned_index_free(idx);                                          \
+        return NULL;                                                            \
+    }                                                                           \
+    return idx;                                                                 \
+}                                                                               \
+                                                                                \
+size_t mathi_learned_index_lower_bound_##sfx(const MathiLearnedIndex *idx, const T *arr, T key) \
+{                                                                               \
+    size_t n = idx->n;                                                          \
+    ptrdiff_t s = learned_segment(idx, (int64_t)key);                           \
+    if(s < 0) return 0;                                                         \
+                                                                                \
+    /* The answer lies in [first position of this segment, first of the next]. */ \
+    size_t L = (size_t)idx->seg_pos[s];                                         \
+    size_t R = (size_t)s + 1 < idx->nseg ? (size_t)idx->seg_pos[s + 1] : n;     \
+    double p = idx->seg_pos[s] + idx->seg_slope[s] * ((double)key - (double)idx->seg_key[s]); \
+    double w = (double)(idx->eps + LEARNED_SLACK);                              \
+    size_t lo = p - w <= (double)L ? L : p - w >= (double)R ? R : (size_t)(p - w); \
+    size_t hi = p + w + 1 >= (double)R ? R : p + w + 1 <= (double)lo ? lo : (size_t)(p + w + 1); \
+                                                                                \
+    size_t pos = lo + mathi_lower_bound_##sfx(arr + lo, hi - lo, key);          \
+    if(pos == lo && lo > L && arr[lo - 1] >= key)                               \
+        pos = L + mathi_lower_bound_##sfx(arr + L, lo - L, key);                \
+    else if(pos == hi && hi < R)                                                \
+    {                                                                           \
+        /* Absent key past the window (e.g. after a long run of duplicates): gallop. */ \
+        size_t a = hi, b = hi, step = 1;                                        \
+        while(b < R && arr[b] < key)                                            \
+        {                                                                       \
+            a = b + 1;                                                          \
+            b = R - b > step ? b + step : R;                                    \
+            step *= 2;                                                          \
+        }                                                                       \
+        pos = a + mathi_lower_bound_##sfx(arr + a, b - a, key);                 \
+    }                                                                           \
+    return pos;                                                                 \
+}                                                                               \
+                                                                                \
+ptrdiff_t mathi_learned_index_find_##sfx(const MathiLearnedIndex *idx, const T *arr, T key) \
+{                                                                               \
+    size_t pos = mathi_learned_index_lower_bound_##sfx(idx, arr, key);          \
+    return pos < idx->n && arr[pos] == key ? (ptrdiff_t)pos : -1;               \
+}
+
+DEFINE_LEARNED(i32, int32_t)
+DEFINE_LEARNED(i64, int64_t)
+
+/**
+ * @brief Write a learned index to disk (the keys themselves are not stored).
+ * @param idx Learned index.
+ * @param path Output file path.
+ * @return 0 on success, -1 on I/O error.
+ */
+int mathi_learned_index_save(const MathiLearnedIndex *idx, const char *path)
+{
+    FILE *f = mathi_filex_open(path, "wb");
+    if(!f) return -1;
+
+    uint32_t head[2] = {LEARNED_MAGIC, LEARNED_VERSION};
+    uint64_t meta[4] = {idx->n, idx->eps, idx->nseg, (uint64_t)idx->key_size};
+    int ok = fwrite(head, sizeof(head), 1, f) == 1 &&
+             fwrite(meta, sizeof(meta), 1, f) == 1 &&
+             fwrite(idx->seg_key, sizeof(int64_t), idx->nseg, f) == idx->nseg &&
+             fwrite(idx->seg_slope, sizeof(double), idx->nseg, f) == idx->nseg &&
+             fwrite(idx->seg_pos, sizeof(double), idx->nseg, f) == idx->nseg;
+    if(fclose(f) != 0) ok = 0;
+    return ok ? 0 : -1;
+}
+
+/*
+ * Whether loaded segments are consistent enough for the lookups to stay
+ * inside [0, n]: keys strictly ascending, positions finite, non-decreasing,
+ * starting at 0 and at most n, slopes finite.
+ */
+static int learned_valid(const MathiLearnedIndex *idx)
+{
+    if((idx->nseg == 0) != (idx->n == 0)) return 0;
+    for(size_t s = 0; s < idx->nseg; s++)
+    {
+        double pos = idx->seg_pos[s];
+        if(!isfinite(idx->seg_slope[s]) || !isfinite(pos) || pos < 0 || pos > (double)idx->n) return 0;
+        if(s == 0 ? pos != 0 : idx->seg_key[s] <= idx->seg_key[s - 1] || pos < idx->seg_pos[s - 1]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Read a learned index written by mathi_learned_index_save.
+ * @param path Input file path.
+ * @return Loaded index, or NULL if the file is missing, truncated or inconsistent, or
+ *         allocation fails.
+ */
+MathiLearnedIndex* mathi_learned_index_load(const char *path)
+{
+    FILE *f = mathi_filex_open(path, "rb");
+    if(!f) return NULL;
+
+    uint32_t head[2];
+    uint64_t meta[4];
+    MathiLearnedIndex *idx = NULL;
+    if(fread(head, sizeof(head), 1, f) != 1 || head[0] != LEARNED_MAGIC || head[1] != LEARNED_VERSION ||
+       fread(meta, sizeof(meta), 1, f) != 1 || meta[2] > meta[0] + 1 ||
+       (meta[3] != sizeof(int32_t) && meta[3] != sizeof(int64_t)))
+    {
+        mathi_filex_close(f);
+        return NULL;
+    }
+
+    idx = learned_alloc((size_t)meta[2]);
+    if(idx)
+    {
+        idx->n = (size_t)meta[0];
+        idx->eps = (size_t)meta[1];
+        idx->nseg = (size_t)meta[2];
+        idx->key_size = (int)meta[3];
+        if(fread(idx->seg_key, sizeof(int64_t), idx->nseg, f) != idx->nseg ||
+           fread(idx->seg_slope, sizeof(double), idx->nseg, f) != idx->nseg ||
+           fread(idx->seg_pos, sizeof(double), idx->nseg, f) != idx->nseg ||
+           !learned_valid(idx) || learned_build_radix(idx) != 0)
+        {
+            mathi_learned_index_free(idx);
+            idx = NULL;
+        }
+    }
+    mathi_filex_close(f);
+    return idx;
+}
+
+/**
+ * @brief Free a learned index.
+ * @param idx Learned index (may be NULL).
+ */
+void mathi_learned_index_free(MathiLearnedIndex *idx)
+{
+    if(!idx) return;
+    free(idx->seg_key);
+    free(idx->seg_slope);
+    free(idx->seg_pos);
+    free(idx->radix);
+    free(idx);
+}
@@ -7,6 +7,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "mathi/sort.h"
+#include "mathi/array.h"
+#include "mathi/filex.h"
+#include "mathi/sys.h"
+#include "mathi_internal.h"
 
 /**
  * @brief Sort an integer array using Bubble Sort.
@@ -65,106 +72,390 @@ void mathi_insertion_sort(int *arr, int n)
     }
 }
 
+/* Largest block handled by the sorting-network kernels. */
+#define SMALL_SORT_MAX 64
+
+/* Merge sort leaves at or below this size go straight to the network kernel. */
+#define MERGE_LEAF_MAX 32
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SORT_HAVE_X86 1
+#include <immintrin.h>
+#include <math.h>
+
+/*
+ * In-register bitonic network over 8 lanes. Each stage pairs every lane
+ * with a partner (a fixed shuffle) and keeps either the min or the max;
+ * the blend mask marks the lanes that keep the max.
+ */
+#define NET_STAGE_EPI32(v, p, mask) _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(p, v), mask)
+#define NET_STAGE_PS(v, p, mask) _mm256_blend_ps(_mm256_min_ps(v, p), _mm256_max_ps(p, v), mask)
+
+static inline __m256i AVX2_TARGET net_sort8_epi32(__m256i v)
+{
+    v = NET_STAGE_EPI32(v, _mm256_shuffle_epi32(v, 0xB1), 0x66);
+    v = NET_STAGE_EPI32(v, _mm256_shuffle_epi32(v, 0x4E), 0x3C);
+    v = NET_STAGE_EPI32(v, _mm256_shuffle_epi32(v, 0xB1), 0x5A);
+    v = NET_STAGE_EPI32(v, _mm256_permute2x128_si256(v, v, 0x01), 0xF0);
+    v = NET_STAGE_EPI32(v, _mm256_shuffle_epi32(v, 0x4E), 0xCC);
+    v = NET_STAGE_EPI32(v, _mm256_shuffle_epi32(v, 0xB1), 0xAA);
+    return v;
+}
+
+static inline __m256i AVX2_TARGET net_merge8_epi32(__m256i v)
+{
+    v = NET_STAGE_EPI32(v, _mm256_permute2x128_si256(v, v, 0x01), 0xF0);
+    v = NET_STAGE_EPI32(v, _mm256_shuffle_epi32(v, 0x4E), 0xCC);
+    v = NET_STAGE_EPI32(v, _mm256_shuffle_epi32(v, 0xB1), 0xAA);
+    return v;
+}
+
+static inline __m256 AVX2_TARGET net_sort8_ps(__m256 v)
+{
+    v = NET_STAGE_PS(v, _mm256_permute_ps(v, 0xB1), 0x66);
+    v = NET_STAGE_PS(v, _mm256_permute_ps(v, 0x4E), 0x3C);
+    v = NET_STAGE_PS(v, _mm256_permute_ps(v, 0xB1), 0x5A);
+    v = NET_STAGE_PS(v, _mm256_permute2f128_ps(v, v, 0x01), 0xF0);
+    v = NET_STAGE_PS(v, _mm256_permute_ps(v, 0x4E), 0xCC);
+    v = NET_STAGE_PS(v, _mm256_permute_ps(v, 0xB1), 0xAA);
+    return v;
+}
+
+static inline __m256 AVX2_TARGET net_merge8_ps(__m256 v)
+{
+    v = NET_STAGE_PS(v, _mm256_permute2f128_ps(v, v, 0x01), 0xF0);
+    v = NET_STAGE_PS(v, _mm256_permute_ps(v, 0x4E), 0xCC);
+    v = NET_STAGE_PS(v, _mm256_permute_ps(v, 0xB1), 0xAA);
+    return v;
+}
+
+/*
+ * Sort up to 64 values held in 1, 2, 4 or 8 registers: sort each register,
+ * then bitonic-merge runs of w registers pairwise. Reversing the second run
+ * makes each pair bitonic, half-cleaners at register distance w..1 split it,
+ * and an in-register merge finishes every register.
+ */
+#define DEFINE_NET_SORT(name, T, V, LOAD, STORE, MIN, MAX, REVERSE, SORT8, MERGE8, PAD) \
+static void AVX2_TARGET name(T *arr, int n)                                    \
+{                                                                               \
+    T buf[SMALL_SORT_MAX] __attribute__((aligned(32)));                         \
+    V r[SMALL_SORT_MAX / 8];                                                    \
+    int regs = 1;                                                               \
+    while(regs * 8 < n) regs *= 2;                                              \
+                                                                                \
+    memcpy(buf, arr, n * sizeof(T));                                            \
+    for(int i = n; i < regs * 8; i++) buf[i] = PAD;                             \
+    for(int i = 0; i < regs; i++) r[i] = SORT8(LOAD((const void *)(buf + 8 * i))); \
+                                                                                \
+    for(int w = 1; w < regs; w *= 2)                                            \
+        for(int s = 0; s < regs; s += 2 * w)                                    \
+        {                                                                       \
+            for(int i = 0; i < w / 2; i++)                                      \
+            {                                                                   \
+                V t = r[s + w + i];                                             \
+                r[s + w + i] = r[s + 2 * w - 1 - i];                            \
+                r[s + 2 * w - 1 - i] = t;                                       \
+            }                                                                   \
+            for(int i = s + w; i < s + 2 * w; i++) r[i] = REVERSE(r[i]);        \
+                                                                                \
+            for(int d = w; d >= 1; d /= 2)                                      \
+                for(int i = s; i < s + 2 * w; i++)                              \
+                    if(((i - s) & d) == 0)                                      \
+                    {                                                           \
+                        V lo = MIN(r[i], r[i + d]), hi = MAX(r[i + d], r[i]);   \
+                        r[i] = lo;                                              \
+                        r[i + d] = hi;                                          \
+                    }                                                           \
+            for(int i = s; i < s + 2 * w; i++) r[i] = MERGE8(r[i]);             \
+        }                                                                       \
+                                                                                \
+    for(int i = 0; i < regs; i++) STORE((void *)(buf + 8 * i), r[i]);           \
+    memcpy(arr, buf, n * sizeof(T));                                            \
+}
+
+#define REVERSE8_EPI32(v) _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0))
+#define REVERSE8_PS(v) _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0))
+#define LOAD_EPI32(p) _mm256_load_si256((const __m256i *)(p))
+#define STORE_EPI32(p, v) _mm256_store_si256((__m256i *)(p), v)
+#define LOAD_PS(p) _mm256_load_ps((const float *)(p))
+#define STORE_PS(p, v) _mm256_store_ps((float *)(p), v)
+
+DEFINE_NET_SORT(net_sort_epi32, int, __m256i, LOAD_EPI32, STORE_EPI32, _mm256_min_epi32, _mm256_max_epi32,
+                REVERSE8_EPI32, net_sort8_epi32, net_merge8_epi32, 2147483647)
+DEFINE_NET_SORT(net_sort_ps, float, __m256, LOAD_PS, STORE_PS, _mm256_min_ps, _mm256_max_ps,
+                REVERSE8_PS, net_sort8_ps, net_merge8_ps, INFINITY)
+#endif
+
+/**
+ * @brief Sort a small integer array with a SIMD sorting network.
+ *
+ * Blocks of up to 64 elements are padded to 8, 16, 32 or 64 lanes and
+ * sorted branch-free with an AVX2 bitonic network. Without AVX2, or for
+ * larger arrays, this falls back to insertion sort or Introsort.
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ */
+void mathi_sort_small(int *arr, int n)
+{
+    if(n < 2) return;
+#ifdef SORT_HAVE_X86
+    if(n <= SMALL_SORT_MAX && mathi_cpu_has_avx2())
+    {
+        net_sort_epi32(arr, n);
+        return;
+    }
+#endif
+    if(n <= SMALL_SORT_MAX) mathi_insertion_sort(arr, n);
+    else mathi_intro_sort(arr, n);
+}
+
+/**
+ * @brief Sort a small float array with a SIMD sorting network.
+ *
+ * Blocks containing a NaN take the scalar path so NaNs keep the
+ * mathi_sort_f32 ordering (after every number).
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ */
+void mathi_sort_small_f32(float *arr, int n)
+{
+    if(n < 2) return;
+#ifdef SORT_HAVE_X86
+    if(n <= SMALL_SORT_MAX && mathi_cpu_has_avx2())
+    {
+        int has_nan = 0;
+        for(int i = 0; i < n; i++) has_nan |= isnan(arr[i]);
+        if(!has_nan)
+        {
+            net_sort_ps(arr, n);
+            return;
+        }
+    }
+#endif
+    mathi_sort_f32(arr, n);
+}
+
 /**
  * @brief Merge two subarrays of an array (helper for Merge Sort).
  * @param arr Array to merge.
+ * @param tmp Scratch buffer at least as large as arr; only [l, r] is used.
  * @param l Left index.
  * @param m Middle index.
  * @param r Right index.
  */
-static void merge(int *arr, int l, int m, int r)
+static void merge(int *arr, int *tmp, int l, int m, int r)
 {
-    int n1 = m - l + 1, n2 = r - m;
-    int *L = malloc(n1 * sizeof(int)), *R = malloc(n2 * sizeof(int));
-    for(int i = 0; i < n1; i++) L[i] = arr[l + i];
-    for(int i = 0; i < n2; i++) R[i] = arr[m + 1 + i];
+    memcpy(tmp + l, arr + l, (m - l + 1) * sizeof(int));
 
-    int i = 0, j = 0, k = l;
-    while(i < n1 && j < n2) arr[k++] = (L[i] <= R[j] ? L[i++] : R[j++]);
-    while(i < n1) arr[k++] = L[i++];
-    while(j < n2) arr[k++] = R[j++];
-
-    free(L);
-    free(R);
+    int i = l, j = m + 1, k = l;
+    while(i <= m && j <= r) arr[k++] = (tmp[i] <= arr[j] ? tmp[i++] : arr[j++]);
+    while(i <= m) arr[k++] = tmp[i++];
 }
 
 /**
  * @brief Recursive Merge Sort implementation.
  * @param arr Array to sort.
+ * @param tmp Scratch buffer at least as large as arr.
  * @param l Left index.
  * @param r Right index.
  */
-static void merge_sort_rec(int *arr, int l, int r)
+static void merge_sort_rec(int *arr, int *tmp, int l, int r)
 {
-    if(l < r) 
+    if(r - l < MERGE_LEAF_MAX && mathi_cpu_has_avx2())
+        mathi_sort_small(arr + l, r - l + 1);
+    else if(l < r) 
     {
         int m = l + (r - l) / 2;
-        merge_sort_rec(arr, l, m);
-        merge_sort_rec(arr, m + 1, r);
-        merge(arr, l, m, r);
+        merge_sort_rec(arr, tmp, l, m);
+        merge_sort_rec(arr, tmp, m + 1, r);
+        if(arr[m] > arr[m + 1]) merge(arr, tmp, l, m, r);
     }
 }
 
 /**
  * @brief Sort an integer array using Merge Sort.
+ *
+ * Allocates one scratch buffer for the whole sort instead of one per merge.
+ *
  * @param arr Pointer to the array.
  * @param n Number of elements in the array.
  */
 void mathi_merge_sort(int *arr, int n)
 {
-    merge_sort_rec(arr, 0, n - 1);
+    if(n < 2) return;
+    int *tmp = malloc(n * sizeof(int));
+    if(!tmp)
+    {
+        mathi_intro_sort(arr, n);
+        return;
+    }
+    merge_sort_rec(arr, tmp, 0, n - 1);
+    free(tmp);
 }
 
+/* Partitions at or below this size are finished with insertion sort. */
+#define INTRO_INSERTION_CUTOFF 16
+
+/* Leaf size used when the SIMD sorting-network kernels are available. */
+#define INTRO_SIMD_LEAF 32
+
+/* Partitions above this size pick their pivot with Tukey's ninther. */
+#define INTRO_NINTHER_CUTOFF 128
+
 /**
- * @brief Partition function for Quick Sort.
- * @param arr Array to partition.
+ * @brief Insertion sort over the inclusive range [low, high].
+ * @param arr Array to sort.
  * @param low Starting index.
  * @param high Ending index.
- * @return Index of the pivot element after partition.
  */
-static int mathi_partition(int *arr, int low, int high)
+static void insertion_sort_range(int *arr, int low, int high)
 {
-    int pivot = arr[high], i = low - 1;
-    for(int j = low; j < high; j++) 
-        if(arr[j] <= pivot) 
+    for(int i = low + 1; i <= high; i++) 
+    {
+        int key = arr[i], j = i - 1;
+        while(j >= low && arr[j] > key) 
         {
-            i++;
-            int tmp = arr[i];
-            arr[i] = arr[j];
-            arr[j] = tmp;
+            arr[j + 1] = arr[j];
+            j--;
         }
+        arr[j + 1] = key;
+    }
+}
+
+/**
+ * @brief Index of the median of arr[a], arr[b] and arr[c].
+ */
+static int median_of_three(int *arr, int a, int b, int c)
+{
+    if(arr[a] < arr[b])
+    {
+        if(arr[b] < arr[c]) return b;
+        return (arr[a] < arr[c]) ? c : a;
+    }
+    if(arr[a] < arr[c]) return a;
+    return (arr[b] < arr[c]) ? c : b;
+}
+
+/**
+ * @brief Pick a pivot index for Introsort.
+ *
+ * Uses median-of-three on small partitions and Tukey's ninther
+ * (median of three medians) on larger ones, so sorted, reversed and
+ * organ-pipe inputs still split close to the middle.
+ *
+ * @param arr Array being partitioned.
+ * @param low Starting index.
+ * @param high Ending index.
+ * @return Index of the chosen pivot.
+ */
+static int choose_pivot(int *arr, int low, int high)
+{
+    int len = high - low + 1, mid = low + len / 2;
+    if(len <= INTRO_NINTHER_CUTOFF) return median_of_three(arr, low, mid, high);
 
-    int tmp = arr[i+1];
-    arr[i+1] = arr[high];
-    arr[high] = tmp;
+    int s = len / 8;
+    int a = median_of_three(arr, low, low + s, low + 2 * s);
+    int b = median_of_three(arr, mid - s, mid, mid + s);
+    int c = median_of_three(arr, high - 2 * s, high - s, high);
+    return median_of_three(arr, a, b, c);
+}
 
-    return i + 1;
+/**
+ * @brief Dijkstra three-way partition of [low, high] around a pivot value.
+ *
+ * On return [low, lt) < pivot, [lt, gt] == pivot and (gt, high] > pivot.
+ */
+static void partition3(int *arr, int low, int high, int pivot, int *lt_out, int *gt_out)
+{
+    int lt = low, i = low, gt = high;
+    while(i <= gt)
+    {
+        if(arr[i] < pivot)
+        {
+            int tmp = arr[lt];
+            arr[lt++] = arr[i];
+            arr[i++] = tmp;
+        }
+        else if(arr[i] > pivot)
+        {
+            int tmp = arr[gt];
+            arr[gt--] = arr[i];
+            arr[i] = tmp;
+        }
+        else i++;
+    }
+    *lt_out = lt;
+    *gt_out = gt;
 }
 
 /**
- * @brief Recursive Quick Sort implementation.
+ * @brief Introsort loop over the inclusive range [low, high].
+ *
+ * Three-way partitions around the pivot so runs of equal keys are
+ * finished in one pass, recurses into the smaller side and loops on the
+ * larger one (keeping the stack O(log n)), and hands the range to heap
+ * sort once the depth budget is exhausted.
+ *
  * @param arr Array to sort.
  * @param low Starting index.
  * @param high Ending index.
+ * @param depth Remaining partitioning depth before falling back to heap sort.
+ * @param leaf Partitions at or below this size are finished by the leaf sorter.
  */
-static void quick_sort_rec(int *arr, int low, int high)
+static void intro_sort_rec(int *arr, int low, int high, int depth, int leaf)
 {
-    if(low < high) 
+    while(high - low + 1 > leaf)
     {
-        int pi = mathi_partition(arr, low, high);
-        quick_sort_rec(arr, low, pi - 1);
-        quick_sort_rec(arr, pi + 1, high);
+        if(depth-- == 0)
+        {
+            mathi_heap_sort(arr + low, high - low + 1);
+            return;
+        }
+
+        int lt, gt;
+        partition3(arr, low, high, arr[choose_pivot(arr, low, high)], &lt, &gt);
+        if(lt - low < high - gt)
+        {
+            intro_sort_rec(arr, low, lt - 1, depth, leaf);
+            low = gt + 1;
+        }
+        else
+        {
+            intro_sort_rec(arr, gt + 1, high, depth, leaf);
+            high = lt - 1;
+        }
     }
+    if(leaf > INTRO_INSERTION_CUTOFF) mathi_sort_small(arr + low, high - low + 1);
+    else insertion_sort_range(arr, low, high);
+}
+
+/**
+ * @brief Sort an integer array using Introsort.
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ */
+void mathi_intro_sort(int *arr, int n)
+{
+    if(n < 2) return;
+    int depth = 0;
+    for(int m = n; m > 1; m >>= 1) depth += 2;
+    intro_sort_rec(arr, 0, n - 1, depth, mathi_cpu_has_avx2() ? INTRO_SIMD_LEAF : INTRO_INSERTION_CUTOFF);
 }
 
 /**
  * @brief Sort an integer array using Quick Sort.
+ *
+ * Runs on the Introsort engine, so sorted, reversed and all-equal inputs
+ * stay O(n log n) and recursion depth stays O(log n).
+ *
  * @param arr Pointer to the array.
  * @param n Number of elements in the array.
  */
 void mathi_quick_sort(int *arr, int n)
 {
-    quick_sort_rec(arr, 0, n - 1);
+    mathi_intro_sort(arr, n);
 }
 
 /**
@@ -213,9 +504,1972 @@ void mathi_heap_sort(int *arr, int n)
  */
 void mathi_counting_sort(int *arr, int n, int max)
 {
-    int *count = calloc(max + 1, sizeof(int));
+    if(n <= 1 || max < 0) return;
+    int32_t *count = calloc((size_t)max + 1, sizeof(int32_t));
+    if(!count) return;
     for(int i = 0; i < n; i++) count[arr[i]]++;
-    int idx = 0;
-    for(int i = 0; i <= max; i++) while(count[i]-- > 0) arr[idx++] = i;
+
+    // After an inclusive scan count[v] is where the run of v ends in the output.
+    mathi_scan_inclusive_i32(count, count, (size_t)max + 1);
+    int start = 0;
+    for(int v = 0; v <= max; v++)
+    {
+        for(int i = start; i < count[v]; i++) arr[i] = v;
+        start = count[v];
+    }
     free(count);
-}
\ No newline at end of file
+}
+
+/* Below this size the fixed cost of the histograms outweighs radix sort. */
+#define RADIX_SMALL_CUTOFF 64
+
+/**
+ * @brief Sort an integer array using LSD Radix Sort with a caller-supplied buffer.
+ *
+ * Four 8-bit passes over the keys with the sign bit flipped, so the full
+ * signed 32-bit range is handled. All four digit histograms are built in
+ * a single read pass, and passes where every key shares the same digit are
+ * skipped entirely.
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ * @param scratch Buffer of at least n ints; contents are overwritten.
+ */
+void mathi_radix_sort_buf(int *arr, int n, int *scratch)
+{
+    if(n < RADIX_SMALL_CUTOFF)
+    {
+        mathi_sort_small(arr, n);
+        return;
+    }
+
+    unsigned count[4][256];
+    memset(count, 0, sizeof(count));
+    for(int i = 0; i < n; i++)
+    {
+        unsigned k = (unsigned)arr[i] ^ 0x80000000u;
+        count[0][k & 0xFF]++;
+        count[1][(k >> 8) & 0xFF]++;
+        count[2][(k >> 16) & 0xFF]++;
+        count[3][k >> 24]++;
+    }
+
+    int *src = arr, *dst = scratch;
+    unsigned first = (unsigned)arr[0] ^ 0x80000000u;
+    for(int pass = 0; pass < 4; pass++)
+    {
+        int shift = pass * 8;
+        unsigned *c = count[pass];
+        if(c[(first >> shift) & 0xFF] == (unsigned)n) continue;
+
+        unsigned sum = 0;
+        for(int b = 0; b < 256; b++)
+        {
+            unsigned t = c[b];
+            c[b] = sum;
+            sum += t;
+        }
+
+        for(int i = 0; i < n; i++)
+        {
+            unsigned k = (unsigned)src[i] ^ 0x80000000u;
+            dst[c[(k >> shift) & 0xFF]++] = src[i];
+        }
+
+        int *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if(src != arr) memcpy(arr, src, n * sizeof(int));
+}
+
+/**
+ * @brief Sort an integer array using LSD Radix Sort.
+ *
+ * Allocates one scratch buffer of n ints for the whole sort; falls back to
+ * Introsort if that allocation fails.
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ */
+void mathi_radix_sort(int *arr, int n)
+{
+    if(n < RADIX_SMALL_CUTOFF)
+    {
+        mathi_sort_small(arr, n);
+        return;
+    }
+
+    int *scratch = malloc(n * sizeof(int));
+    if(!scratch)
+    {
+        mathi_intro_sort(arr, n);
+        return;
+    }
+    mathi_radix_sort_buf(arr, n, scratch);
+    free(scratch);
+}
+
+
+/* Arrays smaller than this are not worth waking a thread pool for. */
+#define PARALLEL_SORT_MIN 16384
+
+/* Leaf blocks per worker; extra blocks let fast workers pick up slack. */
+#define PARALLEL_BLOCKS_PER_THREAD 4
+
+/**
+ * @brief Reusable thread barrier (pthread_barrier_t is not available everywhere).
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int count;
+    int waiting;
+    unsigned generation;
+} SortBarrier;
+
+static void sort_barrier_wait(SortBarrier *b)
+{
+    pthread_mutex_lock(&b->lock);
+    unsigned gen = b->generation;
+    if(++b->waiting == b->count)
+    {
+        b->waiting = 0;
+        b->generation++;
+        pthread_cond_broadcast(&b->cond);
+    }
+    else
+        while(gen == b->generation) pthread_cond_wait(&b->cond, &b->lock);
+    pthread_mutex_unlock(&b->lock);
+}
+
+/**
+ * @brief Shared state for one mathi_parallel_sort call.
+ */
+typedef struct {
+    int *arr;                 // array being sorted
+    int *buf;                 // ping-pong buffer of n ints
+    int n;                    // number of elements
+    int block;                // leaf block length
+    int nblocks;              // number of leaf blocks
+    int threads;              // number of participating threads
+    atomic_int next[40];      // task counters: [0] leaves, [1..] merge rounds
+    SortBarrier barrier;
+} ParallelSort;
+
+/**
+ * @brief Merge-path split: how many elements of a come before diagonal d.
+ *
+ * Finds i such that the first d outputs of a stable merge of a[0..la) and
+ * b[0..lb) are exactly a[0..i) and b[0..d-i).
+ */
+static int merge_path_split(const int *a, int la, const int *b, int lb, int d)
+{
+    int lo = d > lb ? d - lb : 0, hi = d < la ? d : la;
+    while(lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if(a[mid] <= b[d - mid - 1]) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Worker body shared by the pool threads and the calling thread.
+ */
+static void *parallel_sort_worker(void *arg)
+{
+    ParallelSort *ps = arg;
+    int n = ps->n;
+
+    // Sort leaf blocks in place, using the matching region of buf as scratch
+    for(int t; (t = atomic_fetch_add(&ps->next[0], 1)) < ps->nblocks; )
+    {
+        int lo = t * ps->block, hi = lo + ps->block < n ? lo + ps->block : n;
+        merge_sort_rec(ps->arr, ps->buf, lo, hi - 1);
+    }
+    sort_barrier_wait(&ps->barrier);
+
+    // Merge rounds: every pair of runs is cut into equal output slices
+    int *src = ps->arr, *dst = ps->buf, round = 1;
+    for(int width = ps->block; width < n; width *= 2, round++)
+    {
+        int pairs = (n + 2 * width - 1) / (2 * width);
+        int parts = ps->threads / pairs > 0 ? ps->threads / pairs : 1;
+        int tasks = pairs * parts;
+
+        for(int t; (t = atomic_fetch_add(&ps->next[round], 1)) < tasks; )
+        {
+            int p = t / parts, q = t % parts;
+            int lo = p * 2 * width;
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+            const int *a = src + lo, *b = src + mid;
+            int la = mid - lo, lb = hi - mid, len = hi - lo;
+
+            int d0 = (int)((long long)len * q / parts);
+            int d1 = (int)((long long)len * (q + 1) / parts);
+            int i = merge_path_split(a, la, b, lb, d0), j = d0 - i;
+            int i1 = merge_path_split(a, la, b, lb, d1), j1 = d1 - i1;
+            int *out = dst + lo + d0;
+
+            while(i < i1 && j < j1) *out++ = (a[i] <= b[j] ? a[i++] : b[j++]);
+            while(i < i1) *out++ = a[i++];
+            while(j < j1) *out++ = b[j++];
+        }
+        sort_barrier_wait(&ps->barrier);
+
+        int *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    return src;
+}
+
+/**
+ * @brief Sort an integer array using a multithreaded, stable Merge Sort.
+ *
+ * Allocates a single ping-pong buffer up front. Leaf blocks are sorted in
+ * parallel by a pthread pool that claims blocks from a shared counter, and
+ * every merge round is split with merge-path partitioning so the final
+ * merges also use all threads.
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ * @param threads Number of threads to use (<= 0 uses all online CPUs).
+ */
+void mathi_parallel_sort(int *arr, int n, int threads)
+{
+    if(n < 2 * PARALLEL_SORT_MIN)
+    {
+        mathi_merge_sort(arr, n);
+        return;
+    }
+    threads = mathi_default_threads(threads);
+    if(threads > n / PARALLEL_SORT_MIN) threads = n / PARALLEL_SORT_MIN;
+    if(threads <= 1)
+    {
+        mathi_merge_sort(arr, n);
+        return;
+    }
+
+    ParallelSort ps;
+    ps.arr = arr;
+    ps.buf = malloc(n * sizeof(int));
+    if(!ps.buf)
+    {
+        mathi_intro_sort(arr, n);
+        return;
+    }
+    ps.n = n;
+    ps.threads = threads;
+    ps.nblocks = threads * PARALLEL_BLOCKS_PER_THREAD;
+    ps.block = (n + ps.nblocks - 1) / ps.nblocks;
+    ps.nblocks = (n + ps.block - 1) / ps.block;
+    for(int i = 0; i < 40; i++) atomic_init(&ps.next[i], 0);
+    pthread_mutex_init(&ps.barrier.lock, NULL);
+    pthread_cond_init(&ps.barrier.cond, NULL);
+    ps.barrier.count = threads;
+    ps.barrier.waiting = 0;
+    ps.barrier.generation = 0;
+
+    pthread_t *tids = malloc((threads - 1) * sizeof(pthread_t));
+    int started = 0;
+    if(tids)
+        for(; started < threads - 1; started++)
+            if(pthread_create(&tids[started], NULL, parallel_sort_worker, &ps)) break;
+
+    // The barrier must match the number of threads that actually started
+    if(started < threads - 1)
+    {
+        pthread_mutex_lock(&ps.barrier.lock);
+        ps.threads = ps.barrier.count = started + 1;
+        pthread_mutex_unlock(&ps.barrier.lock);
+    }
+
+    int *sorted = parallel_sort_worker(&ps);
+    for(int i = 0; i < started; i++) pthread_join(tids[i], NULL);
+    if(sorted != arr) memcpy(arr, sorted, n * sizeof(int));
+
+    pthread_cond_destroy(&ps.barrier.cond);
+    pthread_mutex_destroy(&ps.barrier.lock);
+    free(tids);
+    free(ps.buf);
+}
+
+
+/* Arrays shorter than this are sorted with a single binary insertion sort. */
+#define TIM_MIN_MERGE 32
+
+/* Initial number of consecutive wins before a merge switches to galloping. */
+#define TIM_MIN_GALLOP 7
+
+/* Pending-run stack depth; the run-length invariants keep this enough for any int length. */
+#define TIM_MAX_RUNS 49
+
+/**
+ * @brief State for one mathi_tim_sort call.
+ */
+typedef struct {
+    int *arr;                     // array being sorted
+    int n;                        // number of elements
+    int *tmp;                     // merge buffer, allocated on the first merge
+    int min_gallop;               // adaptive galloping threshold
+    int stack_size;               // number of pending runs
+    int run_base[TIM_MAX_RUNS];   // start index of each pending run
+    int run_len[TIM_MAX_RUNS];    // length of each pending run
+} TimSort;
+
+/**
+ * @brief Minimum run length: n shifted down below TIM_MIN_MERGE, plus one if any bit was lost.
+ */
+static int tim_min_run(int n)
+{
+    int r = 0;
+    while(n >= TIM_MIN_MERGE)
+    {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/**
+ * @brief Length of the natural run starting at lo; strictly descending runs are reversed in place.
+ * @param arr Array to scan.
+ * @param lo Start of the run.
+ * @param hi End of the range (exclusive).
+ * @return Length of the ascending run starting at lo.
+ */
+static int tim_count_run(int *arr, int lo, int hi)
+{
+    int run_hi = lo + 1;
+    if(run_hi == hi) return 1;
+
+    if(arr[run_hi++] < arr[lo])
+    {
+        while(run_hi < hi && arr[run_hi] < arr[run_hi - 1]) run_hi++;
+        for(int i = lo, j = run_hi - 1; i < j; i++, j--)
+        {
+            int tmp = arr[i];
+            arr[i] = arr[j];
+            arr[j] = tmp;
+        }
+    }
+    else
+        while(run_hi < hi && arr[run_hi] >= arr[run_hi - 1]) run_hi++;
+
+    return run_hi - lo;
+}
+
+/**
+ * @brief Stable binary insertion sort of [lo, hi) where [lo, start) is already sorted.
+ */
+static void tim_binary_insertion(int *arr, int lo, int hi, int start)
+{
+    for(; start < hi; start++)
+    {
+        int pivot = arr[start], left = lo, right = start;
+        while(left < right)
+        {
+            int mid = left + (right - left) / 2;
+            if(pivot < arr[mid]) right = mid;
+            else left = mid + 1;
+        }
+        memmove(&arr[left + 1], &arr[left], (start - left) * sizeof(int));
+        arr[left] = pivot;
+    }
+}
+
+/**
+ * @brief Leftmost insertion point of key in sorted a[0..len), galloping out from hint.
+ * @return k such that a[k - 1] < key <= a[k].
+ */
+static int tim_gallop_left(int key, const int *a, int len, int hint)
+{
+    int last_ofs = 0, ofs = 1;
+    if(key > a[hint])
+    {
+        int max_ofs = len - hint;
+        while(ofs < max_ofs && key > a[hint + ofs])
+        {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0) ofs = max_ofs;
+        }
+        if(ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+    else
+    {
+        int max_ofs = hint + 1;
+        while(ofs < max_ofs && key <= a[hint - ofs])
+        {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0) ofs = max_ofs;
+        }
+        if(ofs > max_ofs) ofs = max_ofs;
+        int tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+
+    last_ofs++;
+    while(last_ofs < ofs)
+    {
+        int m = last_ofs + (ofs - last_ofs) / 2;
+        if(key > a[m]) last_ofs = m + 1;
+        else ofs = m;
+    }
+    return ofs;
+}
+
+/**
+ * @brief Rightmost insertion point of key in sorted a[0..len), galloping out from hint.
+ * @return k such that a[k - 1] <= key < a[k].
+ */
+static int tim_gallop_right(int key, const int *a, int len, int hint)
+{
+    int last_ofs = 0, ofs = 1;
+    if(key < a[hint])
+    {
+        int max_ofs = hint + 1;
+        while(ofs < max_ofs && key < a[hint - ofs])
+        {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0) ofs = max_ofs;
+        }
+        if(ofs > max_ofs) ofs = max_ofs;
+        int tmp = last_ofs;
+        last_ofs = hint - ofs;
+        ofs = hint - tmp;
+    }
+    else
+    {
+        int max_ofs = len - hint;
+        while(ofs < max_ofs && key >= a[hint + ofs])
+        {
+            last_ofs = ofs;
+            ofs = (ofs << 1) + 1;
+            if(ofs <= 0) ofs = max_ofs;
+        }
+        if(ofs > max_ofs) ofs = max_ofs;
+        last_ofs += hint;
+        ofs += hint;
+    }
+
+    last_ofs++;
+    while(last_ofs < ofs)
+    {
+        int m = last_ofs + (ofs - last_ofs) / 2;
+        if(key < a[m]) ofs = m;
+        else last_ofs = m + 1;
+    }
+    return ofs;
+}
+
+/**
+ * @brief Merge adjacent runs in place where len1 <= len2, buffering the left run.
+ */
+static void tim_merge_lo(TimSort *ts, int base1, int len1, int base2, int len2)
+{
+    int *a = ts->arr, *tmp = ts->tmp;
+    memcpy(tmp, a + base1, len1 * sizeof(int));
+
+    int c1 = 0, c2 = base2, dest = base1;
+    a[dest++] = a[c2++];
+    if(--len2 == 0)
+    {
+        memcpy(a + dest, tmp + c1, len1 * sizeof(int));
+        return;
+    }
+    if(len1 == 1)
+    {
+        memmove(a + dest, a + c2, len2 * sizeof(int));
+        a[dest + len2] = tmp[c1];
+        return;
+    }
+
+    int min_gallop = ts->min_gallop;
+    for(;;)
+    {
+        int count1 = 0, count2 = 0;
+
+        // Straight merge until one run starts winning consistently
+        do
+        {
+            if(a[c2] < tmp[c1])
+            {
+                a[dest++] = a[c2++];
+                count2++;
+                count1 = 0;
+                if(--len2 == 0) goto done;
+            }
+            else
+            {
+                a[dest++] = tmp[c1++];
+                count1++;
+                count2 = 0;
+                if(--len1 == 1) goto done;
+            }
+        } while((count1 | count2) < min_gallop);
+
+        // Galloping mode: copy whole stretches found by exponential search
+        do
+        {
+            count1 = tim_gallop_right(a[c2], tmp + c1, len1, 0);
+            if(count1 != 0)
+            {
+                memcpy(a + dest, tmp + c1, count1 * sizeof(int));
+                dest += count1;
+                c1 += count1;
+                len1 -= count1;
+                if(len1 <= 1) goto done;
+            }
+            a[dest++] = a[c2++];
+            if(--len2 == 0) goto done;
+
+            count2 = tim_gallop_left(tmp[c1], a + c2, len2, 0);
+            if(count2 != 0)
+            {
+                memmove(a + dest, a + c2, count2 * sizeof(int));
+                dest += count2;
+                c2 += count2;
+                len2 -= count2;
+                if(len2 == 0) goto done;
+            }
+            a[dest++] = tmp[c1++];
+            if(--len1 == 1) goto done;
+            min_gallop--;
+        } while(count1 >= TIM_MIN_GALLOP || count2 >= TIM_MIN_GALLOP);
+
+        if(min_gallop < 0) min_gallop = 0;
+        min_gallop += 2;
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    if(len1 == 1)
+    {
+        memmove(a + dest, a + c2, len2 * sizeof(int));
+        a[dest + len2] = tmp[c1];
+    }
+    else
+        memcpy(a + dest, tmp + c1, len1 * sizeof(int));
+}
+
+/**
+ * @brief Merge adjacent runs in place where len1 > len2, buffering the right run.
+ */
+static void tim_merge_hi(TimSort *ts, int base1, int len1, int base2, int len2)
+{
+    int *a = ts->arr, *tmp = ts->tmp;
+    memcpy(tmp, a + base2, len2 * sizeof(int));
+
+    int c1 = base1 + len1 - 1, c2 = len2 - 1, dest = base2 + len2 - 1;
+    a[dest--] = a[c1--];
+    if(--len1 == 0)
+    {
+        memcpy(a + dest - (len2 - 1), tmp, len2 * sizeof(int));
+        return;
+    }
+    if(len2 == 1)
+    {
+        dest -= len1;
+        c1 -= len1;
+        memmove(a + dest + 1, a + c1 + 1, len1 * sizeof(int));
+        a[dest] = tmp[c2];
+        return;
+    }
+
+    int min_gallop = ts->min_gallop;
+    for(;;)
+    {
+        int count1 = 0, count2 = 0;
+
+        do
+        {
+            if(tmp[c2] < a[c1])
+            {
+                a[dest--] = a[c1--];
+                count1++;
+                count2 = 0;
+                if(--len1 == 0) goto done;
+            }
+            else
+            {
+                a[dest--] = tmp[c2--];
+                count2++;
+                count1 = 0;
+                if(--len2 == 1) goto done;
+            }
+        } while((count1 | count2) < min_gallop);
+
+        do
+        {
+            count1 = len1 - tim_gallop_right(tmp[c2], a + base1, len1, len1 - 1);
+            if(count1 != 0)
+            {
+                dest -= count1;
+                c1 -= count1;
+                len1 -= count1;
+                memmove(a + dest + 1, a + c1 + 1, count1 * sizeof(int));
+                if(len1 == 0) goto done;
+            }
+            a[dest--] = tmp[c2--];
+            if(--len2 == 1) goto done;
+
+            count2 = len2 - tim_gallop_left(a[c1], tmp, len2, len2 - 1);
+            if(count2 != 0)
+            {
+                dest -= count2;
+                c2 -= count2;
+                len2 -= count2;
+                memcpy(a + dest + 1, tmp + c2 + 1, count2 * sizeof(int));
+                if(len2 <= 1) goto done;
+            }
+            a[dest--] = a[c1--];
+            if(--len1 == 0) goto done;
+            min_gallop--;
+        } while(count1 >= TIM_MIN_GALLOP || count2 >= TIM_MIN_GALLOP);
+
+        if(min_gallop < 0) min_gallop = 0;
+        min_gallop += 2;
+    }
+
+done:
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;
+    if(len2 == 1)
+    {
+        dest -= len1;
+        c1 -= len1;
+        memmove(a + dest + 1, a + c1 + 1, len1 * sizeof(int));
+        a[dest] = tmp[c2];
+    }
+    else
+        memcpy(a + dest - (len2 - 1), tmp, len2 * sizeof(int));
+}
+
+/**
+ * @brief Merge pending runs i and i + 1.
+ * @return 0 on success, -1 if the merge buffer could not be allocated.
+ */
+static int tim_merge_at(TimSort *ts, int i)
+{
+    int base1 = ts->run_base[i], len1 = ts->run_len[i];
+    int base2 = ts->run_base[i + 1], len2 = ts->run_len[i + 1];
+
+    ts->run_len[i] = len1 + len2;
+    if(i == ts->stack_size - 3)
+    {
+        ts->run_base[i + 1] = ts->run_base[i + 2];
+        ts->run_len[i + 1] = ts->run_len[i + 2];
+    }
+    ts->stack_size--;
+
+    // Elements of run 1 already below run 2, and of run 2 already above run 1, stay put
+    int k = tim_gallop_right(ts->arr[base2], ts->arr + base1, len1, 0);
+    base1 += k;
+    len1 -= k;
+    if(len1 == 0) return 0;
+
+    len2 = tim_gallop_left(ts->arr[base1 + len1 - 1], ts->arr + base2, len2, len2 - 1);
+    if(len2 == 0) return 0;
+
+    // One buffer of n/2 covers every merge, since the smaller run is buffered
+    if(!ts->tmp && !(ts->tmp = malloc((ts->n / 2 + 1) * sizeof(int)))) return -1;
+
+    if(len1 <= len2) tim_merge_lo(ts, base1, len1, base2, len2);
+    else tim_merge_hi(ts, base1, len1, base2, len2);
+    return 0;
+}
+
+/**
+ * @brief Merge pending runs until the run-length invariants hold again.
+ */
+static int tim_merge_collapse(TimSort *ts)
+{
+    int *len = ts->run_len;
+    while(ts->stack_size > 1)
+    {
+        int n = ts->stack_size - 2;
+        if((n > 0 && len[n - 1] <= len[n] + len[n + 1]) || (n > 1 && len[n - 2] <= len[n] + len[n - 1]))
+        {
+            if(len[n - 1] < len[n + 1]) n--;
+        }
+        else if(len[n] > len[n + 1]) break;
+
+        if(tim_merge_at(ts, n)) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Merge all remaining runs into one.
+ */
+static int tim_merge_force_collapse(TimSort *ts)
+{
+    while(ts->stack_size > 1)
+    {
+        int n = ts->stack_size - 2;
+        if(n > 0 && ts->run_len[n - 1] < ts->run_len[n + 1]) n--;
+        if(tim_merge_at(ts, n)) return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Sort an integer array using an adaptive, stable natural-run merge sort (Timsort).
+ *
+ * Detects ascending and strictly descending runs, extends short runs with
+ * binary insertion sort, and merges them with galloping so long stretches
+ * that are already in order are copied in bulk. Sorted input takes O(n)
+ * with no allocation; otherwise a single n/2 buffer is reused for every merge.
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ */
+void mathi_tim_sort(int *arr, int n)
+{
+    if(n < 2) return;
+
+    if(n < TIM_MIN_MERGE)
+    {
+        tim_binary_insertion(arr, 0, n, tim_count_run(arr, 0, n));
+        return;
+    }
+
+    TimSort ts;
+    ts.arr = arr;
+    ts.n = n;
+    ts.tmp = NULL;
+    ts.min_gallop = TIM_MIN_GALLOP;
+    ts.stack_size = 0;
+
+    int min_run = tim_min_run(n), lo = 0, remaining = n;
+    do
+    {
+        int run = tim_count_run(arr, lo, n);
+        if(run < min_run)
+        {
+            int force = remaining <= min_run ? remaining : min_run;
+            tim_binary_insertion(arr, lo, lo + force, lo + run);
+            run = force;
+        }
+
+        ts.run_base[ts.stack_size] = lo;
+        ts.run_len[ts.stack_size] = run;
+        ts.stack_size++;
+        if(tim_merge_collapse(&ts)) break;
+
+        lo += run;
+        remaining -= run;
+    } while(remaining != 0);
+
+    // The array is always a permutation of the input, so introsort can finish it on OOM
+    if(remaining != 0 || tim_merge_force_collapse(&ts)) mathi_intro_sort(arr, n);
+    free(ts.tmp);
+}
+
+
+/* Ordering used by the integer sorts. */
+#define SORT_LESS(a, b) ((a) < (b))
+
+/* Total order for floating point: NaNs compare equal to each other and sort after every number. */
+#define SORT_FLOAT_LESS(a, b) ((a) < (b) || ((b) != (b) && (a) == (a)))
+
+/**
+ * @brief Generate a size_t-indexed Introsort for element type T.
+ *
+ * The comparison is a macro, so it is inlined into every instantiation
+ * instead of going through a qsort-style function pointer.
+ */
+#define DEFINE_TYPED_SORT(name, T, LESS)                                        \
+static void name##_insertion(T *a, size_t n)                                    \
+{                                                                               \
+    for(size_t i = 1; i < n; i++)                                               \
+    {                                                                           \
+        T key = a[i];                                                           \
+        size_t j = i;                                                           \
+        while(j > 0 && LESS(key, a[j - 1]))                                     \
+        {                                                                       \
+            a[j] = a[j - 1];                                                    \
+            j--;                                                                \
+        }                                                                       \
+        a[j] = key;                                                             \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void name##_sift(T *a, size_t n, size_t i)                               \
+{                                                                               \
+    for(;;)                                                                     \
+    {                                                                           \
+        size_t largest = i, l = 2 * i + 1, r = l + 1;                           \
+        if(l < n && LESS(a[largest], a[l])) largest = l;                        \
+        if(r < n && LESS(a[largest], a[r])) largest = r;                        \
+        if(largest == i) return;                                                \
+        T tmp = a[i];                                                           \
+        a[i] = a[largest];                                                      \
+        a[largest] = tmp;                                                       \
+        i = largest;                                                            \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void name##_heap(T *a, size_t n)                                         \
+{                                                                               \
+    for(size_t i = n / 2; i-- > 0; ) name##_sift(a, n, i);                      \
+    for(size_t i = n - 1; i > 0; i--)                                           \
+    {                                                                           \
+        T tmp = a[0];                                                           \
+        a[0] = a[i];                                                            \
+        a[i] = tmp;                                                             \
+        name##_sift(a, i, 0);                                                   \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static size_t name##_med3(const T *a, size_t x, size_t y, size_t z)             \
+{                                                                               \
+    if(LESS(a[x], a[y]))                                                        \
+    {                                                                           \
+        if(LESS(a[y], a[z])) return y;                                          \
+        return LESS(a[x], a[z]) ? z : x;                                        \
+    }                                                                           \
+    if(LESS(a[x], a[z])) return x;                                              \
+    return LESS(a[y], a[z]) ? z : y;                                            \
+}                                                                               \
+                                                                                \
+static void name##_rec(T *a, size_t n, int depth)                               \
+{                                                                               \
+    while(n > INTRO_INSERTION_CUTOFF)                                           \
+    {                                                                           \
+        if(depth-- == 0)                                                        \
+        {                                                                       \
+            name##_heap(a, n);                                                  \
+            return;                                                             \
+        }                                                                       \
+                                                                                \
+        size_t mid = n / 2, p;                                                  \
+        if(n <= INTRO_NINTHER_CUTOFF) p = name##_med3(a, 0, mid, n - 1);        \
+        else                                                                    \
+        {                                                                       \
+            size_t s = n / 8;                                                   \
+            p = name##_med3(a, name##_med3(a, 0, s, 2 * s),                     \
+                               name##_med3(a, mid - s, mid, mid + s),           \
+                               name##_med3(a, n - 1 - 2 * s, n - 1 - s, n - 1));\
+        }                                                                       \
+                                                                                \
+        T pivot = a[p];                                                         \
+        size_t lt = 0, i = 0, gt = n - 1;                                       \
+        while(i <= gt)                                                          \
+        {                                                                       \
+            if(LESS(a[i], pivot))                                               \
+            {                                                                   \
+                T tmp = a[lt];                                                  \
+                a[lt++] = a[i];                                                 \
+                a[i++] = tmp;                                                   \
+            }                                                                   \
+            else if(LESS(pivot, a[i]))                                          \
+            {                                                                   \
+                T tmp = a[gt];                                                  \
+                a[gt--] = a[i];                                                 \
+                a[i] = tmp;                                                     \
+            }                                                                   \
+            else i++;                                                           \
+        }                                                                       \
+                                                                                \
+        /* a[0, lt) < pivot, a[lt, gt] == pivot, a(gt, n) > pivot */            \
+        size_t right = n - gt - 1;                                              \
+        if(lt < right)                                                          \
+        {                                                                       \
+            name##_rec(a, lt, depth);                                           \
+            a += gt + 1;                                                        \
+            n = right;                                                          \
+        }                                                                       \
+        else                                                                    \
+        {                                                                       \
+            name##_rec(a + gt + 1, right, depth);                               \
+            n = lt;                                                             \
+        }                                                                       \
+    }                                                                           \
+    name##_insertion(a, n);                                                     \
+}                                                                               \
+                                                                                \
+void name(T *arr, size_t n)                                                     \
+{                                                                               \
+    if(n < 2) return;                                                           \
+    int depth = 0;                                                              \
+    for(size_t m = n; m > 1; m >>= 1) depth += 2;                               \
+    name##_rec(arr, n, depth);                                                  \
+}
+
+DEFINE_TYPED_SORT(mathi_sort_i32, int32_t, SORT_LESS)
+DEFINE_TYPED_SORT(mathi_sort_u32, uint32_t, SORT_LESS)
+DEFINE_TYPED_SORT(mathi_sort_i64, int64_t, SORT_LESS)
+DEFINE_TYPED_SORT(mathi_sort_u64, uint64_t, SORT_LESS)
+DEFINE_TYPED_SORT(mathi_sort_f32, float, SORT_FLOAT_LESS)
+DEFINE_TYPED_SORT(mathi_sort_f64, double, SORT_FLOAT_LESS)
+
+/**
+ * @brief Swap two records of the given size.
+ */
+static void record_swap(char *a, char *b, size_t size)
+{
+    for(; size >= sizeof(uint64_t); size -= sizeof(uint64_t), a += sizeof(uint64_t), b += sizeof(uint64_t))
+    {
+        uint64_t t;
+        memcpy(&t, a, sizeof(t));
+        memcpy(a, b, sizeof(t));
+        memcpy(b, &t, sizeof(t));
+    }
+    for(; size > 0; size--, a++, b++)
+    {
+        char t = *a;
+        *a = *b;
+        *b = t;
+    }
+}
+
+/**
+ * @brief Generate an Introsort over fixed-size records keyed by a T at a byte offset.
+ *
+ * Keys are read with memcpy, so records need no particular alignment, and
+ * the pivot is held as a key rather than a whole record so no per-call
+ * record buffer is needed outside insertion sort.
+ */
+#define DEFINE_RECORD_SORT(name, T, LESS)                                       \
+static inline T name##_key(const char *base, size_t i, size_t size, size_t off) \
+{                                                                               \
+    T k;                                                                        \
+    memcpy(&k, base + i * size + off, sizeof(T));                               \
+    return k;                                                                   \
+}                                                                               \
+                                                                                \
+static void name##_insertion(char *a, size_t n, size_t size, size_t off,       \
+                             char *tmp)                                         \
+{                                                                               \
+    for(size_t i = 1; i < n; i++)                                               \
+    {                                                                           \
+        T key = name##_key(a, i, size, off);                                    \
+        size_t j = i;                                                           \
+        while(j > 0 && LESS(key, name##_key(a, j - 1, size, off))) j--;         \
+        if(j == i) continue;                                                    \
+        memcpy(tmp, a + i * size, size);                                        \
+        memmove(a + (j + 1) * size, a + j * size, (i - j) * size);              \
+        memcpy(a + j * size, tmp, size);                                        \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static void name##_sift(char *a, size_t n, size_t size, size_t off, size_t i)   \
+{                                                                               \
+    for(;;)                                                                     \
+    {                                                                           \
+        size_t largest = i, l = 2 * i + 1, r = l + 1;                           \
+        if(l < n && LESS(name##_key(a, largest, size, off),                     \
+                         name##_key(a, l, size, off))) largest = l;             \
+        if(r < n && LESS(name##_key(a, largest, size, off),                     \
+                         name##_key(a, r, size, off))) largest = r;             \
+        if(largest == i) return;                                                \
+        record_swap(a + i * size, a + largest * size, size);                    \
+        i = largest;                                                            \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static size_t name##_med3(const char *a, size_t size, size_t off,               \
+                          size_t x, size_t y, size_t z)                         \
+{                                                                               \
+    T kx = name##_key(a, x, size, off), ky = name##_key(a, y, size, off);       \
+    T kz = name##_key(a, z, size, off);                                         \
+    if(LESS(kx, ky))                                                            \
+    {                                                                           \
+        if(LESS(ky, kz)) return y;                                              \
+        return LESS(kx, kz) ? z : x;                                            \
+    }                                                                           \
+    if(LESS(kx, kz)) return x;                                                  \
+    return LESS(ky, kz) ? z : y;                                                \
+}                                                                               \
+                                                                                \
+static void name##_rec(char *a, size_t n, size_t size, size_t off, int depth,   \
+                       char *tmp)                                               \
+{                                                                               \
+    while(n > INTRO_INSERTION_CUTOFF)                                           \
+    {                                                                           \
+        if(depth-- == 0)                                                        \
+        {                                                                       \
+            for(size_t i = n / 2; i-- > 0; ) name##_sift(a, n, size, off, i);   \
+            for(size_t i = n - 1; i > 0; i--)                                   \
+            {                                                                   \
+                record_swap(a, a + i * size, size);                             \
+                name##_sift(a, i, size, off, 0);                                \
+            }                                                                   \
+            return;                                                             \
+        }                                                                       \
+                                                                                \
+        size_t mid = n / 2, s = n / 8;                                          \
+        size_t p = n <= INTRO_NINTHER_CUTOFF                                    \
+            ? name##_med3(a, size, off, 0, mid, n - 1)                          \
+            : name##_med3(a, size, off,                                         \
+                  name##_med3(a, size, off, 0, s, 2 * s),                       \
+                  name##_med3(a, size, off, mid - s, mid, mid + s),             \
+                  name##_med3(a, size, off, n - 1 - 2 * s, n - 1 - s, n - 1));  \
+                                                                                \
+        T pivot = name##_key(a, p, size, off);                                  \
+        size_t lt = 0, i = 0, gt = n - 1;                                       \
+        while(i <= gt)                                                          \
+        {                                                                       \
+            T k = name##_key(a, i, size, off);                                  \
+            if(LESS(k, pivot))                                                  \
+                record_swap(a + lt++ * size, a + i++ * size, size);             \
+            else if(LESS(pivot, k))                                             \
+                record_swap(a + i * size, a + gt-- * size, size);               \
+            else i++;                                                           \
+        }                                                                       \
+                                                                                \
+        size_t right = n - gt - 1;                                              \
+        if(lt < right)                                                          \
+        {                                                                       \
+            name##_rec(a, lt, size, off, depth, tmp);                           \
+            a += (gt + 1) * size;                                               \
+            n = right;                                                          \
+        }                                                                       \
+        else                                                                    \
+        {                                                                       \
+            name##_rec(a + (gt + 1) * size, right, size, off, depth, tmp);      \
+            n = lt;                                                             \
+        }                                                                       \
+    }                                                                           \
+    name##_insertion(a, n, size, off, tmp);                                     \
+}
+
+DEFINE_RECORD_SORT(record_sort_i32, int32_t, SORT_LESS)
+DEFINE_RECORD_SORT(record_sort_u32, uint32_t, SORT_LESS)
+DEFINE_RECORD_SORT(record_sort_i64, int64_t, SORT_LESS)
+DEFINE_RECORD_SORT(record_sort_u64, uint64_t, SORT_LESS)
+DEFINE_RECORD_SORT(record_sort_f32, float, SORT_FLOAT_LESS)
+DEFINE_RECORD_SORT(record_sort_f64, double, SORT_FLOAT_LESS)
+
+/**
+ * @brief Sort fixed-size records by a numeric key stored inside each record.
+ *
+ * Each key type has its own specialised Introsort, so comparisons are
+ * inlined and no function pointer is called per comparison.
+ *
+ * @param base Pointer to the first record.
+ * @param n Number of records.
+ * @param size Size of each record in bytes.
+ * @param key_offset Byte offset of the key within a record.
+ * @param key Type of the key.
+ * @return 0 on success, -1 on invalid arguments or allocation failure.
+ */
+int mathi_sort_records(void *base, size_t n, size_t size, size_t key_offset, MathiSortKey key)
+{
+    static const size_t key_sizes[] = {
+        sizeof(int32_t), sizeof(uint32_t), sizeof(int64_t), sizeof(uint64_t), sizeof(float), sizeof(double)
+    };
+    if(!base || (unsigned)key > MATHI_KEY_F64 || key_offset + key_sizes[key] > size) return -1;
+    if(n < 2) return 0;
+
+    char stack_tmp[256], *tmp = size <= sizeof(stack_tmp) ? stack_tmp : malloc(size);
+    if(!tmp) return -1;
+
+    int depth = 0;
+    for(size_t m = n; m > 1; m >>= 1) depth += 2;
+
+    switch(key)
+    {
+        case MATHI_KEY_I32: record_sort_i32_rec(base, n, size, key_offset, depth, tmp); break;
+        case MATHI_KEY_U32: record_sort_u32_rec(base, n, size, key_offset, depth, tmp); break;
+        case MATHI_KEY_I64: record_sort_i64_rec(base, n, size, key_offset, depth, tmp); break;
+        case MATHI_KEY_U64: record_sort_u64_rec(base, n, size, key_offset, depth, tmp); break;
+        case MATHI_KEY_F32: record_sort_f32_rec(base, n, size, key_offset, depth, tmp); break;
+        case MATHI_KEY_F64: record_sort_f64_rec(base, n, size, key_offset, depth, tmp); break;
+    }
+
+    if(tmp != stack_tmp) free(tmp);
+    return 0;
+}
+
+
+/**
+ * @brief Stable insertion sort of keys that moves vals alongside.
+ */
+static void pair_insertion_sort(int *keys, int *vals, int n)
+{
+    for(int i = 1; i < n; i++)
+    {
+        int k = keys[i], v = vals[i], j = i - 1;
+        while(j >= 0 && keys[j] > k)
+        {
+            keys[j + 1] = keys[j];
+            vals[j + 1] = vals[j];
+            j--;
+        }
+        keys[j + 1] = k;
+        vals[j + 1] = v;
+    }
+}
+
+/**
+ * @brief Sort keys and apply the same reordering to a parallel value array.
+ *
+ * Uses the LSD radix sort passes (single-pass histograms, trivial passes
+ * skipped) with the values scattered alongside the keys, so the sort is
+ * stable: equal keys keep their original value order.
+ *
+ * @param keys Pointer to the key array.
+ * @param vals Pointer to the value array, reordered with keys.
+ * @param n Number of elements.
+ * @return 0 on success, -1 on allocation failure (arrays left unchanged).
+ */
+int mathi_sort_pairs(int *keys, int *vals, int n)
+{
+    if(n < 2) return 0;
+    if(n < RADIX_SMALL_CUTOFF)
+    {
+        pair_insertion_sort(keys, vals, n);
+        return 0;
+    }
+
+    int *scratch = malloc(2 * (size_t)n * sizeof(int));
+    if(!scratch) return -1;
+
+    unsigned count[4][256];
+    memset(count, 0, sizeof(count));
+    for(int i = 0; i < n; i++)
+    {
+        unsigned k = (unsigned)keys[i] ^ 0x80000000u;
+        count[0][k & 0xFF]++;
+        count[1][(k >> 8) & 0xFF]++;
+        count[2][(k >> 16) & 0xFF]++;
+        count[3][k >> 24]++;
+    }
+
+    int *src_k = keys, *src_v = vals, *dst_k = scratch, *dst_v = scratch + n;
+    unsigned first = (unsigned)keys[0] ^ 0x80000000u;
+    for(int pass = 0; pass < 4; pass++)
+    {
+        int shift = pass * 8;
+        unsigned *c = count[pass];
+        if(c[(first >> shift) & 0xFF] == (unsigned)n) continue;
+
+        unsigned sum = 0;
+        for(int b = 0; b < 256; b++)
+        {
+            unsigned t = c[b];
+            c[b] = sum;
+            sum += t;
+        }
+
+        for(int i = 0; i < n; i++)
+        {
+            unsigned pos = c[(((unsigned)src_k[i] ^ 0x80000000u) >> shift) & 0xFF]++;
+            dst_k[pos] = src_k[i];
+            dst_v[pos] = src_v[i];
+        }
+
+        int *tk = src_k, *tv = src_v;
+        src_k = dst_k;
+        src_v = dst_v;
+        dst_k = tk;
+        dst_v = tv;
+    }
+
+    if(src_k != keys)
+    {
+        memcpy(keys, src_k, n * sizeof(int));
+        memcpy(vals, src_v, n * sizeof(int));
+    }
+    free(scratch);
+    return 0;
+}
+
+/**
+ * @brief Compute the stable sorting permutation of an array.
+ * @param keys Pointer to the key array (not modified).
+ * @param n Number of elements.
+ * @param idx Output array of n indices; keys[idx[0]] <= keys[idx[1]] <= ...
+ * @return 0 on success, -1 on allocation failure.
+ */
+int mathi_argsort(const int *keys, int n, int *idx)
+{
+    if(n <= 0) return 0;
+
+    int *tmp = malloc(n * sizeof(int));
+    if(!tmp) return -1;
+    memcpy(tmp, keys, n * sizeof(int));
+    for(int i = 0; i < n; i++) idx[i] = i;
+
+    int res = mathi_sort_pairs(tmp, idx, n);
+    free(tmp);
+    return res;
+}
+
+/* Distance, in elements, at which gather prefetches upcoming source rows. */
+#define GATHER_PREFETCH 16
+
+/* Indices processed per block by mathi_gather_columns. */
+#define GATHER_BLOCK 4096
+
+/**
+ * @brief Gather rows of one column through a permutation: dst[i] = src[idx[i]].
+ *
+ * Four- and eight-byte elements get dedicated copy loops; every element
+ * prefetches the source row GATHER_PREFETCH positions ahead.
+ *
+ * @param idx Permutation (or any index list) of length n.
+ * @param n Number of elements to gather.
+ * @param src Source column.
+ * @param dst Destination column (must not overlap src).
+ * @param size Size of each element in bytes.
+ */
+void mathi_gather(const int *idx, int n, const void *src, void *dst, size_t size)
+{
+    const char *s = src;
+    char *d = dst;
+
+    if(size == sizeof(uint32_t))
+    {
+        const uint32_t *s4 = src;
+        uint32_t *d4 = dst;
+        for(int i = 0; i < n; i++)
+        {
+#ifdef __GNUC__
+            if(i + GATHER_PREFETCH < n) __builtin_prefetch(s4 + idx[i + GATHER_PREFETCH]);
+#endif
+            d4[i] = s4[idx[i]];
+        }
+    }
+    else if(size == sizeof(uint64_t))
+    {
+        const uint64_t *s8 = src;
+        uint64_t *d8 = dst;
+        for(int i = 0; i < n; i++)
+        {
+#ifdef __GNUC__
+            if(i + GATHER_PREFETCH < n) __builtin_prefetch(s8 + idx[i + GATHER_PREFETCH]);
+#endif
+            d8[i] = s8[idx[i]];
+        }
+    }
+    else
+        for(int i = 0; i < n; i++)
+        {
+#ifdef __GNUC__
+            if(i + GATHER_PREFETCH < n) __builtin_prefetch(s + (size_t)idx[i + GATHER_PREFETCH] * size);
+#endif
+            memcpy(d + (size_t)i * size, s + (size_t)idx[i] * size, size);
+        }
+}
+
+/**
+ * @brief Apply one permutation to several columns, block by block.
+ *
+ * Walks the index list in blocks of GATHER_BLOCK and gathers every column
+ * for a block before moving on, so the block of indices stays in L1 while
+ * all columns read it.
+ *
+ * @param idx Permutation (or any index list) of length n.
+ * @param n Number of rows to gather.
+ * @param src Array of ncols source columns.
+ * @param dst Array of ncols destination columns (must not overlap the sources).
+ * @param sizes Element size in bytes of each column.
+ * @param ncols Number of columns.
+ */
+void mathi_gather_columns(const int *idx, int n, const void *const *src, void *const *dst,
+                          const size_t *sizes, int ncols)
+{
+    for(int base = 0; base < n; base += GATHER_BLOCK)
+    {
+        int len = n - base < GATHER_BLOCK ? n - base : GATHER_BLOCK;
+        for(int c = 0; c < ncols; c++)
+            mathi_gather(idx + base, len, src[c], (char *)dst[c] + (size_t)base * sizes[c], sizes[c]);
+    }
+}
+
+
+/* Smallest run length, in ints, used by the external sort regardless of budget. */
+#define EXT_MIN_RUN 1024
+
+/* Largest in-memory run, in ints (keeps run lengths within int range). */
+#define EXT_MAX_RUN (1 << 28)
+
+/* Most runs merged at once, keeping the number of open files modest. */
+#define EXT_MAX_FANIN 256
+
+/* Smallest per-buffer block, in ints, the merge phase aims for when picking its fan-in. */
+#define EXT_MIN_BLOCK 4096
+
+/* One queued read or write for the background I/O thread. */
+typedef struct
+{
+    FILE *f;
+    int *buf;
+    size_t count;
+    int write;
+} ExtJob;
+
+/* Background I/O thread executing jobs in submission (FIFO) order. */
+typedef struct
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    ExtJob *jobs;
+    size_t cap;
+    size_t submitted;
+    size_t completed;
+    int quit;
+    int error;
+} ExtIO;
+
+static void *ext_io_worker(void *p)
+{
+    ExtIO *io = p;
+    pthread_mutex_lock(&io->lock);
+    for(;;)
+    {
+        while(io->completed == io->submitted && !io->quit)
+            pthread_cond_wait(&io->cond, &io->lock);
+        if(io->completed == io->submitted) break;
+
+        ExtJob job = io->jobs[io->completed % io->cap];
+        pthread_mutex_unlock(&io->lock);
+
+        size_t done = job.write ? fwrite(job.buf, sizeof(int), job.count, job.f)
+                                : fread(job.buf, sizeof(int), job.count, job.f);
+
+        pthread_mutex_lock(&io->lock);
+        if(done != job.count) io->error = 1;
+        io->completed++;
+        pthread_cond_broadcast(&io->cond);
+    }
+    pthread_mutex_unlock(&io->lock);
+    return NULL;
+}
+
+static int ext_io_start(ExtIO *io, size_t cap)
+{
+    memset(io, 0, sizeof(*io));
+    io->cap = cap;
+    io->jobs = malloc(cap * sizeof(ExtJob));
+    if(!io->jobs) return -1;
+    pthread_mutex_init(&io->lock, NULL);
+    pthread_cond_init(&io->cond, NULL);
+    if(pthread_create(&io->thread, NULL, ext_io_worker, io) != 0)
+    {
+        pthread_mutex_destroy(&io->lock);
+        pthread_cond_destroy(&io->cond);
+        free(io->jobs);
+        return -1;
+    }
+    return 0;
+}
+
+/* Drain the queue, join the thread and return the sticky error flag. */
+static int ext_io_stop(ExtIO *io)
+{
+    pthread_mutex_lock(&io->lock);
+    io->quit = 1;
+    pthread_cond_broadcast(&io->cond);
+    pthread_mutex_unlock(&io->lock);
+    pthread_join(io->thread, NULL);
+    pthread_mutex_destroy(&io->lock);
+    pthread_cond_destroy(&io->cond);
+    free(io->jobs);
+    return io->error ? -1 : 0;
+}
+
+/* Queue a job and return its ticket. */
+static size_t ext_io_submit(ExtIO *io, FILE *f, int *buf, size_t count, int write)
+{
+    pthread_mutex_lock(&io->lock);
+    while(io->submitted - io->completed == io->cap)
+        pthread_cond_wait(&io->cond, &io->lock);
+    ExtJob job = {f, buf, count, write};
+    io->jobs[io->submitted % io->cap] = job;
+    size_t ticket = io->submitted++;
+    pthread_cond_broadcast(&io->cond);
+    pthread_mutex_unlock(&io->lock);
+    return ticket;
+}
+
+/* Wait until the job with the given ticket (and every earlier one) is done. */
+static int ext_io_wait(ExtIO *io, size_t ticket)
+{
+    pthread_mutex_lock(&io->lock);
+    while(io->completed <= ticket)
+        pthread_cond_wait(&io->cond, &io->lock);
+    int err = io->error;
+    pthread_mutex_unlock(&io->lock);
+    return err ? -1 : 0;
+}
+
+/* A sorted run spilled to a temporary file. */
+typedef struct
+{
+    char *path;
+    size_t count;
+} ExtRunFile;
+
+/* Merge-phase reader for one run: two blocks, one consumed while the other is read ahead. */
+typedef struct
+{
+    FILE *f;
+    int *buf[2];
+    size_t len[2];
+    size_t ticket[2];
+    size_t left;
+    size_t pos;
+    int cur;
+    int done;
+} ExtReader;
+
+static char *ext_run_path(const char *out_path, size_t id)
+{
+    size_t len = strlen(out_path) + 32;
+    char *path = malloc(len);
+    if(path) snprintf(path, len, "%s.run%zu", out_path, id);
+    return path;
+}
+
+/* Leaf a beats leaf b: exhausted runs lose to everything. */
+static inline int ext_beats(const ExtReader *r, int a, int b)
+{
+    if(r[a].done) return 0;
+    if(r[b].done) return 1;
+    return r[a].buf[r[a].cur][r[a].pos] < r[b].buf[r[b].cur][r[b].pos];
+}
+
+/* Step reader r to its next element, switching to the read-ahead block when needed. */
+static int ext_reader_advance(ExtIO *io, ExtReader *r, size_t block)
+{
+    if(++r->pos < r->len[r->cur]) return 0;
+
+    int old = r->cur;
+    r->cur ^= 1;
+    r->pos = 0;
+    if(r->len[r->cur] == 0)
+    {
+        r->done = 1;
+        return 0;
+    }
+    if(r->left > 0)
+    {
+        r->len[old] = r->left < block ? r->left : block;
+        r->left -= r->len[old];
+        r->ticket[old] = ext_io_submit(io, r->f, r->buf[old], r->len[old], 0);
+    }
+    else
+        r->len[old] = 0;
+    return ext_io_wait(io, r->ticket[r->cur]);
+}
+
+/**
+ * @brief k-way merge of runs[0..k) into out through a loser tree.
+ *
+ * Each run is read through two blocks of `block` ints and the output is
+ * written from two blocks, all via the background I/O thread, so reading,
+ * merging and writing overlap.
+ */
+static int ext_merge(const ExtRunFile *runs, int k, FILE *out, size_t block)
+{
+    ExtIO io;
+    ExtReader *rd = calloc(k, sizeof(ExtReader));
+    int *tree = malloc((size_t)k * sizeof(int));
+    int *win = malloc(2 * (size_t)k * sizeof(int));
+    int *mem = malloc((2 * (size_t)k + 2) * block * sizeof(int));
+
+    if(!rd || !tree || !win || !mem || ext_io_start(&io, 2 * (size_t)k + 4) != 0)
+    {
+        free(rd);
+        free(tree);
+        free(win);
+        free(mem);
+        return -1;
+    }
+
+    int res = -1, opened = 0;
+    int *obuf[2] = {mem + 2 * (size_t)k * block, mem + (2 * (size_t)k + 1) * block};
+    size_t oticket[2] = {0, 0};
+    int opending[2] = {0, 0};
+    int ocur = 0;
+    size_t opos = 0;
+
+    for(; opened < k; opened++)
+    {
+        ExtReader *r = &rd[opened];
+        r->f = mathi_filex_open(runs[opened].path, "rb");
+        if(!r->f) goto done;
+        r->buf[0] = mem + (size_t)opened * 2 * block;
+        r->buf[1] = r->buf[0] + block;
+        r->left = runs[opened].count;
+        for(int b = 0; b < 2; b++)
+        {
+            r->len[b] = r->left < block ? r->left : block;
+            r->left -= r->len[b];
+            if(r->len[b]) r->ticket[b] = ext_io_submit(&io, r->f, r->buf[b], r->len[b], 0);
+        }
+        r->done = r->len[0] == 0;
+    }
+    for(int i = 0; i < k; i++)
+        if(!rd[i].done && ext_io_wait(&io, rd[i].ticket[0]) != 0) goto done;
+
+    // Leaves live at k..2k-1, losers at 1..k-1 and the overall winner at 0.
+    for(int i = 0; i < k; i++) win[k + i] = i;
+    for(int p = k - 1; p >= 1; p--)
+    {
+        int a = win[2 * p], b = win[2 * p + 1];
+        win[p] = ext_beats(rd, b, a) ? b : a;
+        tree[p] = win[p] == a ? b : a;
+    }
+    tree[0] = k > 1 ? win[1] : 0;
+
+    while(!rd[tree[0]].done)
+    {
+        int w = tree[0];
+        ExtReader *r = &rd[w];
+        obuf[ocur][opos++] = r->buf[r->cur][r->pos];
+        if(opos == block)
+        {
+            oticket[ocur] = ext_io_submit(&io, out, obuf[ocur], opos, 1);
+            opending[ocur] = 1;
+            ocur ^= 1;
+            opos = 0;
+            if(opending[ocur] && ext_io_wait(&io, oticket[ocur]) != 0) goto done;
+            opending[ocur] = 0;
+        }
+        if(ext_reader_advance(&io, r, block) != 0) goto done;
+
+        for(int p = (w + k) / 2; p > 0; p /= 2)
+            if(ext_beats(rd, tree[p], w))
+            {
+                int t = tree[p];
+                tree[p] = w;
+                w = t;
+            }
+        tree[0] = w;
+    }
+    if(opos) ext_io_submit(&io, out, obuf[ocur], opos, 1);
+    res = 0;
+
+done:
+    // Stopping drains every queued job before the files and buffers go away.
+    if(ext_io_stop(&io) != 0) res = -1;
+    for(int i = 0; i < opened; i++) mathi_filex_close(rd[i].f);
+    free(rd);
+    free(tree);
+    free(win);
+    free(mem);
+    return res;
+}
+
+static void ext_remove_runs(ExtRunFile *runs, size_t nruns)
+{
+    for(size_t i = 0; i < nruns; i++)
+    {
+        if(runs[i].path)
+        {
+            mathi_file_delete(runs[i].path);
+            free(runs[i].path);
+        }
+    }
+    free(runs);
+}
+
+/**
+ * @brief Phase 1: read the input in run_len chunks, radix sort each and spill it.
+ *
+ * Two chunk buffers alternate: while one is sorted the I/O thread writes the
+ * previous run and reads the next chunk. When the whole input fits in one
+ * run it is written straight to out_path and *nruns is left at 0.
+ */
+static int ext_make_runs(FILE *in, size_t total, const char *out_path, size_t run_len,
+                         ExtRunFile **runs_out, size_t *nruns)
+{
+    size_t max_runs = (total + run_len - 1) / run_len;
+    ExtRunFile *runs = calloc(max_runs ? max_runs : 1, sizeof(ExtRunFile));
+    int *mem = malloc(3 * run_len * sizeof(int));
+    ExtIO io;
+
+    *runs_out = runs;
+    *nruns = 0;
+    if(!runs || !mem || ext_io_start(&io, 4) != 0)
+    {
+        free(mem);
+        return -1;
+    }
+
+    int *buf[2] = {mem, mem + run_len};
+    int *scratch = mem + 2 * run_len;
+    FILE *files[2] = {NULL, NULL};
+    int res = -1;
+
+    size_t len = total < run_len ? total : run_len;
+    size_t rticket = ext_io_submit(&io, in, buf[0], len, 0);
+    size_t read_pos = len;
+
+    for(size_t r = 0; r < max_runs; r++)
+    {
+        int cur = r & 1;
+        if(ext_io_wait(&io, rticket) != 0) goto done;
+
+        // Read ahead into the other buffer; FIFO order means its pending write finishes first.
+        size_t next = total - read_pos < run_len ? total - read_pos : run_len;
+        if(next) rticket = ext_io_submit(&io, in, buf[cur ^ 1], next, 0);
+
+        mathi_radix_sort_buf(buf[cur], (int)len, scratch);
+
+        if(max_runs == 1)
+        {
+            FILE *out = mathi_filex_open(out_path, "wb");
+            if(!out) goto done;
+            int err = ext_io_wait(&io, ext_io_submit(&io, out, buf[cur], len, 1));
+            if(fclose(out) != 0 || err) goto done;
+            break;
+        }
+
+        // The run written from this buffer two iterations ago is complete: its
+        // write was queued before the read just waited for.
+        if(files[cur]) mathi_filex_close(files[cur]);
+        files[cur] = NULL;
+        runs[r].path = ext_run_path(out_path, r);
+        runs[r].count = len;
+        *nruns = r + 1;
+        if(!runs[r].path) goto done;
+        files[cur] = mathi_filex_open(runs[r].path, "wb");
+        if(!files[cur]) goto done;
+        ext_io_submit(&io, files[cur], buf[cur], len, 1);
+
+        read_pos += next;
+        len = next;
+    }
+    res = 0;
+
+done:
+    if(ext_io_stop(&io) != 0) res = -1;
+    for(int i = 0; i < 2; i++)
+        if(files[i] && fclose(files[i]) != 0) res = -1;
+    free(mem);
+    return res;
+}
+
+/**
+ * @brief Sort a binary file of native-endian ints that may be larger than memory.
+ *
+ * Phase 1 reads chunks that fit in the budget, radix sorts them and spills
+ * each as a temporary run file next to out_path (`<out_path>.runN`). Phase 2
+ * merges the runs with a loser tree, in several passes if the budget cannot
+ * hold a reasonably sized block per run. A background I/O thread performs
+ * all reads and writes so that disk transfers overlap sorting and merging.
+ * Input and output may be the same path.
+ *
+ * @param in_path Path of the unsorted input file.
+ * @param out_path Path of the sorted output file (created or truncated).
+ * @param mem_budget Approximate number of bytes of working memory to use.
+ * @return 0 on success, -1 on I/O error, malformed input or allocation failure.
+ */
+int mathi_external_sort(const char *in_path, const char *out_path, size_t mem_budget)
+{
+    if(!in_path || !out_path) return -1;
+
+    long size = mathi_file_size(in_path);
+    if(size < 0 || size % sizeof(int) != 0) return -1;
+    size_t total = (size_t)size / sizeof(int);
+
+    size_t run_len = mem_budget / (3 * sizeof(int));
+    if(run_len < EXT_MIN_RUN) run_len = EXT_MIN_RUN;
+    if(run_len > EXT_MAX_RUN) run_len = EXT_MAX_RUN;
+    if(total > 0 && run_len > total) run_len = total;
+
+    if(total == 0)
+    {
+        FILE *out = mathi_filex_open(out_path, "wb");
+        if(!out) return -1;
+        return fclose(out) == 0 ? 0 : -1;
+    }
+
+    FILE *in = mathi_filex_open(in_path, "rb");
+    if(!in) return -1;
+
+    ExtRunFile *runs;
+    size_t nruns;
+    int res = ext_make_runs(in, total, out_path, run_len, &runs, &nruns);
+    mathi_filex_close(in);
+    if(res != 0 || nruns == 0)
+    {
+        ext_remove_runs(runs, nruns);
+        return res;
+    }
+
+    // Fan-in: as many runs as leave EXT_MIN_BLOCK ints for each of 2k + 2 blocks.
+    size_t fanin = mem_budget / (EXT_MIN_BLOCK * sizeof(int));
+    fanin = fanin > 4 ? fanin / 2 - 1 : 2;
+    if(fanin > EXT_MAX_FANIN) fanin = EXT_MAX_FANIN;
+
+    size_t next_id = nruns;
+    while(res == 0 && nruns > 1)
+    {
+        size_t k = nruns < fanin ? nruns : fanin;
+        size_t block = mem_budget / ((2 * k + 2) * sizeof(int));
+        if(block < EXT_MIN_BLOCK) block = EXT_MIN_BLOCK;
+
+        FILE *out;
+        ExtRunFile merged = {NULL, 0};
+        if(k == nruns)
+            out = mathi_filex_open(out_path, "wb");
+        else
+        {
+            merged.path = ext_run_path(out_path, next_id++);
+            out = merged.path ? mathi_filex_open(merged.path, "wb") : NULL;
+        }
+        if(!out)
+        {
+            free(merged.path);
+            res = -1;
+            break;
+        }
+
+        res = ext_merge(runs, (int)k, out, block);
+        if(fclose(out) != 0) res = -1;
+
+        for(size_t i = 0; i < k; i++)
+        {
+            merged.count += runs[i].count;
+            mathi_file_delete(runs[i].path);
+            free(runs[i].path);
+        }
+        memmove(runs, runs + k, (nruns - k) * sizeof(ExtRunFile));
+        nruns -= k;
+        if(merged.path)
+        {
+            runs[nruns++] = merged;     // merged runs queue at the back, keeping passes balanced
+            if(res != 0)
+            {
+                ext_remove_runs(runs, nruns);
+                return res;
+            }
+        }
+        else
+            break;
+    }
+
+    ext_remove_runs(runs, nruns);
+    return res;
+}
+
+
+/* Selection ranges at or below this size are finished by insertion sort. */
+#define SELECT_INSERTION_CUTOFF 16
+
+static void select_rec(int *arr, int low, int high, int k, int budget);
+
+/**
+ * @brief Median-of-medians pivot for [low, high].
+ *
+ * Sorts groups of five, gathers their medians at the front of the range
+ * and selects the median of those with the guaranteed-linear selection
+ * (budget 0), so the pivot always leaves at least ~30% on each side.
+ *
+ * @return Pivot value.
+ */
+static int mom_pivot(int *arr, int low, int high)
+{
+    int m = 0;
+    for(int i = low; i <= high; i += 5)
+    {
+        int end = i + 4 <= high ? i + 4 : high;
+        insertion_sort_range(arr, i, end);
+        int med = i + (end - i) / 2;
+        int tmp = arr[low + m];
+        arr[low + m] = arr[med];
+        arr[med] = tmp;
+        m++;
+    }
+    int k = low + (m - 1) / 2;
+    select_rec(arr, low, low + m - 1, k, 0);
+    return arr[k];
+}
+
+/**
+ * @brief Introselect loop: narrow [low, high] until position k is settled.
+ *
+ * Uses the Introsort pivot (median-of-three / ninther) while the budget
+ * lasts and median-of-medians afterwards, which bounds the worst case at
+ * O(n) while keeping the common case as fast as quickselect.
+ *
+ * @param budget Cheap-pivot partitions allowed before falling back to median-of-medians.
+ */
+static void select_rec(int *arr, int low, int high, int k, int budget)
+{
+    while(high - low + 1 > SELECT_INSERTION_CUTOFF)
+    {
+        int pivot = budget-- > 0 ? arr[choose_pivot(arr, low, high)] : mom_pivot(arr, low, high);
+        int lt, gt;
+        partition3(arr, low, high, pivot, &lt, &gt);
+
+        if(k < lt) high = lt - 1;
+        else if(k > gt) low = gt + 1;
+        else return;
+    }
+    insertion_sort_range(arr, low, high);
+}
+
+/**
+ * @brief Partially reorder an array so that arr[k] holds its sorted value.
+ *
+ * Afterwards every element before k is <= arr[k] and every element after
+ * it is >= arr[k]. Runs in O(n) (introselect with a median-of-medians
+ * fallback).
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ * @param k Position to settle (0 <= k < n); out-of-range k is ignored.
+ */
+void mathi_nth_element(int *arr, int n, int k)
+{
+    if(n < 2 || k < 0 || k >= n) return;
+    int budget = 0;
+    for(int m = n; m > 1; m >>= 1) budget += 2;
+    select_rec(arr, 0, n - 1, k, budget);
+}
+
+/**
+ * @brief Move the k smallest values to the front of the array, sorted.
+ *
+ * The remaining n - k elements end up in unspecified order. Runs in
+ * O(n + k log k).
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ * @param k Number of smallest values to sort into place (clamped to n).
+ */
+void mathi_partial_sort(int *arr, int n, int k)
+{
+    if(k <= 0 || n < 2) return;
+    if(k >= n)
+    {
+        mathi_intro_sort(arr, n);
+        return;
+    }
+    mathi_nth_element(arr, n, k - 1);
+    mathi_intro_sort(arr, k - 1);
+}
+
+/**
+ * @brief Create a streaming top-k tracker.
+ * @param k Number of largest values to keep.
+ * @return New tracker, or NULL if k <= 0 or allocation fails.
+ */
+MathiTopK* mathi_topk_new(int k)
+{
+    if(k <= 0) return NULL;
+    MathiTopK *t = malloc(sizeof(MathiTopK));
+    if(!t) return NULL;
+    t->heap = malloc(k * sizeof(int));
+    if(!t->heap)
+    {
+        free(t);
+        return NULL;
+    }
+    t->k = k;
+    t->size = 0;
+    return t;
+}
+
+/* Restore the min-heap property downward from index i. */
+static void topk_sift_down(int *heap, int size, int i)
+{
+    int v = heap[i];
+    for(;;)
+    {
+        int c = 2 * i + 1;
+        if(c >= size) break;
+        if(c + 1 < size && heap[c + 1] < heap[c]) c++;
+        if(heap[c] >= v) break;
+        heap[i] = heap[c];
+        i = c;
+    }
+    heap[i] = v;
+}
+
+/**
+ * @brief Offer one value to the tracker.
+ *
+ * The tracker keeps a min-heap of the k largest values seen so far, so
+ * each push is O(1) when the value is not in the current top k and
+ * O(log k) otherwise.
+ *
+ * @param t Tracker.
+ * @param v Value to offer.
+ */
+void mathi_topk_push(MathiTopK *t, int v)
+{
+    if(t->size < t->k)
+    {
+        int i = t->size++;
+        while(i > 0 && t->heap[(i - 1) / 2] > v)
+        {
+            t->heap[i] = t->heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        t->heap[i] = v;
+    }
+    else if(v > t->heap[0])
+    {
+        t->heap[0] = v;
+        topk_sift_down(t->heap, t->size, 0);
+    }
+}
+
+/**
+ * @brief Offer a batch of values to the tracker.
+ * @param t Tracker.
+ * @param arr Values to offer.
+ * @param n Number of values.
+ */
+void mathi_topk_push_array(MathiTopK *t, const int *arr, int n)
+{
+    int i = 0;
+    for(; i < n && t->size < t->k; i++) mathi_topk_push(t, arr[i]);
+    int *heap = t->heap;
+    for(; i < n; i++)
+        if(arr[i] > heap[0])
+        {
+            heap[0] = arr[i];
+            topk_sift_down(heap, t->size, 0);
+        }
+}
+
+/**
+ * @brief Copy the current top values out, largest first.
+ * @param t Tracker.
+ * @param out Output array with room for k values.
+ * @return Number of values written (min(k, values pushed)).
+ */
+int mathi_topk_result(const MathiTopK *t, int *out)
+{
+    memcpy(out, t->heap, t->size * sizeof(int));
+    mathi_intro_sort(out, t->size);
+    for(int i = 0, j = t->size - 1; i < j; i++, j--)
+    {
+        int tmp = out[i];
+        out[i] = out[j];
+        out[j] = tmp;
+    }
+    return t->size;
+}
+
+/**
+ * @brief Free a top-k tracker.
+ * @param t Tracker (may be NULL).
+ */
+void mathi_topk_free(MathiTopK *t)
+{
+    if(!t) return;
+    free(t->heap);
+    free(t);
+}
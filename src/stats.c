@@ -7,6 +7,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include "mathi/sort.h"
+#include "mathi/array.h"
+#include "mathi/intmap.h"
 
 /**
  * @brief Calculate the mean (average) of an integer array.
@@ -17,13 +20,12 @@
 double mathi_mean(int *arr, int n)
 {
     if(n <= 0) return 0;
-    double sum = 0;
-    for(int i = 0; i < n; i++) sum += arr[i];
-    return sum / n;
+    return (double)mathi_arr_sum(arr, (size_t)n) / n;
 }
 
 /**
  * @brief Comparison function for integers (used by qsort).
+ * @deprecated No longer used by the library; kept for existing callers.
  */
 int cmp_int(const void *a, const void *b)
 {
@@ -40,10 +42,19 @@ double mathi_median(int *arr, int n)
 {
     if(n <= 0) return 0;
     int *copy = malloc(n * sizeof(int));
+    if(!copy) return 0;
     for(int i = 0; i < n; i++) copy[i] = arr[i];
-    qsort(copy, n, sizeof(int), cmp_int);
 
-    double med = (n % 2) ? copy[n/2] : (copy[n/2 - 1] + copy[n/2]) / 2.0;
+    int mid = n / 2;
+    mathi_nth_element(copy, n, mid);
+    double med = copy[mid];
+    if(n % 2 == 0)
+    {
+        // the lower middle value is the largest element left of mid
+        int lower = copy[0];
+        for(int i = 1; i < mid; i++) if(copy[i] > lower) lower = copy[i];
+        med = (lower + med) / 2.0;
+    }
 
     free(copy);
     return med;
@@ -58,9 +69,8 @@ double mathi_median(int *arr, int n)
 double mathi_variance(int *arr, int n)
 {
     if(n <= 0) return 0;
-    double m = mathi_mean(arr, n), sum = 0;
-    for(int i = 0; i < n; i++) sum += (arr[i] - m) * (arr[i] - m);
-    return n > 1 ? sum / (n - 1) : 0;
+    double m = mathi_mean(arr, n);
+    return n > 1 ? mathi_arr_sqdev(arr, (size_t)n, m) / (n - 1) : 0;
 }
 
 /**
@@ -74,25 +84,44 @@ double mathi_stddev(int *arr, int n)
     return sqrt(mathi_variance(arr, n));
 }
 
-/**
- * @brief Calculate the mode (most frequent value) of an integer array.
- * @param arr Pointer to the array.
- * @param n Number of elements in the array.
- * @return Mode value. Returns 0 if n <= 0.
+/*
+ * Mode by counting pairs, without allocating: O(n^2), the last resort when
+ * neither the count table nor a sorted copy can be allocated.
  */
-int mathi_mode(int *arr, int n)
+static int mode_scan(const int *arr, int n)
+{
+    int mode = arr[0], max_count = 0;
+    for(int i = 0; i < n; i++)
+    {
+        int count = 0;
+        for(int j = 0; j < n; j++) count += arr[j] == arr[i];
+        if(count > max_count || (count == max_count && arr[i] < mode))
+        {
+            max_count = count;
+            mode = arr[i];
+        }
+    }
+    return mode;
+}
+
+/*
+ * Mode by sorting a copy and counting runs, for when the count table cannot
+ * be allocated. Scans without allocating if the copy cannot be allocated either.
+ */
+static int mode_sorted(const int *arr, int n)
 {
-    if(n <= 0) return 0;
     int *copy = malloc(n * sizeof(int));
+    if(!copy) return mode_scan(arr, n);
     for(int i = 0; i < n; i++) copy[i] = arr[i];
-    qsort(copy, n, sizeof(int), cmp_int);
+    mathi_sort_i32(copy, (size_t)n);
 
+    // Runs come in ascending order, so only a strictly longer run replaces the best.
     int mode = copy[0], max_count = 1, count = 1;
-    for(int i = 1; i < n; i++) 
+    for(int i = 1; i < n; i++)
     {
         if(copy[i] == copy[i-1]) count++;
         else count = 1;
-        if(count > max_count) 
+        if(count > max_count)
         {
             max_count = count;
             mode = copy[i];
@@ -103,6 +132,46 @@ int mathi_mode(int *arr, int n)
     return mode;
 }
 
+/**
+ * @brief Calculate the mode (most frequent value) of an integer array.
+ *
+ * Counts occurrences in a MathiI32Map in one expected O(n) pass. Ties go to
+ * the smallest value. If the map cannot be allocated, sorts a copy instead,
+ * and without memory for the copy falls back to an O(n^2) scan.
+ *
+ * @param arr Pointer to the array.
+ * @param n Number of elements in the array.
+ * @return Mode value. Returns 0 if n <= 0.
+ */
+int mathi_mode(int *arr, int n)
+{
+    if(n <= 0) return 0;
+
+    MathiI32Map counts;
+    if(mathi_i32map_init(&counts, 0) != 0) return mode_sorted(arr, n);
+
+    int mode = arr[0];
+    int64_t max_count = 0;
+    for(int i = 0; i < n; i++)
+    {
+        int64_t *count = mathi_i32map_emplace(&counts, arr[i], NULL);
+        if(!count)
+        {
+            mathi_i32map_free(&counts);
+            return mode_sorted(arr, n);
+        }
+        // Counts only grow, so the running best ends as the most frequent value, smallest on ties.
+        if(++*count > max_count || (*count == max_count && arr[i] < mode))
+        {
+            max_count = *count;
+            mode = arr[i];
+        }
+    }
+
+    mathi_i32map_free(&counts);
+    return mode;
+}
+
 /**
  * @brief Calculate the percentile of an integer array.
  * @param arr Pointer to the array.
@@ -114,15 +183,25 @@ double mathi_percentile(int *arr, int n, double p)
 {
     if(n <= 0) return 0;
     int *copy = malloc(n * sizeof(int));
+    if(!copy) return 0;
     for(int i = 0; i < n; i++) copy[i] = arr[i];
-    qsort(copy, n, sizeof(int), cmp_int);
 
+    if(p < 0) p = 0;
+    if(p > 100) p = 100;
     double rank = (p / 100.0) * (n - 1);
     int lo = (int)rank, hi = lo + 1;
     double frac = rank - lo;
+
+    mathi_nth_element(copy, n, lo);
     double val = copy[lo];
-    if(hi < n) val += frac * (copy[hi] - copy[lo]);
+    if(hi < n)
+    {
+        // the next order statistic is the smallest element right of lo
+        int next = copy[hi];
+        for(int i = hi + 1; i < n; i++) if(copy[i] < next) next = copy[i];
+        val += frac * ((double)next - copy[lo]);
+    }
 
     free(copy);
     return val;
-}
\ No newline at end of file
+}
@@ -5,7 +5,11 @@
  */
 
 #include "mathi/sys.h"
+#include "mathi_internal.h"
 #include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <string.h>
@@ -39,4 +43,90 @@ int mathi_set_env(const char *name, const char *value, int overwrite)
 #else
     return (setenv(name, value, overwrite ? 1 : 0) == 0) ? 1 : 0;
 #endif
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Check whether the running CPU supports AVX2.
+ *
+ * The CPUID probe runs on the first call; later calls, from any thread,
+ * return the cached answer.
+ *
+ * @return 1 if supported, 0 otherwise.
+ */
+int mathi_cpu_has_avx2(void)
+{
+    // -1 until probed. Racing first calls store the same answer, so relaxed ordering suffices.
+    static atomic_int cached = -1;
+    int has = atomic_load_explicit(&cached, memory_order_relaxed);
+    if(has >= 0) return has;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    has = __builtin_cpu_supports("avx2") ? 1 : 0;
+#else
+    has = 0;
+#endif
+    atomic_store_explicit(&cached, has, memory_order_relaxed);
+    return has;
+}
+
+int mathi_default_threads(int threads)
+{
+    if(threads > 0) return threads;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+typedef struct {
+    void (*fn)(void *ctx, int slice);
+    void *ctx;
+    int slice;
+    int spawned;
+} SliceThread;
+
+static void* slice_thread_main(void *p)
+{
+    SliceThread *st = p;
+    st->fn(st->ctx, st->slice);
+    return NULL;
+}
+
+/* mathi_run_slices keeps the bookkeeping for up to this many slices on the stack. */
+#define RUN_SLICES_STACK 64
+
+void mathi_run_slices(void (*fn)(void *ctx, int slice), void *ctx, int nslices)
+{
+    pthread_t tids_buf[RUN_SLICES_STACK];
+    SliceThread threads_buf[RUN_SLICES_STACK];
+    pthread_t *tids = tids_buf;
+    SliceThread *threads = threads_buf;
+    if(nslices > RUN_SLICES_STACK)
+    {
+        tids = malloc(nslices * sizeof(pthread_t));
+        threads = malloc(nslices * sizeof(SliceThread));
+        if(!tids || !threads)
+        {
+            free(tids);
+            free(threads);
+            for(int i = 0; i < nslices; i++) fn(ctx, i);
+            return;
+        }
+    }
+
+    for(int i = 1; i < nslices; i++)
+    {
+        threads[i] = (SliceThread){fn, ctx, i, 0};
+        threads[i].spawned = pthread_create(&tids[i], NULL, slice_thread_main, &threads[i]) == 0;
+    }
+    if(nslices > 0) fn(ctx, 0);
+    for(int i = 1; i < nslices; i++)
+        if(!threads[i].spawned) fn(ctx, i);
+    for(int i = 1; i < nslices; i++)
+        if(threads[i].spawned) pthread_join(tids[i], NULL);
+
+    if(tids != tids_buf)
+    {
+        free(tids);
+        free(threads);
+    }
+}
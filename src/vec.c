@@ -0,0 +1,288 @@
+/*
+ * Mathi C Library - Growable Vectors and Arenas
+ * Copyright (c) 2025 Macharia Nyamū
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ */
+
+#include "mathi/vec.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* Smallest heap capacity (in elements) a vector grows to. */
+#define VEC_MIN_CAP 4
+
+/* Default arena chunk size in bytes. */
+#define ARENA_DEFAULT_CHUNK (64 * 1024)
+
+/* Alignment of every arena allocation. */
+#define ARENA_ALIGN 16
+
+/* ---------------------------------------------------------------------------
+ * Allocator dispatch (NULL means the C library)
+ * ------------------------------------------------------------------------- */
+
+static void* vec_alloc(const MathiAllocator *a, size_t size)
+{
+    return a ? a->alloc(a->ctx, size) : malloc(size);
+}
+
+static void* vec_realloc(const MathiAllocator *a, void *ptr, size_t old_size, size_t new_size)
+{
+    return a ? a->realloc(a->ctx, ptr, old_size, new_size) : realloc(ptr, new_size);
+}
+
+static void vec_release(const MathiAllocator *a, void *ptr, size_t size)
+{
+    if(a) a->free(a->ctx, ptr, size);
+    else free(ptr);
+}
+
+/* ---------------------------------------------------------------------------
+ * Vector core
+ *
+ * The macros in vec.h pass the address of the vector's T * field; it is read
+ * and written through memcpy so any element pointer type can be handled
+ * without aliasing it as void *.
+ * ------------------------------------------------------------------------- */
+
+/**
+ * @brief Grow a vector's buffer to hold at least need elements.
+ *
+ * The capacity at least doubles on every growth, so n pushes cost O(n)
+ * amortised. A buffer still in inline storage is copied to the heap.
+ *
+ * @return 0 on success, -1 on overflow or allocation failure.
+ */
+int mathi_vec_reserve_raw(void *data, size_t len, size_t *cap, size_t need, size_t elem_size,
+                          void *inline_buf, const MathiAllocator *alloc)
+{
+    if(need <= *cap) return 0;
+    if(elem_size == 0 || need > SIZE_MAX / elem_size) return -1;
+
+    size_t new_cap = *cap < VEC_MIN_CAP ? VEC_MIN_CAP : *cap;
+    while(new_cap < need)
+        new_cap = new_cap > SIZE_MAX / 2 ? need : new_cap * 2;
+    if(new_cap > SIZE_MAX / elem_size) new_cap = need;
+
+    void *cur;
+    memcpy(&cur, data, sizeof(cur));
+
+    void *grown;
+    if(!cur || cur == inline_buf)
+    {
+        grown = vec_alloc(alloc, new_cap * elem_size);
+        if(grown && len) memcpy(grown, cur, len * elem_size);
+    }
+    else grown = vec_realloc(alloc, cur, *cap * elem_size, new_cap * elem_size);
+    if(!grown) return -1;
+
+    memcpy(data, &grown, sizeof(grown));
+    *cap = new_cap;
+    return 0;
+}
+
+/**
+ * @brief Shrink a vector's buffer to its length.
+ *
+ * Elements move back into inline storage when they fit; an empty heap-only
+ * vector releases its buffer.
+ *
+ * @return 0 on success, -1 on allocation failure.
+ */
+int mathi_vec_shrink_raw(void *data, size_t len, size_t *cap, size_t elem_size, void *inline_buf,
+                         size_t inline_cap, const MathiAllocator *alloc)
+{
+    void *cur;
+    memcpy(&cur, data, sizeof(cur));
+    if(!cur || cur == inline_buf || len == *cap) return 0;
+
+    void *shrunk;
+    if(inline_buf && len <= inline_cap)
+    {
+        memcpy(inline_buf, cur, len * elem_size);
+        vec_release(alloc, cur, *cap * elem_size);
+        shrunk = inline_buf;
+        *cap = inline_cap;
+    }
+    else if(len == 0)
+    {
+        vec_release(alloc, cur, *cap * elem_size);
+        shrunk = NULL;
+        *cap = 0;
+    }
+    else
+    {
+        shrunk = vec_realloc(alloc, cur, *cap * elem_size, len * elem_size);
+        if(!shrunk) return -1;
+        *cap = len;
+    }
+
+    memcpy(data, &shrunk, sizeof(shrunk));
+    return 0;
+}
+
+/**
+ * @brief Release a vector's heap buffer; inline storage is left alone.
+ */
+void mathi_vec_free_raw(void *data, size_t cap, size_t elem_size, const void *inline_buf,
+                        const MathiAllocator *alloc)
+{
+    if(data && data != inline_buf) vec_release(alloc, data, cap * elem_size);
+}
+
+/* ---------------------------------------------------------------------------
+ * Arena
+ * ------------------------------------------------------------------------- */
+
+typedef struct ArenaChunk {
+    struct ArenaChunk *next;
+    size_t size;  // usable bytes in mem
+    size_t used;
+    _Alignas(ARENA_ALIGN) unsigned char mem[];
+} ArenaChunk;
+
+struct MathiArena {
+    ArenaChunk *head;   // chunk currently allocated from; older chunks follow
+    size_t chunk_size;
+    void *last;         // most recent allocation, which can grow or be freed in place
+};
+
+static ArenaChunk* arena_chunk_new(size_t size)
+{
+    if(size > SIZE_MAX - sizeof(ArenaChunk)) return NULL;
+    ArenaChunk *c = malloc(sizeof(ArenaChunk) + size);
+    if(!c) return NULL;
+    c->next = NULL;
+    c->size = size;
+    c->used = 0;
+    return c;
+}
+
+/**
+ * @brief Create an arena with one chunk of chunk_size bytes.
+ * @param chunk_size Bytes per chunk; 0 selects ARENA_DEFAULT_CHUNK.
+ * @return New arena, or NULL on allocation failure.
+ */
+MathiArena* mathi_arena_new(size_t chunk_size)
+{
+    MathiArena *arena = malloc(sizeof(MathiArena));
+    if(!arena) return NULL;
+    arena->chunk_size = chunk_size ? chunk_size : ARENA_DEFAULT_CHUNK;
+    arena->head = arena_chunk_new(arena->chunk_size);
+    arena->last = NULL;
+    if(!arena->head)
+    {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+/**
+ * @brief Bump-allocate size bytes (ARENA_ALIGN aligned).
+ *
+ * When the current chunk is full a new one of max(chunk_size, size) bytes
+ * becomes the current chunk.
+ *
+ * @return Pointer into the arena, or NULL on failure.
+ */
+void* mathi_arena_alloc(MathiArena *arena, size_t size)
+{
+    if(!arena || size > SIZE_MAX - ARENA_ALIGN) return NULL;
+    size_t rounded = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    ArenaChunk *c = arena->head;
+    if(c->size - c->used < rounded)
+    {
+        c = arena_chunk_new(rounded > arena->chunk_size ? rounded : arena->chunk_size);
+        if(!c) return NULL;
+        c->next = arena->head;
+        arena->head = c;
+    }
+
+    void *p = c->mem + c->used;
+    c->used += rounded;
+    arena->last = p;
+    return p;
+}
+
+/**
+ * @brief Drop every allocation; the oldest chunk is kept and reused.
+ */
+void mathi_arena_reset(MathiArena *arena)
+{
+    if(!arena) return;
+    while(arena->head->next)
+    {
+        ArenaChunk *next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    arena->head->used = 0;
+    arena->last = NULL;
+}
+
+/**
+ * @brief Free an arena and all of its chunks.
+ */
+void mathi_arena_free(MathiArena *arena)
+{
+    if(!arena) return;
+    while(arena->head)
+    {
+        ArenaChunk *next = arena->head->next;
+        free(arena->head);
+        arena->head = next;
+    }
+    free(arena);
+}
+
+static void* arena_cb_alloc(void *ctx, size_t size)
+{
+    return mathi_arena_alloc(ctx, size);
+}
+
+/* Grow the most recent allocation in place when the chunk has room; otherwise copy. */
+static void* arena_cb_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    MathiArena *arena = ctx;
+    ArenaChunk *c = arena->head;
+
+    if(ptr && ptr == arena->last)
+    {
+        size_t offset = (size_t)((unsigned char *)ptr - c->mem);
+        if(new_size <= c->size - offset)
+        {
+            size_t rounded = (new_size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+            c->used = offset + (rounded < c->size - offset ? rounded : c->size - offset);
+            return ptr;
+        }
+    }
+
+    void *p = mathi_arena_alloc(arena, new_size);
+    if(p && ptr) memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    return p;
+}
+
+/* Only the most recent allocation is actually returned to the chunk. */
+static void arena_cb_free(void *ctx, void *ptr, size_t size)
+{
+    MathiArena *arena = ctx;
+    (void)size;
+    if(ptr && ptr == arena->last)
+    {
+        arena->head->used = (size_t)((unsigned char *)ptr - arena->head->mem);
+        arena->last = NULL;
+    }
+}
+
+/**
+ * @brief Allocator callbacks drawing from arena.
+ * @return Allocator value; keep it alive as long as containers use it.
+ */
+MathiAllocator mathi_arena_allocator(MathiArena *arena)
+{
+    MathiAllocator a = {arena_cb_alloc, arena_cb_realloc, arena_cb_free, arena};
+    return a;
+}
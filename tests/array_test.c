@@ -1,7 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
+#include <limits.h>
+#include <stdint.h>
 #include "mathi/array.h"
+#include "mathi/prng.h"
 #include "mathi/print.h"
 
 void test_mathi_arr_index() 
@@ -106,8 +110,8 @@ void test_array_sum()
     int arr[] = {1, 2, 3, 4};
     mathi_prnt_arr(arr, 4, "arr");
 
-    int sum = mathi_arr_sum(arr, 4);
-    printf("array_sum(arr) = %d\n", sum);
+    int64_t sum = mathi_arr_sum(arr, 4);
+    printf("array_sum(arr) = %lld\n", (long long)sum);
 
     assert(sum == 10);
 
@@ -304,19 +308,402 @@ void test_is_sorted()
     printf("\n");
 }
 
+void test_array_scan_kernels() 
+{
+    printf("Testing vectorised index/contains/count...\n");
+
+    enum { MAX_N = 100, OFFSETS = 8 };
+    int buf[MAX_N + OFFSETS];
+
+    for(int off = 0; off < OFFSETS; off++) 
+    {
+        int *arr = buf + off;
+        for(size_t n = 0; n <= MAX_N; n++) 
+        {
+            for(size_t i = 0; i < n; i++) arr[i] = (int)(i % 7) + 10;
+
+            /* Absent value, then a single hit at every position (including the tail). */
+            assert(mathi_arr_index(arr, n, 99) == -1);
+            assert(mathi_arr_contains(arr, n, 99) == 0);
+            assert(mathi_arr_count(arr, n, 99) == 0);
+            for(size_t p = 0; p < n; p++) 
+            {
+                int saved = arr[p];
+                arr[p] = 99;
+                assert(mathi_arr_index(arr, n, 99) == (int)p);
+                assert(mathi_arr_contains(arr, n, 99) == 1);
+                assert(mathi_arr_count(arr, n, 99) == 1);
+                arr[p] = saved;
+            }
+
+            /* Repeated values: first index and count must match a scalar scan. */
+            for(int v = 10; v < 17; v++) 
+            {
+                int first = -1;
+                size_t count = 0;
+                for(size_t i = 0; i < n; i++) 
+                    if(arr[i] == v) 
+                    {
+                        if(first < 0) first = (int)i;
+                        count++;
+                    }
+                assert(mathi_arr_index(arr, n, v) == first);
+                assert(mathi_arr_count(arr, n, v) == count);
+            }
+        }
+    }
+
+    printf("\n");
+}
+
+void test_array_reductions() 
+{
+    printf("Testing vectorised sum/minmax/sqdev and their threaded variants...\n");
+
+    enum { MAX_N = 100, OFFSETS = 8 };
+    int buf[MAX_N + OFFSETS] = {0};
+
+    int mn = 1, mx = 1;
+    assert(mathi_arr_minmax(buf, 0, &mn, &mx) == -1 && mn == 0 && mx == 0);
+    assert(mathi_arr_sum(buf, 0) == 0);
+
+    for(int off = 0; off < OFFSETS; off++) 
+    {
+        int *arr = buf + off;
+        for(size_t n = 1; n <= MAX_N; n++) 
+        {
+            // Values near INT_MAX overflow an int accumulator after two elements.
+            int64_t sum = 0;
+            for(size_t i = 0; i < n; i++) 
+            {
+                arr[i] = (i % 3 == 0) ? INT_MAX - (int)i : (int)(i * 37 % 101) - 50;
+                sum += arr[i];
+            }
+            assert(mathi_arr_sum(arr, n) == sum);
+            assert(mathi_arr_average(arr, n) == (double)sum / n);
+
+            double mean = (double)sum / n, sq = 0;
+            for(size_t i = 0; i < n; i++) sq += (arr[i] - mean) * (arr[i] - mean);
+            double got = mathi_arr_sqdev(arr, n, mean);
+            assert(got - sq <= 1e-9 * sq + 1e-9 && sq - got <= 1e-9 * sq + 1e-9);
+
+            // Extremes planted at every position, including the scalar tail.
+            for(size_t p = 0; p < n; p++) 
+            {
+                int saved = arr[p];
+                arr[p] = INT_MIN;
+                int want = arr[0];
+                for(size_t i = 1; i < n; i++) if(arr[i] > want) want = arr[i];
+                assert(mathi_arr_minmax(arr, n, &mn, &mx) == 0);
+                assert(mn == INT_MIN && mx == want);
+                assert(mathi_arr_min(arr, n) == INT_MIN && mathi_arr_max(arr, n) == want);
+                arr[p] = saved;
+            }
+        }
+    }
+
+    size_t big = (size_t)3 << 18;
+    int *large = malloc(big * sizeof(int));
+    assert(large);
+    int64_t sum = 0;
+    for(size_t i = 0; i < big; i++) 
+    {
+        large[i] = (int)(i * 2654435761u);
+        sum += large[i];
+    }
+    large[big / 2] = INT_MIN;
+    large[big - 1] = INT_MAX;
+    sum += (int64_t)INT_MIN - (int)((big / 2) * 2654435761u);
+    sum += (int64_t)INT_MAX - (int)((big - 1) * 2654435761u);
+
+    for(int threads = 0; threads <= 4; threads++) 
+    {
+        assert(mathi_arr_sum_mt(large, big, threads) == sum);
+        assert(mathi_arr_minmax_mt(large, big, &mn, &mx, threads) == 0);
+        assert(mn == INT_MIN && mx == INT_MAX);
+    }
+    assert(mathi_arr_sum(large, big) == sum);
+    free(large);
+
+    printf("\n");
+}
+
+void test_array_distinct_modes() 
+{
+    printf("Testing array_distinct modes...\n");
+
+    enum { N = 5000 };
+    int *input = malloc(N * sizeof(int));
+    int *arr = malloc(N * sizeof(int));
+    int *expected = malloc(N * sizeof(int));
+    assert(input && arr && expected);
+
+    // Dense (bitmap-eligible) and sparse value sets, both including INT_MIN/INT_MAX.
+    for(int dense = 0; dense <= 1; dense++) 
+    {
+        for(int i = 0; i < N; i++) 
+            input[i] = dense ? (int)((i * 7919u) % 997) - 500 : (int)((i % 1201) * 2654435761u);
+        input[N / 3] = INT_MIN;
+        input[N / 2] = INT_MAX;
+
+        // Reference: first occurrences in order, via the quadratic scan.
+        size_t m = 0;
+        for(int i = 0; i < N; i++) 
+        {
+            size_t k = 0;
+            while(k < m && expected[k] != input[i]) k++;
+            if(k == m) expected[m++] = input[i];
+        }
+
+        size_t n = N;
+        memcpy(arr, input, N * sizeof(int));
+        mathi_arr_distinct(arr, &n);
+        assert(n == m && memcmp(arr, expected, m * sizeof(int)) == 0);
+
+        n = N;
+        memcpy(arr, input, N * sizeof(int));
+        assert(mathi_arr_distinct_mode(arr, &n, MATHI_DISTINCT_BITMAP) == 0);
+        assert(n == m && memcmp(arr, expected, m * sizeof(int)) == 0);
+
+        n = N;
+        memcpy(arr, input, N * sizeof(int));
+        assert(mathi_arr_distinct_mode(arr, &n, MATHI_DISTINCT_SORTED) == 0);
+        assert(n == m && mathi_arr_sorted(arr, n));
+        for(size_t i = 1; i < n; i++) assert(arr[i - 1] < arr[i]);
+        for(size_t i = 0; i < m; i++) assert(mathi_arr_contains(arr, n, expected[i]));
+    }
+
+    // Small inputs, all-equal input and an unknown mode.
+    int small[] = {5, 5, 5, 5};
+    size_t n = 4;
+    mathi_arr_distinct(small, &n);
+    assert(n == 1 && small[0] == 5);
+    n = 0;
+    assert(mathi_arr_distinct_mode(small, &n, MATHI_DISTINCT_HASH) == 0 && n == 0);
+    n = 4;
+    assert(mathi_arr_distinct_mode(small, &n, (MathiDistinctMode)42) == -1 && n == 4);
+
+    for(int i = 0; i < N; i++) arr[i] = 7;
+    n = N;
+    assert(mathi_arr_distinct_mode(arr, &n, MATHI_DISTINCT_HASH) == 0 && n == 1 && arr[0] == 7);
+
+    free(input);
+    free(arr);
+    free(expected);
+
+    printf("\n");
+}
+
+void test_array_shuffle_seeded() 
+{
+    printf("Testing array_shuffle_r and array_shuffle_mt...\n");
+
+    // All 24 permutations of 4 elements come up equally often.
+    enum { TRIALS = 240000 };
+    long counts[256] = {0};
+    MathiXoshiro256 rng;
+    mathi_xoshiro256_seed(&rng, 7);
+    for(int t = 0; t < TRIALS; t++) 
+    {
+        int arr[] = {0, 1, 2, 3};
+        mathi_arr_shuffle_r(arr, 4, &rng);
+        counts[arr[0] * 64 + arr[1] * 16 + arr[2] * 4 + arr[3]]++;
+    }
+    int perms = 0;
+    for(int k = 0; k < 256; k++) 
+        if(counts[k]) 
+        {
+            perms++;
+            assert(counts[k] > TRIALS / 24 * 9 / 10 && counts[k] < TRIALS / 24 * 11 / 10);
+        }
+    assert(perms == 24);
+
+    // Same seed, same permutation; the unseeded shuffle differs call to call.
+    int a[100], b[100];
+    for(int i = 0; i < 100; i++) a[i] = b[i] = i;
+    MathiXoshiro256 r1, r2;
+    mathi_xoshiro256_seed(&r1, 99);
+    mathi_xoshiro256_seed(&r2, 99);
+    mathi_arr_shuffle_r(a, 100, &r1);
+    mathi_arr_shuffle_r(b, 100, &r2);
+    assert(memcmp(a, b, sizeof(a)) == 0);
+    mathi_arr_shuffle(a, 100);
+    memcpy(b, a, sizeof(a));
+    mathi_arr_shuffle(a, 100);
+    assert(memcmp(a, b, sizeof(a)) != 0);
+
+    // MergeShuffle: a permutation, independent of the thread count, that mixes across blocks.
+    size_t n = (size_t)1 << 20;
+    int *ref = malloc(n * sizeof(int));
+    int *arr = malloc(n * sizeof(int));
+    unsigned char *seen = calloc(n, 1);
+    assert(ref && arr && seen);
+    for(size_t i = 0; i < n; i++) ref[i] = (int)i;
+    mathi_xoshiro256_seed(&rng, 1234);
+    MathiXoshiro256 start = rng;
+    mathi_arr_shuffle_mt(ref, n, &rng, 1);
+    assert(memcmp(&start, &rng, sizeof(rng)) != 0);
+
+    for(size_t i = 0; i < n; i++) 
+    {
+        assert(ref[i] >= 0 && (size_t)ref[i] < n && !seen[ref[i]]);
+        seen[ref[i]] = 1;
+    }
+    size_t stayed = 0;
+    for(size_t i = 0; i < n / 2; i++) stayed += (size_t)ref[i] < n / 2;
+    assert(stayed > n / 4 - 4096 && stayed < n / 4 + 4096);
+
+    for(int threads = 0; threads <= 4; threads++) 
+    {
+        for(size_t i = 0; i < n; i++) arr[i] = (int)i;
+        rng = start;
+        mathi_arr_shuffle_mt(arr, n, &rng, threads);
+        assert(memcmp(arr, ref, n * sizeof(int)) == 0);
+    }
+
+    free(ref);
+    free(arr);
+    free(seen);
+
+    printf("\n");
+}
+
+void test_array_scans() 
+{
+    printf("Testing inclusive/exclusive/segmented scans and their threaded variants...\n");
+
+    enum { MAX_N = 70, OFFSETS = 4 };
+    int32_t a32[MAX_N + OFFSETS], o32[MAX_N + OFFSETS];
+    int64_t a64[MAX_N + OFFSETS], o64[MAX_N + OFFSETS];
+    double af[MAX_N + OFFSETS], of[MAX_N + OFFSETS];
+
+    for(int off = 0; off < OFFSETS; off++) 
+    {
+        for(size_t n = 0; n <= MAX_N; n++) 
+        {
+            int32_t *in32 = a32 + off, *out32 = o32 + off;
+            int64_t *in64 = a64 + off, *out64 = o64 + off;
+            double *inf = af + off, *outf = of + off;
+            for(size_t i = 0; i < n; i++) 
+            {
+                // int32 values large enough to wrap; doubles stay integral so sums are exact.
+                in32[i] = (int32_t)(i * 2654435761u);
+                in64[i] = (int64_t)(i * 0x9E3779B97F4A7C15ull);
+                inf[i] = (double)((int)(i * 37 % 101) - 50);
+            }
+
+            for(int exclusive = 0; exclusive < 2; exclusive++) 
+            {
+                if(exclusive) 
+                {
+                    mathi_scan_exclusive_i32(in32, out32, n);
+                    mathi_scan_exclusive_i64(in64, out64, n);
+                    mathi_scan_exclusive_f64(inf, outf, n);
+                }
+                else 
+                {
+                    mathi_scan_inclusive_i32(in32, out32, n);
+                    mathi_scan_inclusive_i64(in64, out64, n);
+                    mathi_scan_inclusive_f64(inf, outf, n);
+                }
+                uint32_t s32 = 0;
+                uint64_t s64 = 0;
+                double sf = 0;
+                for(size_t i = 0; i < n; i++) 
+                {
+                    if(exclusive) assert(out32[i] == (int32_t)s32 && out64[i] == (int64_t)s64 && outf[i] == sf);
+                    s32 += (uint32_t)in32[i];
+                    s64 += (uint64_t)in64[i];
+                    sf += inf[i];
+                    if(!exclusive) assert(out32[i] == (int32_t)s32 && out64[i] == (int64_t)s64 && outf[i] == sf);
+                }
+            }
+
+            // In place, with segments of every length starting at varying points.
+            unsigned char flags[MAX_N];
+            for(size_t i = 0; i < n; i++) flags[i] = (i * 7 + n) % 11 == 0;
+            memcpy(out64, in64, n * sizeof(int64_t));
+            mathi_scan_segmented_i64(out64, flags, out64, n);
+            mathi_scan_segmented_i32(in32, flags, out32, n);
+            mathi_scan_segmented_f64(inf, flags, outf, n);
+            uint32_t s32 = 0;
+            uint64_t s64 = 0;
+            double sf = 0;
+            for(size_t i = 0; i < n; i++) 
+            {
+                if(flags[i]) s32 = 0, s64 = 0, sf = 0;
+                s32 += (uint32_t)in32[i];
+                s64 += (uint64_t)in64[i];
+                sf += inf[i];
+                assert(out32[i] == (int32_t)s32 && out64[i] == (int64_t)s64 && outf[i] == sf);
+            }
+        }
+    }
+
+    // Threaded scans must match the single-threaded ones, in and out of place.
+    size_t big = ((size_t)3 << 18) + 5;
+    int32_t *in = malloc(big * sizeof(int32_t)), *ref = malloc(big * sizeof(int32_t));
+    int32_t *got = malloc(big * sizeof(int32_t));
+    double *din = malloc(big * sizeof(double)), *dref = malloc(big * sizeof(double));
+    double *dgot = malloc(big * sizeof(double));
+    assert(in && ref && got && din && dref && dgot);
+    for(size_t i = 0; i < big; i++) 
+    {
+        in[i] = (int32_t)(i * 2654435761u);
+        din[i] = (double)(i % 17);
+    }
+    for(int threads = 0; threads <= 4; threads++) 
+    {
+        mathi_scan_inclusive_i32(in, ref, big);
+        mathi_scan_inclusive_i32_mt(in, got, big, threads);
+        assert(memcmp(ref, got, big * sizeof(int32_t)) == 0);
+
+        mathi_scan_exclusive_i32(in, ref, big);
+        memcpy(got, in, big * sizeof(int32_t));
+        mathi_scan_exclusive_i32_mt(got, got, big, threads);
+        assert(memcmp(ref, got, big * sizeof(int32_t)) == 0);
+
+        mathi_scan_exclusive_f64(din, dref, big);
+        mathi_scan_exclusive_f64_mt(din, dgot, big, threads);
+        assert(memcmp(dref, dgot, big * sizeof(double)) == 0);
+    }
+    int64_t *l = malloc(big * sizeof(int64_t)), *lref = malloc(big * sizeof(int64_t));
+    assert(l && lref);
+    for(size_t i = 0; i < big; i++) l[i] = (int64_t)(i * 0x9E3779B97F4A7C15ull);
+    mathi_scan_inclusive_i64(l, lref, big);
+    mathi_scan_inclusive_i64_mt(l, l, big, 3);
+    assert(memcmp(l, lref, big * sizeof(int64_t)) == 0);
+
+    free(in);
+    free(ref);
+    free(got);
+    free(din);
+    free(dref);
+    free(dgot);
+    free(l);
+    free(lref);
+
+    printf("\n");
+}
+
 int main() 
 {
     test_mathi_arr_index();
     test_array_contains();
+    test_array_scan_kernels();
     test_array_reverse();
     test_array_copy();
     test_array_fill();
     test_array_sum();
     test_array_max_min();
     test_array_average();
+    test_array_reductions();
+    test_array_scans();
     test_array_equals();
     test_array_shuffle();
+    test_array_shuffle_seeded();
     test_array_unique();
+    test_array_distinct_modes();
     test_mathi_arr_sorted();
     test_rotate_array();
     test_is_sorted();
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <stdint.h>
 #include "mathi/ds.h"
 #include "mathi/ds_advanced.h"
 
@@ -98,11 +99,88 @@ void test_trie()
     printf("\n");
 }
 
+void test_swissmap() 
+{
+    printf("\nTesting dsx swiss map\n");
+
+    MathiSwissMap *m = mathi_swissmap_new(0, 0);
+    assert(m != NULL);
+    enum { N = 20000 };
+    char key[64];
+    void *v;
+
+    // Short keys are stored inline, long ones (over 15 bytes) on the heap.
+    for (int i = 0; i < N; i++) 
+    {
+        snprintf(key, sizeof(key), i % 2 ? "k%d" : "a-much-longer-key-%d", i);
+        assert(mathi_swissmap_set(m, key, (void*)(intptr_t)(i + 1)) == 0);
+    }
+    assert(mathi_swissmap_size(m) == N);
+    for (int i = 0; i < N; i++) 
+    {
+        snprintf(key, sizeof(key), i % 2 ? "k%d" : "a-much-longer-key-%d", i);
+        assert(mathi_swissmap_get(m, key, &v) == 1 && (intptr_t)v == i + 1);
+    }
+
+    assert(mathi_swissmap_set(m, "", NULL) == 0);
+    v = &v;
+    assert(mathi_swissmap_get(m, "", &v) == 1 && v == NULL);
+    assert(mathi_swissmap_get(m, "k0", NULL) == 0);
+    assert(mathi_swissmap_remove(m, "nope", NULL) == 0);
+    assert(mathi_swissmap_remove(m, "", NULL) == 1);
+
+    // Churn through many more keys than the table holds: tombstones get cleaned up.
+    for (int round = 0; round < 10; round++) 
+        for (int i = 0; i < N; i++) 
+        {
+            snprintf(key, sizeof(key), "churn-%d-%d", round, i);
+            assert(mathi_swissmap_set(m, key, NULL) == 0);
+            assert(mathi_swissmap_remove(m, key, &v) == 1 && v == NULL);
+        }
+    assert(mathi_swissmap_size(m) == N);
+
+    size_t iter = 0, seen = 0;
+    const char *k;
+    while (mathi_swissmap_next(m, &iter, &k, &v)) 
+    {
+        assert(mathi_swissmap_get(m, k, NULL) == 1);
+        seen++;
+    }
+    assert(seen == N);
+    printf("swissmap holds %zu entries after churn\n", mathi_swissmap_size(m));
+
+    mathi_swissmap_free(m);
+
+    // A sliding window of keys leaves tombstones in full groups; they are swept in
+    // place at the same size, and every key in the window stays reachable.
+    enum { W = 100, KEYS = 100000 };
+    m = mathi_swissmap_new(0, 0);
+    assert(m != NULL);
+    for (int i = 0; i < KEYS; i++) 
+    {
+        snprintf(key, sizeof(key), "window-%d", i);
+        assert(mathi_swissmap_set(m, key, (void*)(intptr_t)i) == 0);
+        if (i < W) continue;
+        snprintf(key, sizeof(key), "window-%d", i - W);
+        assert(mathi_swissmap_remove(m, key, &v) == 1 && (intptr_t)v == i - W);
+        if (i % 1000) continue;
+        for (int j = i - W + 1; j <= i; j++) 
+        {
+            snprintf(key, sizeof(key), "window-%d", j);
+            assert(mathi_swissmap_get(m, key, &v) == 1 && (intptr_t)v == j);
+        }
+    }
+    assert(mathi_swissmap_size(m) == W);
+    mathi_swissmap_free(m);
+    printf("\n");
+}
+
 int main() 
 {
     test_heap();
     test_graph();
     test_trie();
+    test_swissmap();
 
     printf("\nAll dsx tests completed successfully!\n");
     return 0;
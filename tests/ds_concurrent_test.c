@@ -0,0 +1,232 @@
+/*
+* Mathi C Library - ds_concurrent_test.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include "mathi/ds_concurrent.h"
+
+enum { THREADS = 4, KEYS_PER_THREAD = 20000, SHARED_KEYS = 512 };
+
+static void count_entry(const char *key, void *value, void *ctx)
+{
+    (void)key;
+    (void)value;
+    (*(size_t *)ctx)++;
+}
+
+static void sum_entry(const char *key, void *value, void *ctx)
+{
+    (void)key;
+    *(long long *)ctx += (intptr_t)value;
+}
+
+void test_cmap_basic()
+{
+    printf("Testing MathiCMap single-threaded operations...\n");
+
+    MathiCMap *m = mathi_cmap_new(0, 0);
+    assert(m);
+    assert(mathi_cmap_get(m, "missing", NULL) == 0);
+    assert(mathi_cmap_remove(m, "missing", NULL) == 0);
+    assert(mathi_cmap_set(m, NULL, NULL) == -1);
+
+    // Enough keys to force several doublings from the minimum table.
+    enum { N = 50000 };
+    char key[32];
+    for(int i = 0; i < N; i++)
+    {
+        snprintf(key, sizeof(key), "key-%d", i);
+        assert(mathi_cmap_set(m, key, (void *)(intptr_t)i) == 0);
+    }
+    assert(mathi_cmap_size(m) == N);
+
+    void *v = NULL;
+    for(int i = 0; i < N; i++)
+    {
+        snprintf(key, sizeof(key), "key-%d", i);
+        assert(mathi_cmap_get(m, key, &v) == 1 && (intptr_t)v == i);
+    }
+    assert(mathi_cmap_get(m, "key-50000", &v) == 0);
+
+    // Updates replace the value without adding an entry; NULL is a value like any other.
+    assert(mathi_cmap_set(m, "key-7", (void *)(intptr_t)-7) == 0);
+    assert(mathi_cmap_set(m, "key-8", NULL) == 0);
+    assert(mathi_cmap_size(m) == N);
+    assert(mathi_cmap_get(m, "key-7", &v) == 1 && (intptr_t)v == -7);
+    assert(mathi_cmap_get(m, "key-8", &v) == 1 && v == NULL);
+
+    for(int i = 0; i < N; i += 2)
+    {
+        snprintf(key, sizeof(key), "key-%d", i);
+        assert(mathi_cmap_remove(m, key, &v) == 1);
+        assert(mathi_cmap_remove(m, key, NULL) == 0);
+    }
+    assert(mathi_cmap_size(m) == N / 2);
+
+    size_t visited = 0;
+    mathi_cmap_foreach(m, count_entry, &visited);
+    assert(visited == N / 2);
+
+    long long sum = 0;
+    mathi_cmap_foreach(m, sum_entry, &sum);
+    assert(sum == (long long)N * N / 4 - 7 - 7);
+
+    mathi_cmap_free(m);
+    mathi_cmap_free(NULL);
+
+    printf("\n");
+}
+
+typedef struct {
+    MathiCMap *map;
+    int id;
+    int errors;
+} Worker;
+
+/* Insert this thread's own keys while checking the shared keys, then remove every odd own key. */
+static void* writer_thread(void *arg)
+{
+    Worker *w = arg;
+    char key[32];
+    for(int i = 0; i < KEYS_PER_THREAD; i++)
+    {
+        snprintf(key, sizeof(key), "t%d-%d", w->id, i);
+        if(mathi_cmap_set(w->map, key, (void *)(intptr_t)(w->id * KEYS_PER_THREAD + i)) != 0) w->errors++;
+
+        snprintf(key, sizeof(key), "shared-%d", i % SHARED_KEYS);
+        void *v;
+        if(!mathi_cmap_get(w->map, key, &v) || (intptr_t)v != i % SHARED_KEYS) w->errors++;
+    }
+    for(int i = 1; i < KEYS_PER_THREAD; i += 2)
+    {
+        snprintf(key, sizeof(key), "t%d-%d", w->id, i);
+        if(mathi_cmap_remove(w->map, key, NULL) != 1) w->errors++;
+    }
+    return NULL;
+}
+
+void test_cmap_concurrent_growth()
+{
+    printf("Testing concurrent inserts and removes across resizes...\n");
+
+    MathiCMap *m = mathi_cmap_new(0, 0);
+    assert(m);
+    char key[32];
+    for(int i = 0; i < SHARED_KEYS; i++)
+    {
+        snprintf(key, sizeof(key), "shared-%d", i);
+        assert(mathi_cmap_set(m, key, (void *)(intptr_t)i) == 0);
+    }
+
+    pthread_t tids[THREADS];
+    Worker workers[THREADS];
+    for(int t = 0; t < THREADS; t++)
+    {
+        workers[t] = (Worker){m, t, 0};
+        assert(pthread_create(&tids[t], NULL, writer_thread, &workers[t]) == 0);
+    }
+    for(int t = 0; t < THREADS; t++)
+    {
+        pthread_join(tids[t], NULL);
+        assert(workers[t].errors == 0);
+    }
+
+    assert(mathi_cmap_size(m) == SHARED_KEYS + THREADS * KEYS_PER_THREAD / 2);
+    for(int t = 0; t < THREADS; t++)
+        for(int i = 0; i < KEYS_PER_THREAD; i++)
+        {
+            void *v;
+            snprintf(key, sizeof(key), "t%d-%d", t, i);
+            int found = mathi_cmap_get(m, key, &v);
+            assert(found == (i % 2 == 0));
+            if(found) assert((intptr_t)v == t * KEYS_PER_THREAD + i);
+        }
+
+    size_t visited = 0;
+    mathi_cmap_foreach(m, count_entry, &visited);
+    assert(visited == mathi_cmap_size(m));
+
+    mathi_cmap_free(m);
+
+    printf("\n");
+}
+
+enum { CHURN_KEYS = 64, CHURN_OPS = 200000 };
+
+/* Values encode the key index in the low byte, so a reader can tell a value from the wrong key. */
+static void* churn_writer(void *arg)
+{
+    Worker *w = arg;
+    uint64_t s = 0x9E3779B97F4A7C15ull * (uint64_t)(w->id + 1);
+    char key[32];
+    for(intptr_t op = 1; op <= CHURN_OPS; op++)
+    {
+        s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+        int k = (int)(s % CHURN_KEYS);
+        snprintf(key, sizeof(key), "churn-%d", k);
+        if(s & (1ull << 40)) mathi_cmap_remove(w->map, key, NULL);
+        else if(mathi_cmap_set(w->map, key, (void *)(op << 8 | k)) != 0) w->errors++;
+    }
+    return NULL;
+}
+
+static void* churn_reader(void *arg)
+{
+    Worker *w = arg;
+    char key[32];
+    for(int op = 0; op < CHURN_OPS; op++)
+    {
+        int k = op % CHURN_KEYS;
+        snprintf(key, sizeof(key), "churn-%d", k);
+        void *v;
+        if(mathi_cmap_get(w->map, key, &v) && ((intptr_t)v & 0xff) != k) w->errors++;
+    }
+    return NULL;
+}
+
+void test_cmap_churn()
+{
+    printf("Testing lock-free readers against writers on a few hot keys...\n");
+
+    MathiCMap *m = mathi_cmap_new(0, 0);
+    assert(m);
+
+    pthread_t tids[THREADS];
+    Worker workers[THREADS];
+    for(int t = 0; t < THREADS; t++)
+    {
+        workers[t] = (Worker){m, t, 0};
+        assert(pthread_create(&tids[t], NULL, t % 2 ? churn_reader : churn_writer, &workers[t]) == 0);
+    }
+    for(int t = 0; t < THREADS; t++)
+    {
+        pthread_join(tids[t], NULL);
+        assert(workers[t].errors == 0);
+    }
+
+    size_t visited = 0;
+    mathi_cmap_foreach(m, count_entry, &visited);
+    assert(visited == mathi_cmap_size(m) && visited <= CHURN_KEYS);
+
+    mathi_cmap_free(m);
+
+    printf("\n");
+}
+
+int main()
+{
+    test_cmap_basic();
+    test_cmap_concurrent_growth();
+    test_cmap_churn();
+
+    printf("All ds_concurrent tests passed successfully!\n");
+
+    return 0;
+}
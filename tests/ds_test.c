@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <stdint.h>
 #include "mathi/ds.h"
 #include "mathi/print.h"
 
@@ -125,6 +126,85 @@ void test_hash_table_operations()
     mathi_hash_free(h);
 }
 
+void test_hashmap_operations() 
+{
+    printf("Testing MathiHashMap insert/get/remove/resize...\n");
+
+    MathiHashMap *m = mathi_hashmap_new(0, 0);
+    assert(m);
+    enum { N = 20000 };
+    char key[32];
+    void *v;
+
+    // Every earlier key stays reachable while incremental resizes are in flight.
+    for(int i = 0; i < N; i++) 
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(mathi_hashmap_set(m, key, (void *)(intptr_t)(i + 1)) == 0);
+        if(i < 2000) 
+            for(int j = 0; j <= i; j += 97) 
+            {
+                snprintf(key, sizeof(key), "key%d", j);
+                assert(mathi_hashmap_get(m, key, &v) && (intptr_t)v == j + 1);
+            }
+    }
+    assert(mathi_hashmap_size(m) == N);
+
+    // A stored NULL is found; a missing key is reported as missing.
+    assert(mathi_hashmap_set(m, "null", NULL) == 0);
+    v = &v;
+    assert(mathi_hashmap_get(m, "null", &v) == 1 && v == NULL);
+    assert(mathi_hashmap_get(m, "absent", &v) == 0);
+    assert(mathi_hashmap_remove(m, "absent", NULL) == 0);
+    assert(mathi_hashmap_remove(m, "null", NULL) == 1);
+
+    // Remove every other key, then check both halves.
+    for(int i = 0; i < N; i += 2) 
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(mathi_hashmap_remove(m, key, &v) == 1 && (intptr_t)v == i + 1);
+    }
+    assert(mathi_hashmap_size(m) == N / 2);
+    for(int i = 0; i < N; i++) 
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(mathi_hashmap_get(m, key, NULL) == (i % 2));
+    }
+
+    // Updates keep the size; iteration visits each entry once.
+    assert(mathi_hashmap_set(m, "key1", (void *)(intptr_t)-1) == 0);
+    assert(mathi_hashmap_size(m) == N / 2);
+    size_t iter = 0, seen = 0;
+    const char *k;
+    intptr_t total = 0;
+    while(mathi_hashmap_next(m, &iter, &k, &v)) 
+    {
+        assert(strncmp(k, "key", 3) == 0);
+        total += (intptr_t)v;
+        seen++;
+    }
+    assert(seen == N / 2);
+    assert(total == (intptr_t)N * N / 4 + N / 2 - 3);
+    mathi_hashmap_free(m);
+
+    // The int wrapper grows past the size it was created with.
+    Hash *h = mathi_hash_new(2);
+    for(int i = 0; i < 1000; i++) 
+    {
+        snprintf(key, sizeof(key), "%d", i);
+        mathi_hash_set(h, key, i * 3);
+    }
+    for(int i = 0; i < 1000; i++) 
+    {
+        snprintf(key, sizeof(key), "%d", i);
+        assert(mathi_hash_get(h, key) == i * 3);
+    }
+    assert(mathi_hash_get(h, "missing") == 0);
+    mathi_hash_free(h);
+
+    printf("\n");
+}
+
 void test_list_length_and_find() 
 {
     printf("Testing list_length and list_find aliases...\n");
@@ -181,6 +261,7 @@ int main()
     test_queue_boundaries();
 
     test_hash_table_operations();
+    test_hashmap_operations();
 
     printf("All DS tests passed successfully!\n");
     return 0;
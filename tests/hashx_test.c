@@ -0,0 +1,115 @@
+/*
+* Mathi C Library - hashx_test.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include "mathi/hashx.h"
+
+void test_hash64_reference()
+{
+    printf("Testing mathi_hash64 against the wyhash reference vectors...\n");
+
+    // Test vectors shipped with wyhash final 4 (message, seed = index).
+    static const struct { const char *msg; uint64_t hash; } vectors[] = {
+        {"", 0x93228a4de0eec5a2ull},
+        {"a", 0xc5bac3db178713c4ull},
+        {"abc", 0xa97f2f7b1d9b3314ull},
+        {"message digest", 0x786d1f1df3801df4ull},
+        {"abcdefghijklmnopqrstuvwxyz", 0xdca5a8138ad37c87ull},
+        {"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 0xb9e734f117cfaf70ull},
+        {"12345678901234567890123456789012345678901234567890123456789012345678901234567890",
+         0x6cc5eab49a92d617ull}
+    };
+    for(int i = 0; i < 7; i++)
+    {
+        uint64_t h = mathi_hash64(vectors[i].msg, strlen(vectors[i].msg), (uint64_t)i);
+        assert(h == vectors[i].hash);
+        assert(mathi_hash_str(vectors[i].msg, (uint64_t)i) == h);
+    }
+    assert(mathi_hash64(NULL, 0, 0) == vectors[0].hash);
+
+    printf("\n");
+}
+
+void test_siphash_reference()
+{
+    printf("Testing SipHash against the reference vectors...\n");
+
+    // Key 00 01 .. 0f, message 00 01 .. 0e (vectors.h of the reference code).
+    unsigned char msg[64];
+    for(int i = 0; i < 64; i++) msg[i] = (unsigned char)i;
+    uint64_t k0 = 0x0706050403020100ull, k1 = 0x0f0e0d0c0b0a0908ull;
+
+    assert(mathi_siphash24(msg, 0, k0, k1) == 0x726fdb47dd0e0e31ull);
+    assert(mathi_siphash24(msg, 15, k0, k1) == 0xa129ca6149be45e5ull);
+    assert(mathi_siphash13(msg, 0, k0, k1) == 0xabac0158050fc4dcull);
+    assert(mathi_siphash13(msg, 15, k0, k1) == 0xd320d86d2a519956ull);
+
+    // SipHash-1-3 is a different function of the same key, and the key matters.
+    for(size_t len = 0; len < 64; len++)
+    {
+        uint64_t h = mathi_siphash13(msg, len, k0, k1);
+        assert(h != mathi_siphash24(msg, len, k0, k1));
+        assert(h != mathi_siphash13(msg, len, k0 ^ 1, k1));
+        assert(h == mathi_siphash13(msg, len, k0, k1));
+    }
+
+    printf("\n");
+}
+
+void test_seeds()
+{
+    printf("Testing per-table seeds...\n");
+
+    // Every call returns a new seed.
+    enum { N = 1000 };
+    static uint64_t seeds[N];
+    for(int i = 0; i < N; i++)
+    {
+        seeds[i] = mathi_hash_seed();
+        for(int j = 0; j < i; j++) assert(seeds[i] != seeds[j]);
+    }
+
+    // Different seeds scatter the same key differently, for short and long keys alike.
+    const char *keys[] = {"k", "user:1234", "a considerably longer key that spans several blocks of input"};
+    for(int k = 0; k < 3; k++)
+    {
+        int same = 0;
+        for(int i = 1; i < N; i++)
+            same += (mathi_hash_str(keys[k], seeds[i]) & 1023) == (mathi_hash_str(keys[k], seeds[0]) & 1023);
+        assert(same < 10);
+    }
+
+    // Flipping any input bit changes roughly half of the output bits.
+    unsigned char buf[100] = {0};
+    long flipped = 0, trials = 0;
+    uint64_t base = mathi_hash64(buf, sizeof(buf), seeds[0]);
+    for(int byte = 0; byte < 100; byte++)
+        for(int bit = 0; bit < 8; bit++)
+        {
+            buf[byte] ^= (unsigned char)(1u << bit);
+            flipped += __builtin_popcountll(base ^ mathi_hash64(buf, sizeof(buf), seeds[0]));
+            trials++;
+            buf[byte] ^= (unsigned char)(1u << bit);
+        }
+    printf("average bits flipped: %.2f of 64\n", (double)flipped / trials);
+    assert(flipped > trials * 30 && flipped < trials * 34);
+
+    printf("\n");
+}
+
+int main()
+{
+    test_hash64_reference();
+    test_siphash_reference();
+    test_seeds();
+
+    printf("All hashx tests passed successfully!\n");
+
+    return 0;
+}
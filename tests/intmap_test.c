@@ -0,0 +1,222 @@
+/*
+* Mathi C Library - intmap_test.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include "mathi/intmap.h"
+
+/* A user instantiation with its own key and value types. */
+MATHI_INTMAP_DECLARE(IdNames, id_names, uint16_t, const char *)
+MATHI_INTMAP_DEFINE(IdNames, id_names, uint16_t, const char *)
+
+void test_i32map_basic()
+{
+    printf("Testing MathiI32Map put/get/remove/iteration...\n");
+
+    MathiI32Map m;
+    assert(mathi_i32map_init(&m, 0) == 0);
+    int64_t v = -1;
+    assert(mathi_i32map_get(&m, 5, &v) == 0 && v == -1);
+    assert(mathi_i32map_remove(&m, 5, NULL) == 0);
+
+    // Key 0 is the empty-slot sentinel internally but an ordinary key to callers.
+    enum { N = 20000 };
+    for(int32_t k = -N / 2; k < N / 2; k++) assert(mathi_i32map_put(&m, k, (int64_t)k * 3) == 0);
+    assert(mathi_i32map_put(&m, INT32_MIN, 1) == 0 && mathi_i32map_put(&m, INT32_MAX, 2) == 0);
+    assert(mathi_i32map_size(&m) == N + 2);
+    for(int32_t k = -N / 2; k < N / 2; k++) assert(mathi_i32map_get(&m, k, &v) == 1 && v == (int64_t)k * 3);
+    assert(mathi_i32map_get(&m, INT32_MIN, &v) == 1 && v == 1);
+    assert(mathi_i32map_get(&m, INT32_MAX, &v) == 1 && v == 2);
+    assert(mathi_i32map_get(&m, N, NULL) == 0);
+
+    // Updates keep the size; emplace hands out the existing slot.
+    assert(mathi_i32map_put(&m, 0, 100) == 0 && mathi_i32map_size(&m) == N + 2);
+    int inserted = -1;
+    int64_t *slot = mathi_i32map_emplace(&m, 0, &inserted);
+    assert(slot && *slot == 100 && inserted == 0);
+    slot = mathi_i32map_emplace(&m, N, &inserted);
+    assert(slot && *slot == 0 && inserted == 1);
+    *slot = 7;
+    assert(mathi_i32map_get(&m, N, &v) == 1 && v == 7);
+
+    // Iteration visits every entry once, key 0 included.
+    size_t iter = 0, visited = 0;
+    int32_t key;
+    int64_t sum = 0;
+    while(mathi_i32map_next(&m, &iter, &key, &v))
+    {
+        visited++;
+        sum += v;
+    }
+    assert(visited == mathi_i32map_size(&m));
+    assert(sum == (int64_t)3 * (-N / 2) + 100 + 1 + 2 + 7);
+
+    for(int32_t k = -N / 2; k < N / 2; k += 2)
+    {
+        assert(mathi_i32map_remove(&m, k, &v) == 1);
+        assert(mathi_i32map_remove(&m, k, NULL) == 0);
+    }
+    assert(mathi_i32map_size(&m) == N / 2 + 3);
+    for(int32_t k = -N / 2; k < N / 2; k++) assert(mathi_i32map_get(&m, k, NULL) == (k % 2 != 0));
+
+    mathi_i32map_clear(&m);
+    assert(mathi_i32map_size(&m) == 0 && mathi_i32map_get(&m, 1, NULL) == 0);
+    assert(mathi_i32map_put(&m, 1, 1) == 0 && mathi_i32map_size(&m) == 1);
+
+    mathi_i32map_free(&m);
+    mathi_i32map_free(&m);
+
+    printf("\n");
+}
+
+void test_i64map_churn()
+{
+    printf("Testing MathiI64Map against a reference under random churn...\n");
+
+    // Keys that differ only in their high bits, so the hash must carry those down to the index.
+    enum { KEYS = 512, OPS = 200000 };
+    int64_t keys[KEYS], ref[KEYS];
+    unsigned char present[KEYS] = {0};
+    for(int i = 0; i < KEYS; i++) keys[i] = (int64_t)((uint64_t)i << 40);
+
+    MathiI64Map m;
+    assert(mathi_i64map_init(&m, 0) == 0);
+    uint64_t s = 0x9E3779B97F4A7C15ull;
+    size_t live = 0;
+    for(int op = 0; op < OPS; op++)
+    {
+        s ^= s << 13, s ^= s >> 7, s ^= s << 17;
+        int k = (int)(s % KEYS);
+        if(s & (1ull << 40))
+        {
+            int64_t v;
+            int removed = mathi_i64map_remove(&m, keys[k], &v);
+            assert(removed == present[k]);
+            if(removed) assert(v == ref[k]);
+            live -= present[k];
+            present[k] = 0;
+        }
+        else
+        {
+            assert(mathi_i64map_put(&m, keys[k], op) == 0);
+            live += !present[k];
+            present[k] = 1;
+            ref[k] = op;
+        }
+        assert(mathi_i64map_size(&m) == live);
+    }
+    for(int i = 0; i < KEYS; i++)
+    {
+        int64_t v;
+        assert(mathi_i64map_get(&m, keys[i], &v) == present[i]);
+        if(present[i]) assert(v == ref[i]);
+    }
+
+    // Bulk calls agree with the single-key ones.
+    int64_t values[KEYS];
+    unsigned char found[KEYS];
+    memset(values, 0xff, sizeof(values));
+    assert(mathi_i64map_get_many(&m, keys, KEYS, values, found) == live);
+    for(int i = 0; i < KEYS; i++)
+    {
+        assert(found[i] == present[i]);
+        assert(values[i] == (present[i] ? ref[i] : -1));
+    }
+
+    int64_t big[] = {INT64_MIN, INT64_MAX, -1, 1};
+    int64_t big_values[] = {1, 2, 3, 4};
+    assert(mathi_i64map_put_many(&m, big, big_values, 4) == 0);
+    assert(mathi_i64map_get_many(&m, big, 4, NULL, NULL) == 4);
+    assert(mathi_i64map_size(&m) == live + 4);
+
+    mathi_i64map_free(&m);
+
+    printf("\n");
+}
+
+void test_intset()
+{
+    printf("Testing MathiI32Set and MathiI64Set, single and bulk...\n");
+
+    MathiI32Set s;
+    assert(mathi_i32set_init(&s, 100) == 0);
+    assert(s.cap >= 100 && mathi_i32set_size(&s) == 0);
+    assert(mathi_i32set_add(&s, 0) == 1 && mathi_i32set_add(&s, 0) == 0);
+    assert(mathi_i32set_add(&s, -5) == 1 && mathi_i32set_add(&s, -5) == 0);
+    assert(mathi_i32set_contains(&s, 0) && mathi_i32set_contains(&s, -5) && !mathi_i32set_contains(&s, 5));
+    assert(mathi_i32set_remove(&s, 0) == 1 && mathi_i32set_remove(&s, 0) == 0);
+    assert(mathi_i32set_size(&s) == 1);
+
+    // added[] marks first occurrences only, in input order.
+    int32_t keys[] = {3, 1, 3, 0, -5, 1, 0, 7};
+    unsigned char added[8], found[8];
+    assert(mathi_i32set_add_many(&s, keys, 8, added) == 0);
+    unsigned char want_added[] = {1, 1, 0, 1, 0, 0, 0, 1};
+    assert(memcmp(added, want_added, 8) == 0);
+    assert(mathi_i32set_size(&s) == 5);
+
+    int32_t probe[] = {0, 2, 3, -5, 8, 7, 1, INT32_MIN};
+    assert(mathi_i32set_contains_many(&s, probe, 8, found) == 5);
+    unsigned char want_found[] = {1, 0, 1, 1, 0, 1, 1, 0};
+    assert(memcmp(found, want_found, 8) == 0);
+
+    size_t iter = 0, visited = 0;
+    int32_t key, sum = 0;
+    while(mathi_i32set_next(&s, &iter, &key))
+    {
+        visited++;
+        sum += key;
+    }
+    assert(visited == 5 && sum == 3 + 1 + 0 - 5 + 7);
+    mathi_i32set_free(&s);
+
+    // Growth from empty with removals mixed in.
+    MathiI64Set t;
+    assert(mathi_i64set_init(&t, 0) == 0);
+    enum { N = 50000 };
+    for(int64_t k = 0; k < N; k++) assert(mathi_i64set_add(&t, k * 1000003) == 1);
+    for(int64_t k = 0; k < N; k += 3) assert(mathi_i64set_remove(&t, k * 1000003) == 1);
+    for(int64_t k = 0; k < N; k++) assert(mathi_i64set_contains(&t, k * 1000003) == (k % 3 != 0));
+    assert(mathi_i64set_size(&t) == N - (N + 2) / 3);
+    mathi_i64set_clear(&t);
+    assert(mathi_i64set_size(&t) == 0 && !mathi_i64set_contains(&t, 1000003));
+    mathi_i64set_free(&t);
+
+    printf("\n");
+}
+
+void test_custom_instance()
+{
+    printf("Testing a user-declared map (uint16_t -> const char *)...\n");
+
+    IdNames m;
+    assert(id_names_init(&m, 0) == 0);
+    assert(id_names_put(&m, 0, "zero") == 0);
+    assert(id_names_put(&m, 65535, "max") == 0);
+    const char *name = NULL;
+    assert(id_names_get(&m, 0, &name) == 1 && strcmp(name, "zero") == 0);
+    assert(id_names_get(&m, 65535, &name) == 1 && strcmp(name, "max") == 0);
+    assert(id_names_remove(&m, 65535, &name) == 1 && strcmp(name, "max") == 0);
+    assert(id_names_size(&m) == 1);
+    id_names_free(&m);
+
+    printf("\n");
+}
+
+int main()
+{
+    test_i32map_basic();
+    test_i64map_churn();
+    test_intset();
+    test_custom_instance();
+
+    printf("All intmap tests passed successfully!\n");
+
+    return 0;
+}
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <assert.h>
 #include "mathi/mathison.h"
 #include "mathi/config.h"
 
@@ -122,12 +123,64 @@ void test_config_save_and_load()
     printf("After reload, app_name = %s\n", mathi_conf_get_string("app_name"));
 }
 
+void test_large_object() 
+{
+    printf("Test: MathiJSON Large Object Lookup...\n");
+
+    // Past a handful of keys lookups go through the object's hash index.
+    MathiJSON *obj = mathison_new_object();
+    char key[32];
+    for (int i = 0; i < 1000; i++) 
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(mathison_set_value(obj, key, mathison_new_number(i)) == 0);
+    }
+    assert(obj->data.object.count == 1000);
+
+    // The writers build the index; lookups only read it, so concurrent readers are safe.
+    size_t *index = obj->data.object.index;
+    assert(index != NULL);
+    MathiJSON *v = NULL;
+    for (int i = 0; i < 1000; i++) 
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(mathison_get_value(obj, key, &v) == 0 && v->data.num == i);
+    }
+    assert(!mathison_has_key(obj, "key1000"));
+    assert(mathison_get_value(obj, "missing", &v) == -1);
+    assert(obj->data.object.index == index);
+
+    // Overwriting keeps a single entry; removal keeps the remaining keys reachable.
+    assert(mathison_set_value(obj, "key7", mathison_new_string("seven")) == 0);
+    assert(obj->data.object.count == 1000);
+    for (int i = 0; i < 1000; i += 2) 
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(mathison_remove_key(obj, key) == 0);
+    }
+    assert(obj->data.object.count == 500);
+    for (int i = 0; i < 1000; i++) 
+    {
+        snprintf(key, sizeof(key), "key%d", i);
+        assert(mathison_has_key(obj, key) == (i % 2 == 1));
+    }
+    assert(mathison_get_value(obj, "key7", &v) == 0 && mathison_is_string(v));
+
+    // Keys keep their insertion order after removals.
+    assert(strcmp(obj->data.object.keys[0], "key1") == 0);
+    assert(strcmp(obj->data.object.keys[499], "key999") == 0);
+
+    mathison_free(obj);
+    printf("Large object passed.\n\n");
+}
+
 int main() 
 {
     test_json_creation_and_types();
     test_config_basic_types();
     test_config_arrays_and_objects();
     test_config_save_and_load();
+    test_large_object();
 
     printf("\nAll MathiJSON + Config tests completed successfully!\n");
     return 0;
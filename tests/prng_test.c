@@ -0,0 +1,163 @@
+/*
+* Mathi C Library - prng_test.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <inttypes.h>
+#include "mathi/prng.h"
+
+void test_xoshiro256_reference()
+{
+    printf("Testing xoshiro256** against the reference output...\n");
+
+    // First outputs of the reference implementation from state {1, 2, 3, 4}.
+    MathiXoshiro256 rng = {{1, 2, 3, 4}};
+    assert(mathi_xoshiro256_next(&rng) == 11520ull);
+    assert(mathi_xoshiro256_next(&rng) == 0ull);
+    assert(mathi_xoshiro256_next(&rng) == 1509978240ull);
+    assert(mathi_xoshiro256_next(&rng) == 1215971899390074240ull);
+
+    // Seeding is deterministic and different seeds diverge.
+    MathiXoshiro256 a, b, c;
+    mathi_xoshiro256_seed(&a, 42);
+    mathi_xoshiro256_seed(&b, 42);
+    mathi_xoshiro256_seed(&c, 43);
+    for(int i = 0; i < 100; i++)
+    {
+        uint64_t x = mathi_xoshiro256_next(&a);
+        assert(x == mathi_xoshiro256_next(&b));
+        assert(x != mathi_xoshiro256_next(&c));
+    }
+
+    printf("\n");
+}
+
+void test_pcg64_reference()
+{
+    printf("Testing PCG64 against the reference output...\n");
+
+    // pcg64_srandom_r(&rng, 42, 54) from the PCG C reference demo.
+    static const uint64_t expected[] = {
+        0x86b1da1d72062b68ull, 0x1304aa46c9853d39ull, 0xa3670e9e0dd50358ull,
+        0xf9090e529a7dae00ull, 0xc85b9fd837996f2cull, 0x606121f8e3919196ull
+    };
+    MathiPcg64 rng;
+    mathi_pcg64_seed(&rng, 42, 54);
+    for(int i = 0; i < 6; i++)
+    {
+        uint64_t x = mathi_pcg64_next(&rng);
+        printf("pcg64[%d] = 0x%016" PRIx64 "\n", i, x);
+        assert(x == expected[i]);
+    }
+
+    // Same seed on another stream gives a different sequence.
+    MathiPcg64 other;
+    mathi_pcg64_seed(&other, 42, 55);
+    mathi_pcg64_seed(&rng, 42, 54);
+    assert(mathi_pcg64_next(&rng) != mathi_pcg64_next(&other));
+
+    printf("\n");
+}
+
+void test_jump_ahead()
+{
+    printf("Testing jump-ahead...\n");
+
+    // advance(delta) lands where delta calls to next() would.
+    MathiPcg64 p, q;
+    mathi_pcg64_seed(&p, 7, 9);
+    q = p;
+    for(int i = 0; i < 12345; i++) mathi_pcg64_next(&p);
+    mathi_pcg64_advance(&q, 12345);
+    assert(memcmp(&p, &q, sizeof(p)) == 0);
+    mathi_pcg64_advance(&q, 0);
+    assert(memcmp(&p, &q, sizeof(p)) == 0);
+
+    // Two 2^63 advances equal one 2^64 jump.
+    q = p;
+    mathi_pcg64_advance(&p, 1ull << 63);
+    mathi_pcg64_advance(&p, 1ull << 63);
+    mathi_pcg64_jump(&q);
+    assert(memcmp(&p, &q, sizeof(p)) == 0);
+
+    // Jumped xoshiro streams start somewhere new and never come back to the origin.
+    MathiXoshiro256 base, jumped, far;
+    mathi_xoshiro256_seed(&base, 1);
+    jumped = far = base;
+    mathi_xoshiro256_jump(&jumped);
+    mathi_xoshiro256_long_jump(&far);
+    assert(memcmp(&base, &jumped, sizeof(base)) != 0);
+    assert(memcmp(&base, &far, sizeof(base)) != 0);
+    assert(memcmp(&jumped, &far, sizeof(base)) != 0);
+    for(int i = 0; i < 1000; i++)
+    {
+        uint64_t x = mathi_xoshiro256_next(&base);
+        assert(x != mathi_xoshiro256_next(&jumped));
+        assert(x != mathi_xoshiro256_next(&far));
+    }
+
+    printf("\n");
+}
+
+void test_bounded_and_double()
+{
+    printf("Testing bounded integers and doubles...\n");
+
+    MathiXoshiro256 x;
+    MathiPcg64 p;
+    mathi_xoshiro256_seed(&x, 2024);
+    mathi_pcg64_seed(&p, 2024, 1);
+
+    assert(mathi_xoshiro256_bounded(&x, 0) == 0);
+    assert(mathi_pcg64_bounded(&p, 1) == 0);
+
+    // Large, non-power-of-two bounds: results stay in range.
+    uint64_t big = (1ull << 63) + 12345;
+    for(int i = 0; i < 10000; i++)
+    {
+        assert(mathi_xoshiro256_bounded(&x, big) < big);
+        assert(mathi_pcg64_bounded(&p, 3) < 3);
+    }
+
+    // A die roll: each face within 5% of its expected count.
+    enum { ROLLS = 600000, FACES = 6 };
+    long counts[2][FACES] = {{0}};
+    for(int i = 0; i < ROLLS; i++)
+    {
+        counts[0][mathi_xoshiro256_bounded(&x, FACES)]++;
+        counts[1][mathi_pcg64_bounded(&p, FACES)]++;
+    }
+    for(int g = 0; g < 2; g++)
+        for(int f = 0; f < FACES; f++)
+        {
+            long expect = ROLLS / FACES;
+            assert(counts[g][f] > expect * 95 / 100 && counts[g][f] < expect * 105 / 100);
+        }
+
+    double sum = 0;
+    for(int i = 0; i < 100000; i++)
+    {
+        double u = mathi_xoshiro256_double(&x), v = mathi_pcg64_double(&p);
+        assert(u >= 0.0 && u < 1.0 && v >= 0.0 && v < 1.0);
+        sum += u + v;
+    }
+    assert(sum / 200000 > 0.49 && sum / 200000 < 0.51);
+
+    printf("\n");
+}
+
+int main()
+{
+    test_xoshiro256_reference();
+    test_pcg64_reference();
+    test_jump_ahead();
+    test_bounded_and_double();
+
+    printf("All prng tests passed successfully!\n");
+
+    return 0;
+}
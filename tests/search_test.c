@@ -7,6 +7,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
 #include "mathi/search.h"
 
 void test_search_algorithms()
@@ -37,8 +40,264 @@ void test_search_algorithms()
     printf("All search algorithm tests passed successfully!\n");
 }
 
+void test_search_index()
+{
+    printf("Testing search index...\n");
+
+    int sizes[] = {0, 1, 2, 3, 7, 15, 16, 17, 100, 1000, 4097};
+    for(size_t t = 0; t < sizeof(sizes) / sizeof(sizes[0]); t++) 
+    {
+        int n = sizes[t];
+        int *arr = malloc((n + 1) * sizeof(int));
+        assert(arr);
+        for(int i = 0, v = -50; i < n; i++) 
+        {
+            v += (i * 7) % 3;  // steps of 0, 1 and 2: duplicates and gaps
+            arr[i] = v;
+        }
+
+        MathiSearchIndex *idx = mathi_search_index_build(arr, n);
+        assert(idx);
+        int lo = n ? arr[0] - 2 : -3, hi = n ? arr[n - 1] + 2 : 3;
+        for(int key = lo; key <= hi; key++) 
+        {
+            size_t expect = 0;
+            while(expect < (size_t)n && arr[expect] < key) expect++;
+            assert(mathi_search_index_lower_bound(idx, key) == expect);
+
+            ptrdiff_t pos = mathi_search_index_find(idx, key);
+            if(expect < (size_t)n && arr[expect] == key) assert(pos == (ptrdiff_t)expect);
+            else assert(pos == -1);
+        }
+        mathi_search_index_free(idx);
+        free(arr);
+    }
+
+    int extremes[] = {-2147483647 - 1, 0, 2147483647};
+    MathiSearchIndex *idx = mathi_search_index_build(extremes, 3);
+    assert(mathi_search_index_find(idx, 2147483647) == 2);
+    assert(mathi_search_index_find(idx, -2147483647 - 1) == 0);
+    assert(mathi_search_index_lower_bound(idx, 1) == 2);
+    mathi_search_index_free(idx);
+
+    printf("Search index passed!\n");
+}
+
+void test_binary_search_batch()
+{
+    printf("Testing binary_search_batch...\n");
+
+    enum { N = 5000, M = 300000 };
+    int *arr = malloc(N * sizeof(int)), *keys = malloc(M * sizeof(int));
+    ptrdiff_t *out = malloc(M * sizeof(ptrdiff_t)), *out_mt = malloc(M * sizeof(ptrdiff_t));
+    assert(arr && keys && out && out_mt);
+
+    for(int i = 0; i < N; i++) arr[i] = (i / 3) * 2;   // each even value three times
+    unsigned x = 17u;
+    for(int i = 0; i < M; i++) 
+    {
+        x = x * 1103515245u + 12345u;
+        keys[i] = (int)((x >> 8) % (2 * N / 3 + 10)) - 5;
+    }
+
+    mathi_binary_search_batch(arr, N, keys, M, out);
+    mathi_binary_search_batch_mt(arr, N, keys, M, out_mt, 4);
+    for(int i = 0; i < M; i++) 
+    {
+        int k = keys[i];
+        ptrdiff_t expect = (k >= 0 && k % 2 == 0 && k / 2 * 3 < N) ? k / 2 * 3 : -1;
+        assert(out[i] == expect);
+        assert(out_mt[i] == expect);
+    }
+
+    // Sizes around the group width and an empty array
+    for(int n = 0; n <= 40; n++) 
+    {
+        mathi_binary_search_batch(arr, n, keys, 37, out);
+        for(int i = 0; i < 37; i++) 
+        {
+            ptrdiff_t expect = -1;
+            for(int j = 0; j < n; j++) if(arr[j] == keys[i]) { expect = j; break; }
+            assert(out[i] == expect);
+        }
+    }
+
+    free(arr);
+    free(keys);
+    free(out);
+    free(out_mt);
+    printf("Binary search batch passed!\n");
+}
+
+void test_bounds()
+{
+    printf("Testing lower_bound, upper_bound, equal_range and count_range...\n");
+
+    enum { N = 300 };
+    int32_t a32[N];
+    int64_t a64[N];
+    double af[N];
+
+    for(int n = 0; n <= N; n += (n < 40 ? 1 : 37)) 
+    {
+        for(int i = 0; i < n; i++) 
+        {
+            a32[i] = (i / 4) * 3 - 20;              // runs of four, gaps of three
+            a64[i] = (int64_t)a32[i] * 10000000000LL;
+            af[i] = a32[i] * 0.5;
+        }
+        if(n > 2) af[n - 1] = af[n - 2] = NAN;     // NaNs sort last
+
+        for(int key = -25; key <= 3 * (n / 4) - 15; key++) 
+        {
+            size_t lo = 0, hi = 0;
+            while(lo < (size_t)n && a32[lo] < key) lo++;
+            hi = lo;
+            while(hi < (size_t)n && a32[hi] == key) hi++;
+
+            size_t f, l;
+            assert(mathi_lower_bound_i32(a32, n, key) == lo);
+            assert(mathi_upper_bound_i32(a32, n, key) == hi);
+            mathi_equal_range_i32(a32, n, key, &f, &l);
+            assert(f == lo && l == hi);
+
+            int64_t k64 = (int64_t)key * 10000000000LL;
+            assert(mathi_lower_bound_i64(a64, n, k64) == lo);
+            assert(mathi_upper_bound_i64(a64, n, k64) == hi);
+            mathi_equal_range_i64(a64, n, k64, &f, &l);
+            assert(f == lo && l == hi);
+
+            size_t nf = n > 2 ? n - 2 : n;          // numbers before the NaNs
+            size_t flo = lo < nf ? lo : nf, fhi = hi < nf ? hi : nf;
+            assert(mathi_lower_bound_f64(af, n, key * 0.5) == flo);
+            assert(mathi_upper_bound_f64(af, n, key * 0.5) == fhi);
+
+            assert(mathi_count_range_i32(a32, n, key, key + 4) ==
+                   mathi_lower_bound_i32(a32, n, key + 4) - lo);
+        }
+
+        if(n > 2) 
+        {
+            assert(mathi_lower_bound_f64(af, n, NAN) == (size_t)n - 2);
+            assert(mathi_upper_bound_f64(af, n, NAN) == (size_t)n);
+        }
+        assert(mathi_count_range_i32(a32, n, INT32_MIN, INT32_MAX) == (size_t)n);
+        assert(mathi_count_range_i32(a32, n, 5, 5) == 0);
+        assert(mathi_count_range_i64(a64, n, INT64_MIN, INT64_MAX) == (size_t)n);
+        assert(mathi_count_range_f64(af, n, -INFINITY, INFINITY) == (n > 2 ? (size_t)n - 2 : (size_t)n));
+    }
+
+    printf("Bounds passed!\n");
+}
+
+void test_learned_index()
+{
+    printf("Testing learned index...\n");
+
+    enum { N = 20000 };
+    int32_t *a32 = malloc(N * sizeof(int32_t));
+    int64_t *a64 = malloc(N * sizeof(int64_t));
+    assert(a32 && a64);
+
+    // Skewed keys with duplicates: quadratic growth, then a dense cluster
+    for(int i = 0; i < N; i++) 
+    {
+        a32[i] = i < N / 2 ? (i / 2) * (i / 2) / 7 - 1000 : 3600000 + i / 4;
+        a64[i] = (int64_t)a32[i] * 1000003LL;
+    }
+    for(int i = 1; i < N; i++) assert(a32[i - 1] <= a32[i]);
+
+    size_t eps_list[] = {0, 4, 64};
+    for(size_t e = 0; e < sizeof(eps_list) / sizeof(eps_list[0]); e++) 
+    {
+        MathiLearnedIndex *i32 = mathi_learned_index_build_i32(a32, N, eps_list[e]);
+        MathiLearnedIndex *i64 = mathi_learned_index_build_i64(a64, N, eps_list[e]);
+        assert(i32 && i64 && i32->nseg > 0 && i32->nseg < N);
+
+        unsigned x = 5u;
+        for(int q = 0; q < 20000; q++) 
+        {
+            x = x * 1103515245u + 12345u;
+            int32_t key = (q & 1) ? a32[(x >> 4) % N] + (int)(x % 3) - 1 : (int32_t)((x >> 1) % 3700000) - 2000;
+            size_t expect = mathi_lower_bound_i32(a32, N, key);
+            assert(mathi_learned_index_lower_bound_i32(i32, a32, key) == expect);
+            ptrdiff_t f = mathi_learned_index_find_i32(i32, a32, key);
+            assert(f == (expect < N && a32[expect] == key ? (ptrdiff_t)expect : -1));
+
+            int64_t k64 = (int64_t)key * 1000003LL + (q % 3 == 0);
+            assert(mathi_learned_index_lower_bound_i64(i64, a64, k64) == mathi_lower_bound_i64(a64, N, k64));
+        }
+        mathi_learned_index_free(i32);
+        mathi_learned_index_free(i64);
+    }
+
+    // Save / load round trip
+    MathiLearnedIndex *idx = mathi_learned_index_build_i32(a32, N, 16);
+    assert(mathi_learned_index_save(idx, "test_learned.idx") == 0);
+    MathiLearnedIndex *loaded = mathi_learned_index_load("test_learned.idx");
+    assert(loaded && loaded->nseg == idx->nseg && loaded->n == idx->n && loaded->eps == 16);
+    for(int i = 0; i < N; i += 97) assert(mathi_learned_index_find_i32(loaded, a32, a32[i]) == (ptrdiff_t)mathi_lower_bound_i32(a32, N, a32[i]));
+    mathi_learned_index_free(loaded);
+
+    // Truncated and tampered files are rejected rather than trusted by the lookups.
+    size_t nseg = idx->nseg, size = 40 + 24 * nseg;
+    assert(nseg >= 2);
+    unsigned char *image = malloc(size), *bad = malloc(size);
+    assert(image && bad);
+    FILE *f = fopen("test_learned.idx", "rb");
+    assert(f && fread(image, 1, size, f) == size && fgetc(f) == EOF);
+    fclose(f);
+
+    int64_t dup_key = idx->seg_key[0];
+    double past_end = N + 1, nan_value = NAN, pos_one = 1;
+    struct { size_t offset; const void *value; } tampers[] = {
+        {40 + 8, &dup_key},                        // seg_key[1] == seg_key[0]
+        {40 + 8 * nseg, &nan_value},               // seg_slope[0] is NaN
+        {40 + 16 * nseg, &pos_one},                // seg_pos[0] != 0
+        {40 + 16 * nseg + 8, &nan_value},          // seg_pos[1] is NaN
+        {40 + 24 * nseg - 8, &past_end},           // last seg_pos > n
+    };
+    for(size_t t = 0; t < sizeof(tampers) / sizeof(tampers[0]); t++)
+    {
+        memcpy(bad, image, size);
+        memcpy(bad + tampers[t].offset, tampers[t].value, 8);
+        f = fopen("test_learned.idx", "wb");
+        assert(f && fwrite(bad, 1, size, f) == size);
+        fclose(f);
+        assert(mathi_learned_index_load("test_learned.idx") == NULL);
+    }
+    f = fopen("test_learned.idx", "wb");
+    assert(f && fwrite(image, 1, size - 8, f) == size - 8);
+    fclose(f);
+    assert(mathi_learned_index_load("test_learned.idx") == NULL);
+
+    free(image);
+    free(bad);
+    mathi_learned_index_free(idx);
+    remove("test_learned.idx");
+    assert(mathi_learned_index_load("no_such_index.idx") == NULL);
+
+    // Empty and single-element arrays
+    MathiLearnedIndex *empty = mathi_learned_index_build_i32(a32, 0, 8);
+    assert(empty && mathi_learned_index_find_i32(empty, a32, 5) == -1);
+    mathi_learned_index_free(empty);
+    int32_t one = 42;
+    MathiLearnedIndex *single = mathi_learned_index_build_i32(&one, 1, 8);
+    assert(mathi_learned_index_find_i32(single, &one, 42) == 0);
+    assert(mathi_learned_index_lower_bound_i32(single, &one, 43) == 1);
+    mathi_learned_index_free(single);
+
+    free(a32);
+    free(a64);
+    printf("Learned index passed!\n");
+}
+
 int main()
 {
     test_search_algorithms();
+    test_search_index();
+    test_binary_search_batch();
+    test_bounds();
+    test_learned_index();
     return 0;
 }
\ No newline at end of file
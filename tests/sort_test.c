@@ -5,8 +5,12 @@
 */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
 #include <assert.h>
 #include <string.h>
+#include <stddef.h>
+#include <math.h>
 #include "mathi/sort.h"
 #include "mathi/print.h"
 #include "mathi/array.h"
@@ -66,6 +70,24 @@ void test_sort_algorithms()
     assert(mathi_arr_sorted(arr, n));
     printf("Quick Sort passed!\n\n");
 
+    // Intro sort
+    memcpy(arr, original, sizeof(original));
+    printf("Testing Intro Sort...\n");
+    mathi_prnt_arr(arr, n, "Before");
+    mathi_intro_sort(arr, n);
+    mathi_prnt_arr(arr, n, "After");
+    assert(mathi_arr_sorted(arr, n));
+    printf("Intro Sort passed!\n\n");
+
+    // Tim sort
+    memcpy(arr, original, sizeof(original));
+    printf("Testing Tim Sort...\n");
+    mathi_prnt_arr(arr, n, "Before");
+    mathi_tim_sort(arr, n);
+    mathi_prnt_arr(arr, n, "After");
+    assert(mathi_arr_sorted(arr, n));
+    printf("Tim Sort passed!\n\n");
+
     // Heap sort
     memcpy(arr, original, sizeof(original));
     printf("Testing Heap Sort...\n");
@@ -84,11 +106,497 @@ void test_sort_algorithms()
     assert(mathi_arr_sorted(arr, n));
     printf("Counting Sort passed!\n\n");
 
+    // Radix sort
+    memcpy(arr, original, sizeof(original));
+    printf("Testing Radix Sort...\n");
+    mathi_prnt_arr(arr, n, "Before");
+    mathi_radix_sort(arr, n);
+    mathi_prnt_arr(arr, n, "After");
+    assert(mathi_arr_sorted(arr, n));
+    printf("Radix Sort passed!\n\n");
+
     printf("All sort algorithm tests passed!\n");
 }
 
+void test_intro_sort_patterns()
+{
+    enum { N = 200000 };
+    static int arr[N];
+
+    printf("Testing Intro Sort on adversarial patterns...\n");
+
+    // Sorted, reversed, organ-pipe and all-equal used to drive quick sort quadratic
+    for(int i = 0; i < N; i++) arr[i] = i;
+    mathi_quick_sort(arr, N);
+    assert(mathi_arr_sorted(arr, N));
+
+    for(int i = 0; i < N; i++) arr[i] = N - i;
+    mathi_quick_sort(arr, N);
+    assert(mathi_arr_sorted(arr, N));
+
+    for(int i = 0; i < N; i++) arr[i] = i < N / 2 ? i : N - i;
+    mathi_quick_sort(arr, N);
+    assert(mathi_arr_sorted(arr, N));
+
+    for(int i = 0; i < N; i++) arr[i] = 42;
+    mathi_quick_sort(arr, N);
+    assert(mathi_arr_sorted(arr, N) && arr[0] == 42 && arr[N - 1] == 42);
+
+    // Few unique values with negatives
+    unsigned x = 12345;
+    long long sum = 0, sorted_sum = 0;
+    for(int i = 0; i < N; i++) 
+    {
+        x = x * 1103515245u + 12345u;
+        arr[i] = (int)(x >> 16) % 7 - 3;
+        sum += arr[i];
+    }
+    mathi_intro_sort(arr, N);
+    for(int i = 0; i < N; i++) sorted_sum += arr[i];
+    assert(mathi_arr_sorted(arr, N) && sum == sorted_sum);
+
+    printf("Intro Sort patterns passed!\n\n");
+}
+
+void test_radix_sort_full_range()
+{
+    enum { N = 100000 };
+    static int arr[N], ref[N], scratch[N];
+
+    printf("Testing Radix Sort over the signed 32-bit range...\n");
+
+    unsigned x = 2463534242u;
+    for(int i = 0; i < N; i++) 
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        arr[i] = ref[i] = (int)x;
+    }
+    arr[0] = ref[0] = -2147483647 - 1;
+    arr[1] = ref[1] = 2147483647;
+
+    mathi_radix_sort_buf(arr, N, scratch);
+    mathi_intro_sort(ref, N);
+    assert(memcmp(arr, ref, sizeof(arr)) == 0);
+
+    // Keys sharing their upper digits exercise the skipped passes
+    for(int i = 0; i < N; i++) arr[i] = ref[i] = (N - i) % 200 - 100;
+    mathi_radix_sort(arr, N);
+    mathi_intro_sort(ref, N);
+    assert(memcmp(arr, ref, sizeof(arr)) == 0);
+
+    printf("Radix Sort full range passed!\n\n");
+}
+
+void test_parallel_sort()
+{
+    enum { N = 300000 };
+    static int arr[N], ref[N];
+    int thread_counts[] = {0, 1, 2, 3, 4, 7};
+
+    printf("Testing Parallel Sort...\n");
+
+    for(size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) 
+    {
+        unsigned x = 88172645u + t;
+        for(int i = 0; i < N; i++) 
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            arr[i] = ref[i] = (int)(x % 100000) - 50000;
+        }
+        mathi_parallel_sort(arr, N, thread_counts[t]);
+        mathi_intro_sort(ref, N);
+        assert(memcmp(arr, ref, sizeof(arr)) == 0);
+        printf("threads = %d passed\n", thread_counts[t]);
+    }
+
+    // Uneven tail and already-sorted input
+    mathi_parallel_sort(arr, N - 13, 4);
+    assert(mathi_arr_sorted(arr, N));
+
+    int small[] = {3, 1, 2};
+    mathi_parallel_sort(small, 3, 8);
+    assert(mathi_arr_sorted(small, 3));
+
+    printf("Parallel Sort passed!\n\n");
+}
+
+void test_tim_sort_patterns()
+{
+    enum { N = 100000 };
+    static int arr[N], ref[N];
+
+    printf("Testing Tim Sort on partially sorted patterns...\n");
+
+    for(int pattern = 0; pattern < 6; pattern++) 
+    {
+        unsigned x = 2463534242u + pattern;
+        for(int i = 0; i < N; i++) 
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            switch(pattern) 
+            {
+                case 0: arr[i] = (int)x; break;                         // random
+                case 1: arr[i] = i; break;                              // sorted
+                case 2: arr[i] = N - i; break;                          // reversed
+                case 3: arr[i] = i % 1000 + (int)(x % 3); break;        // sawtooth
+                case 4: arr[i] = i < N - 500 ? i : (int)(x % N); break; // appended tail
+                default: arr[i] = (int)(x % 4); break;                  // few unique
+            }
+            ref[i] = arr[i];
+        }
+        mathi_tim_sort(arr, N);
+        mathi_intro_sort(ref, N);
+        assert(memcmp(arr, ref, sizeof(arr)) == 0);
+    }
+
+    printf("Tim Sort patterns passed!\n\n");
+}
+
+void test_typed_sorts()
+{
+    enum { N = 5000 };
+    static int64_t i64[N];
+    static uint32_t u32[N];
+    static double f64[N];
+    static float f32[N];
+
+    printf("Testing typed sorts...\n");
+
+    unsigned long long x = 88172645463325252ull;
+    for(int i = 0; i < N; i++) 
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        i64[i] = (int64_t)x;
+        u32[i] = (uint32_t)(x >> 32);
+        f64[i] = (double)(int64_t)x / 1e12;
+        f32[i] = (float)f64[i];
+    }
+    f64[10] = NAN;
+    f64[20] = -INFINITY;
+    f64[30] = NAN;
+    f32[40] = NAN;
+
+    mathi_sort_i64(i64, N);
+    mathi_sort_u32(u32, N);
+    mathi_sort_f64(f64, N);
+    mathi_sort_f32(f32, N);
+
+    for(int i = 1; i < N; i++) 
+    {
+        assert(i64[i - 1] <= i64[i]);
+        assert(u32[i - 1] <= u32[i]);
+    }
+    // NaNs are ordered after every number, including +inf
+    assert(f64[0] == -INFINITY);
+    assert(isnan(f64[N - 1]) && isnan(f64[N - 2]) && !isnan(f64[N - 3]));
+    for(int i = 1; i < N - 2; i++) assert(f64[i - 1] <= f64[i]);
+    assert(isnan(f32[N - 1]) && !isnan(f32[N - 2]));
+    for(int i = 1; i < N - 1; i++) assert(f32[i - 1] <= f32[i]);
+
+    printf("Typed sorts passed!\n\n");
+}
+
+typedef struct {
+    char name[12];
+    double score;
+    int64_t id;
+} TestRecord;
+
+void test_record_sort()
+{
+    enum { N = 1000 };
+    static TestRecord recs[N];
+
+    printf("Testing record sort...\n");
+
+    for(int i = 0; i < N; i++) 
+    {
+        recs[i].id = (int64_t)((i * 7919) % N) - N / 2;
+        recs[i].score = -recs[i].id * 0.5;
+        snprintf(recs[i].name, sizeof(recs[i].name), "r%lld", (long long)recs[i].id);
+    }
+
+    assert(mathi_sort_records(recs, N, sizeof(TestRecord), offsetof(TestRecord, id), MATHI_KEY_I64) == 0);
+    for(int i = 0; i < N; i++) 
+    {
+        assert(recs[i].id == i - N / 2);
+        assert(recs[i].score == -recs[i].id * 0.5);
+    }
+
+    assert(mathi_sort_records(recs, N, sizeof(TestRecord), offsetof(TestRecord, score), MATHI_KEY_F64) == 0);
+    for(int i = 1; i < N; i++) assert(recs[i - 1].score <= recs[i].score);
+    assert(recs[0].id == N / 2 - 1);
+
+    // Key that does not fit inside the record is rejected
+    assert(mathi_sort_records(recs, N, sizeof(TestRecord), sizeof(TestRecord) - 4, MATHI_KEY_I64) == -1);
+
+    printf("Record sort passed!\n\n");
+}
+
+void test_sort_small()
+{
+    int arr[64], ref[64];
+    float farr[64], fref[64];
+
+    printf("Testing Small Sort kernels...\n");
+
+    unsigned x = 7u;
+    for(int n = 0; n <= 64; n++) 
+    {
+        for(int rep = 0; rep < 20; rep++) 
+        {
+            for(int i = 0; i < n; i++) 
+            {
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                arr[i] = ref[i] = rep % 2 ? (int)x : (int)(x % 5) - 2;
+                farr[i] = fref[i] = rep % 2 ? (float)(int)x / 1000.0f : (float)(x % 3) - 1.0f;
+            }
+            if(n > 3 && rep == 2) 
+            {
+                arr[1] = ref[1] = 2147483647;
+                arr[2] = ref[2] = -2147483647 - 1;
+                farr[1] = fref[1] = INFINITY;
+                farr[2] = fref[2] = -0.0f;
+            }
+            mathi_sort_small(arr, n);
+            mathi_insertion_sort(ref, n);
+            assert(n == 0 || memcmp(arr, ref, n * sizeof(int)) == 0);
+
+            mathi_sort_small_f32(farr, n);
+            mathi_sort_f32(fref, n);
+            for(int i = 0; i < n; i++) assert(farr[i] == fref[i]);
+        }
+    }
+
+    // Blocks with NaN keep the typed-sort ordering
+    float nan_block[5] = {3.0f, NAN, -1.0f, 2.0f, NAN};
+    mathi_sort_small_f32(nan_block, 5);
+    assert(nan_block[0] == -1.0f && nan_block[2] == 3.0f && isnan(nan_block[3]) && isnan(nan_block[4]));
+
+    // Larger arrays are handed to Introsort
+    int big[100];
+    for(int i = 0; i < 100; i++) big[i] = 100 - i;
+    mathi_sort_small(big, 100);
+    assert(mathi_arr_sorted(big, 100));
+
+    printf("Small Sort passed!\n\n");
+}
+
+void test_argsort_and_pairs()
+{
+    enum { N = 20000 };
+    static int keys[N], vals[N], idx[N], sorted_keys[N];
+    static double col_d[N], out_d[N];
+    static short col_s[N], out_s[N];
+
+    printf("Testing argsort, sort_pairs and gather...\n");
+
+    unsigned x = 99u;
+    for(int i = 0; i < N; i++) 
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        keys[i] = (int)(x % 1000) - 500;
+        vals[i] = i;
+        col_d[i] = keys[i] * 0.25;
+        col_s[i] = (short)keys[i];
+    }
+
+    assert(mathi_argsort(keys, N, idx) == 0);
+    for(int i = 1; i < N; i++) 
+    {
+        assert(keys[idx[i - 1]] <= keys[idx[i]]);
+        if(keys[idx[i - 1]] == keys[idx[i]]) assert(idx[i - 1] < idx[i]); // stable
+    }
+
+    // Gather two extra columns with the permutation
+    const void *src[] = {col_d, col_s};
+    void *dst[] = {out_d, out_s};
+    size_t sizes[] = {sizeof(double), sizeof(short)};
+    mathi_gather_columns(idx, N, src, dst, sizes, 2);
+    for(int i = 0; i < N; i++) 
+    {
+        assert(out_d[i] == keys[idx[i]] * 0.25);
+        assert(out_s[i] == (short)keys[idx[i]]);
+    }
+
+    // sort_pairs moves values with keys and agrees with argsort
+    memcpy(sorted_keys, keys, sizeof(keys));
+    assert(mathi_sort_pairs(sorted_keys, vals, N) == 0);
+    for(int i = 0; i < N; i++) 
+    {
+        assert(vals[i] == idx[i]);
+        assert(sorted_keys[i] == keys[vals[i]]);
+    }
+
+    int small_k[] = {3, 1, 3, 2, 1};
+    int small_v[] = {0, 1, 2, 3, 4};
+    assert(mathi_sort_pairs(small_k, small_v, 5) == 0);
+    int expect_v[] = {1, 4, 3, 0, 2};
+    assert(memcmp(small_v, expect_v, sizeof(expect_v)) == 0);
+
+    printf("Argsort and sort_pairs passed!\n\n");
+}
+
+void test_external_sort()
+{
+    enum { N = 200000 };
+    const char *in = "test_ext_in.bin";
+    const char *out = "test_ext_out.bin";
+    int *data = malloc(N * sizeof(int));
+    int *back = malloc(N * sizeof(int));
+    assert(data && back);
+
+    printf("Testing external sort...\n");
+
+    unsigned x = 12345u;
+    for(int i = 0; i < N; i++) 
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        data[i] = (int)x;
+    }
+    data[0] = INT_MIN;
+    data[1] = INT_MAX;
+
+    // Budgets: one in-memory run, a single merge pass, and several merge passes
+    size_t budgets[] = {16u << 20, 1u << 20, 64u << 10};
+    for(size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) 
+    {
+        FILE *f = fopen(in, "wb");
+        assert(f);
+        size_t written = fwrite(data, sizeof(int), N, f);
+        fclose(f);
+        assert(written == N);
+
+        assert(mathi_external_sort(in, out, budgets[b]) == 0);
+
+        f = fopen(out, "rb");
+        assert(f);
+        size_t got = fread(back, sizeof(int), N, f);
+        int extra = fgetc(f);
+        fclose(f);
+        assert(got == N && extra == EOF);
+
+        for(int i = 1; i < N; i++) assert(back[i - 1] <= back[i]);
+        assert(back[0] == INT_MIN && back[N - 1] == INT_MAX);
+
+        long long sum_in = 0, sum_out = 0;
+        for(int i = 0; i < N; i++) 
+        {
+            sum_in += data[i];
+            sum_out += back[i];
+        }
+        assert(sum_in == sum_out);
+    }
+
+    // Sorting in place and empty / malformed inputs
+    assert(mathi_external_sort(out, out, 64u << 10) == 0);
+    FILE *f = fopen(in, "wb");
+    fclose(f);
+    assert(mathi_external_sort(in, out, 1u << 20) == 0);
+    f = fopen(in, "wb");
+    fputc('x', f);
+    fclose(f);
+    assert(mathi_external_sort(in, out, 1u << 20) == -1);
+    assert(mathi_external_sort("no_such_file.bin", out, 1u << 20) == -1);
+
+    remove(in);
+    remove(out);
+    free(data);
+    free(back);
+
+    printf("External sort passed!\n\n");
+}
+
+void test_selection_and_topk()
+{
+    enum { N = 5000 };
+    static int arr[N], ref[N], out[N];
+
+    printf("Testing nth_element, partial_sort and topk...\n");
+
+    for(int pattern = 0; pattern < 4; pattern++) 
+    {
+        unsigned x = 7u + pattern;
+        for(int i = 0; i < N; i++) 
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            switch(pattern) 
+            {
+                case 0: ref[i] = (int)x; break;
+                case 1: ref[i] = i; break;
+                case 2: ref[i] = (int)(x % 5); break;
+                default: ref[i] = (i % 2) ? i : N - i; break; // organ-pipe-like
+            }
+        }
+        memcpy(arr, ref, sizeof(ref));
+        mathi_intro_sort(ref, N);
+
+        int ks[] = {0, 1, N / 3, N / 2, N - 2, N - 1};
+        for(size_t j = 0; j < sizeof(ks) / sizeof(ks[0]); j++) 
+        {
+            int k = ks[j];
+            memcpy(out, arr, sizeof(arr));
+            mathi_nth_element(out, N, k);
+            assert(out[k] == ref[k]);
+            for(int i = 0; i < k; i++) assert(out[i] <= out[k]);
+            for(int i = k + 1; i < N; i++) assert(out[i] >= out[k]);
+
+            memcpy(out, arr, sizeof(arr));
+            mathi_partial_sort(out, N, k + 1);
+            assert(memcmp(out, ref, (k + 1) * sizeof(int)) == 0);
+        }
+
+        // Top 10 largest, pushed one at a time and in uneven batches
+        MathiTopK *t1 = mathi_topk_new(10), *t2 = mathi_topk_new(10);
+        assert(t1 && t2);
+        for(int i = 0; i < N; i++) mathi_topk_push(t1, arr[i]);
+        for(int i = 0; i < N; i += 777) mathi_topk_push_array(t2, arr + i, N - i < 777 ? N - i : 777);
+        int top1[10], top2[10];
+        assert(mathi_topk_result(t1, top1) == 10);
+        assert(mathi_topk_result(t2, top2) == 10);
+        for(int i = 0; i < 10; i++) assert(top1[i] == ref[N - 1 - i] && top2[i] == top1[i]);
+        mathi_topk_free(t1);
+        mathi_topk_free(t2);
+    }
+
+    MathiTopK *t = mathi_topk_new(8);
+    int few[] = {3, 9, 1}, res[8];
+    mathi_topk_push_array(t, few, 3);
+    assert(mathi_topk_result(t, res) == 3 && res[0] == 9 && res[1] == 3 && res[2] == 1);
+    mathi_topk_free(t);
+    assert(mathi_topk_new(0) == NULL);
+
+    printf("Selection and top-k passed!\n\n");
+}
+
 int main()
 {
     test_sort_algorithms();
+    test_intro_sort_patterns();
+    test_radix_sort_full_range();
+    test_parallel_sort();
+    test_tim_sort_patterns();
+    test_typed_sorts();
+    test_record_sort();
+    test_sort_small();
+    test_argsort_and_pairs();
+    test_external_sort();
+    test_selection_and_topk();
     return 0;
 }
\ No newline at end of file
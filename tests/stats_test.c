@@ -44,6 +44,13 @@ void test_statistics()
     printf("Mode: %d\n", mo);
     assert(mo == 5);
 
+    // Ties go to the smallest value, including 0 and negatives.
+    int ties[] = {7, 0, -3, 7, 0, -3, 9};
+    assert(mathi_mode(ties, 7) == -3);
+    int zeros[] = {4, 0, 0, 4, 0};
+    assert(mathi_mode(zeros, 5) == 0);
+    assert(mathi_mode(data, 0) == 0);
+
     // Percentiles
     double p25 = mathi_percentile(data, n, 25);
     double p50 = mathi_percentile(data, n, 50);
@@ -59,8 +66,30 @@ void test_statistics()
     printf("\nAll statistics tests passed!\n");
 }
 
+void test_order_statistics()
+{
+    printf("Testing median and percentile on larger inputs...\n");
+
+    enum { N = 1000 };
+    int data[N];
+    for(int i = 0; i < N; i++) data[i] = (i * 7919) % N; // permutation of 0..N-1
+
+    assert(fabs(mathi_median(data, N) - 499.5) < 1e-9);
+    assert(fabs(mathi_median(data, N - 1) - mathi_percentile(data, N - 1, 50)) < 1e-9);
+    assert(fabs(mathi_percentile(data, N, 0) - 0.0) < 1e-9);
+    assert(fabs(mathi_percentile(data, N, 100) - (N - 1)) < 1e-9);
+    assert(fabs(mathi_percentile(data, N, 90) - 899.1) < 1e-9);
+    assert(data[0] == 0 && data[1] == 7919 % N); // input left untouched
+
+    int even[] = {4, 1, 3, 2};
+    assert(fabs(mathi_median(even, 4) - 2.5) < 1e-9);
+
+    printf("Order statistics passed!\n");
+}
+
 int main()
 {
     test_statistics();
+    test_order_statistics();
     return 0;
 }
\ No newline at end of file
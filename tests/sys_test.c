@@ -60,8 +60,21 @@ void test_sys_env()
     printf("All sys environment variable tests passed!\n");
 }
 
+void test_cpu_features()
+{
+    printf("Testing CPU feature detection...\n");
+
+    int avx2 = mathi_cpu_has_avx2();
+    printf("AVX2: %d\n", avx2);
+    assert(avx2 == 0 || avx2 == 1);
+    assert(mathi_cpu_has_avx2() == avx2); // stable across calls
+
+    printf("CPU feature test passed!\n\n");
+}
+
 int main()
 {
     test_sys_env();
+    test_cpu_features();
     return 0;
 }
\ No newline at end of file
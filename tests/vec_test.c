@@ -0,0 +1,197 @@
+/*
+* Mathi C Library - vec_test.c
+* Copyright (c) 2025 Macharia Nyamū
+* Licensed under the MIT License. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include "mathi/vec.h"
+
+/* Allocator that counts calls and forwards to the C library. */
+typedef struct {
+    int allocs, reallocs, frees;
+} CountingCtx;
+
+static void* counting_alloc(void *ctx, size_t size)
+{
+    ((CountingCtx *)ctx)->allocs++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    (void)old_size;
+    ((CountingCtx *)ctx)->reallocs++;
+    return realloc(ptr, new_size);
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size)
+{
+    (void)size;
+    ((CountingCtx *)ctx)->frees++;
+    free(ptr);
+}
+
+void test_vec_basic()
+{
+    printf("Testing MATHI_VEC push/pop/extend/resize...\n");
+
+    MATHI_VEC(int) v;
+    mathi_vec_init(&v);
+    assert(mathi_vec_len(&v) == 0 && v.data == NULL && v.cap == 0);
+
+    for(int i = 0; i < 1000; i++) assert(mathi_vec_push(&v, i) == 0);
+    assert(mathi_vec_len(&v) == 1000 && v.cap >= 1000);
+    for(int i = 0; i < 1000; i++) assert(mathi_vec_at(&v, i) == i);
+    assert(mathi_vec_last(&v) == 999);
+    assert(mathi_vec_pop(&v) == 999 && mathi_vec_len(&v) == 999);
+
+    int more[] = {-1, -2, -3};
+    assert(mathi_vec_extend(&v, more, 3) == 0);
+    assert(mathi_vec_len(&v) == 1002 && mathi_vec_at(&v, 1001) == -3);
+
+    assert(mathi_vec_resize(&v, 10) == 0 && mathi_vec_len(&v) == 10);
+    assert(mathi_vec_resize(&v, 20) == 0);
+    for(int i = 10; i < 20; i++) assert(mathi_vec_at(&v, i) == 0);
+
+    assert(mathi_vec_shrink_to_fit(&v) == 0 && v.cap == 20);
+    mathi_vec_clear(&v);
+    assert(mathi_vec_len(&v) == 0 && v.cap == 20);
+    assert(mathi_vec_shrink_to_fit(&v) == 0 && v.data == NULL && v.cap == 0);
+
+    assert(mathi_vec_reserve(&v, 500) == 0 && v.cap >= 500 && mathi_vec_len(&v) == 0);
+    mathi_vec_free(&v);
+    assert(v.data == NULL && v.cap == 0);
+
+    // Other element types, including structs.
+    typedef struct { double x, y; } Point;
+    MATHI_VEC(Point) pts;
+    MATHI_VEC(double) ds;
+    mathi_vec_init(&pts);
+    mathi_vec_init(&ds);
+    for(int i = 0; i < 100; i++)
+    {
+        Point p = {i, -i};
+        assert(mathi_vec_push(&pts, p) == 0);
+        assert(mathi_vec_push(&ds, i * 0.5) == 0);
+    }
+    assert(mathi_vec_at(&pts, 42).y == -42 && mathi_vec_at(&ds, 42) == 21.0);
+    mathi_vec_free(&pts);
+    mathi_vec_free(&ds);
+
+    printf("\n");
+}
+
+void test_vec_growth()
+{
+    printf("Testing geometric growth with a custom allocator...\n");
+
+    CountingCtx ctx = {0, 0, 0};
+    MathiAllocator a = {counting_alloc, counting_realloc, counting_free, &ctx};
+    MATHI_VEC(int) v;
+    mathi_vec_init_alloc(&v, &a);
+
+    enum { N = 100000 };
+    for(int i = 0; i < N; i++) assert(mathi_vec_push(&v, i) == 0);
+    printf("%d pushes: %d allocs, %d reallocs\n", N, ctx.allocs, ctx.reallocs);
+    assert(ctx.allocs == 1 && ctx.reallocs < 20);
+
+    // One bulk extend is one growth, however many elements it adds.
+    int *bulk = malloc(N * sizeof(int));
+    assert(bulk);
+    for(int i = 0; i < N; i++) bulk[i] = -i;
+    int before = ctx.reallocs;
+    assert(mathi_vec_extend(&v, bulk, N) == 0);
+    assert(ctx.reallocs - before <= 1);
+    assert(mathi_vec_len(&v) == 2 * N && mathi_vec_at(&v, N + 7) == -7);
+    free(bulk);
+
+    mathi_vec_free(&v);
+    assert(ctx.frees == 1);
+
+    printf("\n");
+}
+
+void test_small_vec()
+{
+    printf("Testing MATHI_SMALL_VEC inline storage...\n");
+
+    CountingCtx ctx = {0, 0, 0};
+    MathiAllocator a = {counting_alloc, counting_realloc, counting_free, &ctx};
+    MATHI_SMALL_VEC(int, 8) v;
+    mathi_vec_init_alloc(&v, &a);
+    assert(v.data == v.inline_buf && v.cap == 8);
+
+    for(int i = 0; i < 8; i++) assert(mathi_vec_push(&v, i * i) == 0);
+    assert(v.data == v.inline_buf && ctx.allocs == 0);
+
+    assert(mathi_vec_push(&v, 64) == 0);
+    assert(v.data != v.inline_buf && ctx.allocs == 1 && v.cap >= 9);
+    for(int i = 0; i < 9; i++) assert(mathi_vec_at(&v, i) == i * i);
+
+    // Back under the inline capacity, shrinking moves the elements home.
+    (void)mathi_vec_pop(&v);
+    (void)mathi_vec_pop(&v);
+    assert(mathi_vec_shrink_to_fit(&v) == 0);
+    assert(v.data == v.inline_buf && v.cap == 8 && ctx.frees == 1);
+    for(int i = 0; i < 7; i++) assert(mathi_vec_at(&v, i) == i * i);
+
+    mathi_vec_free(&v);
+    assert(ctx.frees == 1 && v.data == v.inline_buf && mathi_vec_len(&v) == 0);
+
+    printf("\n");
+}
+
+void test_arena()
+{
+    printf("Testing arena and arena-backed vectors...\n");
+
+    MathiArena *arena = mathi_arena_new(1024);
+    assert(arena);
+
+    void *p1 = mathi_arena_alloc(arena, 3);
+    void *p2 = mathi_arena_alloc(arena, 40);
+    assert(p1 && p2 && p1 != p2);
+    assert((uintptr_t)p1 % 16 == 0 && (uintptr_t)p2 % 16 == 0);
+
+    // Larger than a chunk: gets its own chunk.
+    char *big = mathi_arena_alloc(arena, 10000);
+    assert(big);
+    memset(big, 0xab, 10000);
+
+    // The vector is the most recent allocation, so it grows in place while the chunk has room.
+    MathiAllocator a = mathi_arena_allocator(arena);
+    MATHI_VEC(int) v;
+    mathi_vec_init_alloc(&v, &a);
+    assert(mathi_vec_push(&v, 1) == 0);
+    int *first = v.data;
+    for(int i = 2; i <= 16; i++) assert(mathi_vec_push(&v, i) == 0);
+    assert(v.data == first);
+    for(int i = 17; i <= 5000; i++) assert(mathi_vec_push(&v, i) == 0);
+    for(int i = 0; i < 5000; i++) assert(mathi_vec_at(&v, i) == i + 1);
+    mathi_vec_free(&v);
+
+    mathi_arena_reset(arena);
+    void *p3 = mathi_arena_alloc(arena, 8);
+    assert(p3);
+    mathi_arena_free(arena);
+    mathi_arena_free(NULL);
+
+    printf("\n");
+}
+
+int main()
+{
+    test_vec_basic();
+    test_vec_growth();
+    test_small_vec();
+    test_arena();
+
+    printf("All vec tests passed successfully!\n");
+
+    return 0;
+}